@@ -0,0 +1,84 @@
+#ifndef ACTUATORS_H
+#define ACTUATORS_H
+
+#include <Arduino.h>
+#include "motion.h"
+
+// ===============================
+// Actuator Group - Header File
+// ===============================
+// Multi-cylinder engines need 2–4 stacks moved in lockstep. Each
+// actuator has its own servo ID, zero offset, mechanical parameters and
+// per-mode positions. Group moves go out as one STS SYNC_WRITE broadcast
+// frame so every servo starts on the same byte, and the poller measures
+// the skew between their arrivals.
+//
+// Actuator 0 is the original servo: its positions and mechanical
+// parameters are the existing modeServoPositions / rack / pinion
+// settings, so single-stack setups behave exactly as before.
+
+#define MAX_ACTUATORS 4
+
+struct Actuator {
+    uint8_t id;                                  // STS servo ID
+    int16_t offset;                              // Steps added to every commanded position
+    float rackLength;                            // mm (actuators 1+)
+    float pinionRadius;                          // mm (actuators 1+)
+    int16_t modePositions[MOTION_MAX_MODES];     // Per-mode positions (actuators 1+)
+};
+
+extern Actuator actuators[MAX_ACTUATORS];
+extern int32_t actuatorCount;
+
+// Restores a single actuator (the original servo) with default settings
+void setDefaultActuators();
+
+int getActuatorCount();
+int getActuatorId(int index);
+
+// Position for a mode (1-based), including the actuator's offset
+int getActuatorModePosition(int index, int mode);
+
+// Adds an actuator with a new servo ID. Returns its index or -1.
+int addActuator(uint8_t id);
+
+// Removes an actuator (never actuator 0)
+bool removeActuator(int index);
+
+// Sets "id", "offset", "rack" or "pinion" of an actuator. Actuator 0's
+// rack/pinion are the global mechanical parameters.
+bool setActuatorParam(int index, const char* name, float value);
+
+// Sets the position for a mode (1-based), without the offset
+bool setActuatorModePosition(int index, int mode, int position);
+
+// Spreads an actuator's positions linearly over its mechanical travel
+void generateActuatorPositions(int index, int steps);
+
+// Regenerates the positions of every actuator for 'steps' modes and
+// stores them; for when the number of ranges changes
+void generateAllActuatorPositions(int steps);
+
+// Sends one SYNC_WRITE moving every actuator to the given mode
+bool moveActuatorGroup(int mode, uint16_t speed, uint8_t acc);
+
+// Called by the telemetry poller for each fresh actuator sample
+void updateGroupSkew(int index, int position, bool moving, uint32_t timestampUs);
+
+// Spread between the first and the last stack reaching its target
+struct SkewSummary {
+    uint32_t count;       // Completed group moves
+    uint32_t timeouts;    // Timed out or superseded group moves
+    float lastMs;
+    float minMs;
+    float avgMs;
+    float maxMs;
+};
+
+void getActuatorSkew(SkewSummary& out);
+
+// Prints the actuator table / skew statistics
+void printActuators();
+void printActuatorSkew();
+
+#endif  // ACTUATORS_H
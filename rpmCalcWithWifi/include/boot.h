@@ -0,0 +1,41 @@
+#ifndef BOOT_H
+#define BOOT_H
+
+#include <Arduino.h>
+
+// ===============================
+// Boot Timeline - Header File
+// ===============================
+// setup() runs in two stages. The critical stage loads the stored
+// configuration, brings up the servo bus, arms the RPM interrupt,
+// starts the control task and enters RACE, so the servo follows RPM
+// without any button press. It neither waits on a USB host nor prints
+// more than warnings. Diagnostics, the CLI and Wi-Fi come afterwards.
+//
+// Each phase records when it was first reached, in µs since reset, so
+// time-to-follow can be compared between builds ("boot" on the CLI,
+// "boot" in /perf).
+
+enum BootPhase : uint8_t {
+    BOOT_SETUP,             // setup() entered
+    BOOT_CONFIG,            // NVS configuration loaded
+    BOOT_SERVO_BUS,         // Servo UART up, servo answered (or gave up)
+    BOOT_RPM_ISR,           // RPM interrupt armed
+    BOOT_CONTROL,           // Control task started
+    BOOT_FOLLOW_ARMED,      // RACE entered: servo follow on, RPM from the sensor
+    BOOT_FIRST_FOLLOW,      // First control cycle that put the servo in the RPM's mode
+    BOOT_FIRST_SERVO_CMD,   // First position command accepted by the bus (homing)
+    BOOT_DEFERRED,          // Diagnostics, CLI and Wi-Fi set up
+    BOOT_PHASE_COUNT
+};
+
+// Records the phase the first time it is reached; later calls are ignored
+void markBootPhase(BootPhase phase);
+
+// µs since reset, 0 if the phase has not been reached
+uint32_t getBootPhaseUs(BootPhase phase);
+const char* getBootPhaseName(BootPhase phase);
+
+void printBootTimeline();
+
+#endif  // BOOT_H
@@ -0,0 +1,59 @@
+#ifndef CALIBRATION_H
+#define CALIBRATION_H
+
+#include <Arduino.h>
+
+// ===============================
+// Endpoint Calibration - Header File
+// ===============================
+// Finds the real mechanical travel of the rack by creeping towards each
+// end stop at low speed and acceleration and watching the servo's load
+// feedback. Contact is a sustained load above CAL_LOAD_LIMIT, or the
+// position no longer changing while the goal is still ahead. The servo
+// is stopped where it touched, the stop counts are stored in NVS, and
+// mode positions are regenerated across the measured travel, kept
+// CAL_MARGIN steps clear of both stops.
+
+// Approach speed (steps/s) and acceleration (100 steps/s²)
+#define CAL_SPEED 200
+#define CAL_ACC 5
+
+// |load| in 0.1% of max torque that counts as contact
+#define CAL_LOAD_LIMIT 300
+
+// Consecutive samples above the load limit needed for contact
+#define CAL_LOAD_SAMPLES 3
+
+// Time without progress that counts as a stall
+#define CAL_STALL_MS 300
+#define CAL_STALL_STEPS 2
+
+// Steps kept clear of each end stop
+#define CAL_MARGIN 15
+
+// Per-direction timeout (full travel at CAL_SPEED is ~20 s)
+#define CAL_TIMEOUT_MS 25000
+
+// End stop positions in raw steps (-1 = not calibrated)
+extern int32_t servoMinPos;
+extern int32_t servoMaxPos;
+
+// True once both end stops have been measured
+bool servoLimitsCalibrated();
+
+// Usable travel, i.e. the stops minus CAL_MARGIN. Without calibration
+// this is the whole 0–4095 range.
+int getServoMinUsable();
+int getServoMaxUsable();
+
+// Drives to both end stops and stores the result. Blocking; aborts on
+// any key press. Servo follow must be disabled by the caller.
+bool calibrateServoEndpoints();
+
+// Forgets the measured end stops (does not store)
+void clearServoLimits();
+
+// Prints the measured limits
+void printServoLimits();
+
+#endif  // CALIBRATION_H
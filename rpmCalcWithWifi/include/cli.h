@@ -10,6 +10,10 @@
 // allowing runtime interaction with the ESP32 for diagnostics,
 // mode switching, testing, and debugging.
 
+// === Command Index ===
+// Builds the command lookup table; call once from setup() before handleCLI()
+void initCLI();
+
 // === CLI Entry Point ===
 // Call this function inside the main loop() to check for input and execute commands
 void handleCLI();
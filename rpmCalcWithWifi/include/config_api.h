@@ -0,0 +1,63 @@
+#ifndef CONFIG_API_H
+#define CONFIG_API_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "motion.h"
+
+// ===============================
+// Config Document - Header File
+// ===============================
+// The whole bike setup as one JSON document, for GET/PUT /config:
+//
+//   {
+//     "version": 1,
+//     "ranges": [[0, 3000], [3001, 5000], ...],      // RPM per mode, ascending
+//     "positions": [512, 1024, ...],                 // Raw servo steps per mode
+//     "hysteresis_rpm": 50,
+//     "mechanical": { "rack_length_mm": 57.0, "pinion_radius_mm": 15.5 },
+//     "pins": { "rpm": 4, "mode_button": 9, "movement": 10, "mark": 5,
+//               "servo_rx": 2, "servo_tx": 3 },
+//     "profiles": [[[speed, acc], ...], ...]         // [from][to], one row per mode
+//   }
+//
+// An update is checked as a whole before anything changes, then applied
+// and written to NVS with a single commit. Sections left out keep their
+// current values; when the number of ranges changes, positions (and
+// profiles, if given) must match the new count. The ETag is a hash of
+// the current document, for If-Match on PUT.
+
+#define CONFIG_VERSION 1
+
+// Pool for the document at MOTION_MAX_MODES (the 12×12 profile table is
+// most of it): one slot per value, plus room for keys, which are copied
+// when a PUT body is parsed, and for a few unknown ones
+#define CONFIG_DOC_SLOTS(n)                                      \
+    (JSON_OBJECT_SIZE(7) +                       /* root */       \
+     JSON_ARRAY_SIZE(n) + (n) * JSON_ARRAY_SIZE(2) + /* ranges */ \
+     JSON_ARRAY_SIZE(n) +                        /* positions */  \
+     JSON_OBJECT_SIZE(2) + JSON_OBJECT_SIZE(6) + /* mech, pins */ \
+     JSON_ARRAY_SIZE(n) + (n) * JSON_ARRAY_SIZE(n) + (n) * (n) * JSON_ARRAY_SIZE(2))
+#define CONFIG_KEY_BYTES 512
+#define CONFIG_DOC_SIZE (CONFIG_DOC_SLOTS(MOTION_MAX_MODES) + CONFIG_KEY_BYTES)
+
+// One contiguous block per request; keep it well below the largest free heap block
+static_assert(CONFIG_DOC_SIZE <= 12 * 1024, "Config document pool too large for one allocation");
+
+enum ConfigResult : uint8_t {
+    CONFIG_OK,
+    CONFIG_INVALID,        // Rejected; nothing changed
+    CONFIG_STORE_FAILED    // Applied, but the NVS commit failed
+};
+
+// Fills 'doc' with the current configuration. False if it did not fit.
+bool buildConfig(JsonDocument& doc);
+
+// Quoted ETag of a document filled by buildConfig()
+String getConfigEtag(const JsonDocument& doc);
+
+// Validates 'doc' and, if it is valid, applies and stores it.
+// 'error' says what was wrong when the result is not CONFIG_OK.
+ConfigResult applyConfig(JsonDocument& doc, char* error, size_t errorLen);
+
+#endif  // CONFIG_API_H
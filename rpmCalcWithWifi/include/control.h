@@ -0,0 +1,69 @@
+#ifndef CONTROL_H
+#define CONTROL_H
+
+#include <Arduino.h>
+
+// ===============================
+// Control Loop - Header File
+// ===============================
+// The servo-follow logic runs in its own FreeRTOS task, woken by
+// vTaskDelayUntil at a fixed rate, instead of in loop() between the CLI
+// and a 50 ms delay. The task sits above the telemetry poller and the
+// Arduino loop task, so CLI, state handling and Wi-Fi can no longer
+// stretch a control cycle. Every cycle is timed: execution time, wake-up
+// jitter against the nominal period, and overruns (cycles that took
+// longer than the period).
+//
+// While following sensor RPM the task does not poll at all: the RPM ISR
+// notifies it when the period leaves the current mode's bounds (see
+// armModeBoundaries() in rpm.h), and the time from that edge to the
+// servo command is recorded. It still wakes every CONTROL_RESYNC_MS to
+// re-check the source and follow state. Manual and simulated RPM use
+// the fixed-rate loop.
+
+// Rates are limited by the FreeRTOS tick (1 kHz on the ESP32 core); the
+// period is rounded down to whole ticks
+#define CONTROL_DEFAULT_HZ 1000
+#define CONTROL_MAX_HZ configTICK_RATE_HZ
+
+#define CONTROL_TASK_PRIORITY 3
+
+// Longest sleep while waiting for a boundary crossing
+#define CONTROL_RESYNC_MS 100
+
+struct ControlStats {
+    uint32_t cycles;
+    uint32_t overruns;        // Cycles whose execution exceeded the period
+    uint32_t periodUs;        // Nominal period
+    uint32_t execLastUs;
+    uint32_t execMinUs;
+    uint32_t execMaxUs;
+    float execAvgUs;
+    uint32_t jitterMaxUs;     // Largest |actual period - nominal period|
+    float jitterAvgUs;        // Mean |actual period - nominal period|
+    bool eventDriven;         // Currently waiting for boundary crossings
+    uint32_t events;          // Crossings handled
+    uint32_t idleTimeouts;    // CONTROL_RESYNC_MS wake-ups without a crossing
+    uint32_t eventLastUs;     // Crossing edge → servo command
+    uint32_t eventMinUs;
+    uint32_t eventMaxUs;
+    float eventAvgUs;
+};
+
+// Starts the control task (safe to call more than once)
+void initControlLoop();
+
+// Sets the loop rate in Hz. Use storeControlRate() to persist.
+void setControlRate(int hz);
+int getControlRate();
+
+// Copies the cycle statistics
+void getControlStats(ControlStats& out);
+
+// Clears the cycle statistics
+void resetControlStats();
+
+// Prints the cycle statistics to Serial
+void printControlStats();
+
+#endif  // CONTROL_H
@@ -0,0 +1,71 @@
+#ifndef HISTORY_H
+#define HISTORY_H
+
+#include <Arduino.h>
+
+// ===============================
+// Sample History - Header File
+// ===============================
+// A task records RPM, mode, servo target/actual and flags at a fixed
+// rate into a RAM ring, so the web app can fetch everything since its
+// last request instead of the one value current at poll time:
+//
+//   GET /history?since=<seq>&fields=rpm,mode&format=json|bin&max=<n>
+//
+// Every sample has a sequence number. A response carries the samples
+// from 'since' on and the cursor to pass next time. Samples that
+// already left the ring are reported as lost; a cursor ahead of the
+// ring (the device rebooted) starts over from the oldest sample.
+//
+// The ring has one writer and is read without locks: a reader copies
+// a sample and then checks that the writer has not reached its slot.
+
+#define HISTORY_HZ 50
+#define HISTORY_CAPACITY 1024   // About 20 s at HISTORY_HZ, 16 KB
+#define HISTORY_TASK_PRIORITY 1
+
+// Samples this close to being overwritten are not served, so a
+// response has this long to go out before its data is reused
+#define HISTORY_GUARD_SAMPLES HISTORY_HZ
+
+enum HistoryField : uint8_t {
+    HISTORY_T      = 1 << 0,  // millis() at sampling
+    HISTORY_RPM    = 1 << 1,  // Unified RPM
+    HISTORY_MODE   = 1 << 2,  // Mode last commanded to the servo
+    HISTORY_TARGET = 1 << 3,  // Last commanded servo position
+    HISTORY_ACTUAL = 1 << 4,  // Servo position from telemetry
+    HISTORY_FLAGS  = 1 << 5,  // TelemetryFlag bits (telemetry_frame.h)
+};
+
+#define HISTORY_FIELD_COUNT 6
+#define HISTORY_ALL_FIELDS 0x3F
+
+struct HistorySample {
+    uint32_t ms;
+    int32_t rpmX10;     // RPM × 10
+    int8_t mode;        // -1 if none
+    uint8_t flags;
+    int16_t target;
+    int16_t actual;
+};
+
+// Starts the sampling task
+void initHistory();
+
+// Sequence number the next sample will get
+uint32_t getHistoryHead();
+
+// Oldest sequence number that can still be read safely
+uint32_t getHistoryOldest();
+
+// Copies sample 'seq'; false if it is not taken yet or was overwritten
+bool getHistorySample(uint32_t seq, HistorySample& out);
+
+// Field bits for a comma-separated list (t_ms,rpm,mode,target,actual,
+// flags or all); 0 if any name is unknown
+uint8_t parseHistoryFields(const char* list);
+
+// Name of field bit 'index' as used in responses
+const char* getHistoryFieldName(int index);
+
+#endif  // HISTORY_H
@@ -0,0 +1,153 @@
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+#include <Arduino.h>
+
+// ===============================
+// JSON Writer - Header File
+// ===============================
+// Writes small fixed-schema JSON straight into a caller's buffer, for
+// the hot HTTP endpoints that the web app polls several times a second.
+// Nothing is allocated: no document pool and no String, so polling
+// does not churn or fragment the heap the way
+// DynamicJsonDocument + serializeJson(doc, String) does.
+//
+//   char buf[64];
+//   JsonWriter json(buf);
+//   json.beginObject().field("rpm", getRPMUnified()).endObject();
+//   if (json.ok()) server.send_P(200, "application/json", json.c_str(), json.length());
+//
+// Commas are inserted automatically. Output that does not fit sets
+// ok() to false; the buffer always holds a terminated (if cut) string.
+// Nesting is not checked, so a fixed schema is expected.
+
+class JsonWriter {
+public:
+    JsonWriter(char* buf, size_t size) : buf(buf), size(size) {
+        if (size) buf[0] = '\0';
+    }
+
+    template <size_t N>
+    explicit JsonWriter(char (&buf)[N]) : JsonWriter(buf, N) {}
+
+    JsonWriter& beginObject() { return open('{'); }
+    JsonWriter& endObject() { return close('}'); }
+    JsonWriter& beginArray() { return open('['); }
+    JsonWriter& endArray() { return close(']'); }
+
+    JsonWriter& key(const char* name) {
+        separate();
+        string(name);
+        put(':');
+        needComma = false;
+        return *this;
+    }
+
+    JsonWriter& value(int v) { return printf("%d", v); }
+    JsonWriter& value(unsigned v) { return printf("%u", v); }
+    JsonWriter& value(long v) { return printf("%ld", v); }
+    JsonWriter& value(unsigned long v) { return printf("%lu", v); }
+    JsonWriter& value(bool v) { return raw(v ? "true" : "false"); }
+
+    // NaN and infinity have no JSON form and are written as null
+    JsonWriter& value(float v, int decimals = 2) {
+        if (isnan(v) || isinf(v)) return raw("null");
+        return printf("%.*f", decimals, (double)v);
+    }
+
+    JsonWriter& value(const char* s) {
+        separate();
+        string(s);
+        needComma = true;
+        return *this;
+    }
+
+    template <typename T>
+    JsonWriter& field(const char* name, T v) {
+        return key(name).value(v);
+    }
+
+    bool ok() const { return !overflow; }
+    const char* c_str() const { return buf; }
+    size_t length() const { return len; }
+
+private:
+    char* buf;
+    size_t size;
+    size_t len = 0;
+    bool needComma = false;
+    bool overflow = false;
+
+    void put(char c) {
+        if (len + 1 < size) {
+            buf[len++] = c;
+            buf[len] = '\0';
+        } else {
+            overflow = true;
+        }
+    }
+
+    void separate() {
+        if (needComma) put(',');
+    }
+
+    JsonWriter& open(char c) {
+        separate();
+        put(c);
+        needComma = false;
+        return *this;
+    }
+
+    JsonWriter& close(char c) {
+        put(c);
+        needComma = true;
+        return *this;
+    }
+
+    JsonWriter& raw(const char* s) {
+        separate();
+        while (*s) put(*s++);
+        needComma = true;
+        return *this;
+    }
+
+    JsonWriter& printf(const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+        separate();
+        if (len < size) {
+            va_list args;
+            va_start(args, fmt);
+            int n = vsnprintf(buf + len, size - len, fmt, args);
+            va_end(args);
+            if (n < 0 || (size_t)n >= size - len) {
+                overflow = true;
+                len = size ? size - 1 : 0;
+            } else {
+                len += n;
+            }
+        } else {
+            overflow = true;
+        }
+        needComma = true;
+        return *this;
+    }
+
+    void string(const char* s) {
+        put('"');
+        for (; *s; ++s) {
+            char c = *s;
+            if (c == '"' || c == '\\') {
+                put('\\');
+                put(c);
+            } else if ((uint8_t)c < 0x20) {
+                char esc[7];
+                snprintf(esc, sizeof(esc), "\\u%04x", c);
+                for (const char* e = esc; *e; ++e) put(*e);
+            } else {
+                put(c);
+            }
+        }
+        put('"');
+    }
+};
+
+#endif  // JSON_WRITER_H
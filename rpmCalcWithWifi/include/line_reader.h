@@ -0,0 +1,53 @@
+#ifndef LINE_READER_H
+#define LINE_READER_H
+
+#include <Arduino.h>
+
+// ===============================
+// CLI Line Reader - Header File
+// ===============================
+// Assembles serial input into lines without blocking and without heap
+// use. poll() consumes only the bytes already received, so a half-typed
+// line never stalls the caller, and the completed line is split into
+// tokens in place. Backspace/DEL edit the pending line; over-long lines
+// are dropped whole rather than executed truncated.
+
+#define CLI_LINE_MAX 128
+#define CLI_MAX_TOKENS 16
+
+// Tokens of the current line, pointing into the reader's token buffer
+struct CliArgs {
+    const char* argv[CLI_MAX_TOKENS];
+    uint8_t argc;
+};
+
+class LineReader {
+public:
+    // Consumes available bytes up to the end of a line. Returns true
+    // once a complete, non-empty line is ready; it stays valid until the
+    // next poll().
+    bool poll(Stream& in);
+
+    // The trimmed line and its whitespace-separated tokens
+    const char* line() const { return buf; }
+    const CliArgs& args() const { return tokens; }
+
+    // True if the last line was dropped for exceeding CLI_LINE_MAX
+    bool overflowed() const { return overflow; }
+
+    // Forgets any partially typed line
+    void clear();
+
+private:
+    void finishLine();
+
+    char buf[CLI_LINE_MAX] = {};
+    char tokenBuf[CLI_LINE_MAX] = {};
+    size_t len = 0;
+    bool ready = false;
+    bool discarding = false;
+    bool overflow = false;
+    CliArgs tokens = {};
+};
+
+#endif  // LINE_READER_H
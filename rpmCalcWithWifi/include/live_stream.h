@@ -0,0 +1,64 @@
+#ifndef LIVE_STREAM_H
+#define LIVE_STREAM_H
+
+#include <Arduino.h>
+
+// ===============================
+// Live Stream - Header File
+// ===============================
+// "rpm live" as a subscription: a low-priority task samples the
+// selected fields at a fixed rate and prints one line per sample, while
+// loop(), the CLI and the mode button keep running. Any key typed on
+// the serial port cancels it. When the serial TX buffer cannot take a
+// whole line the sample is dropped and counted, so a slow or absent
+// host never stalls the sampler.
+//
+// The binary format sends every sample as a COBS frame instead (see
+// telemetry_frame.h): timestamp, RPM, dRPM/dt, mode, servo target and
+// actual position and flags, typically 12–16 bytes once delta-coded,
+// for logging at the full 1 kHz without Wi-Fi.
+
+#define LIVE_MIN_HZ 1
+#define LIVE_MAX_HZ 1000
+#define LIVE_DEFAULT_HZ 10
+
+// Same priority as the Arduino loop task (0 is the idle task's). Above
+// one sample per tick the task yields after every sample instead of
+// sleeping, so it time-shares with CLI handling rather than starving it.
+#define LIVE_TASK_PRIORITY 1
+
+// Time constant of the filtered RPM (exponential moving average)
+#define LIVE_FILTER_TAU_MS 100
+
+enum LiveField : uint8_t {
+    LIVE_RPM          = 1 << 0,  // Unified RPM
+    LIVE_RPM_FILTERED = 1 << 1,  // RPM through a LIVE_FILTER_TAU_MS EMA
+    LIVE_MODE         = 1 << 2,  // Mode last commanded to the servo
+    LIVE_SERVO_POS    = 1 << 3,  // Cached servo position from telemetry
+    LIVE_MOVEMENT     = 1 << 4,  // Movement pin level
+};
+
+enum LiveFormat : uint8_t {
+    LIVE_TEXT,    // One line per sample, selected fields
+    LIVE_BINARY   // One frame per sample, all fields
+};
+
+#define LIVE_ALL_FIELDS 0x1F
+#define LIVE_DEFAULT_FIELDS (LIVE_RPM | LIVE_RPM_FILTERED | LIVE_MODE | LIVE_SERVO_POS)
+
+// Starts (or reconfigures) the stream and prints its column header.
+// Fields only apply to the text format.
+void startLiveStream(int hz, uint8_t fields, LiveFormat format = LIVE_TEXT);
+
+// Stops the stream and prints how many samples were sent and dropped
+void stopLiveStream();
+
+bool isLiveStreamActive();
+
+// Samples per second actually taken (sent or dropped) since the start
+float getLiveStreamRate();
+
+// Field bit for a CLI name (rpm, filt, mode, pos, move, all); 0 if unknown
+uint8_t parseLiveField(const char* name);
+
+#endif  // LIVE_STREAM_H
@@ -0,0 +1,54 @@
+#ifndef MOTION_H
+#define MOTION_H
+
+#include <Arduino.h>
+
+// ===============================
+// Motion Planner - Header File
+// ===============================
+// Picks the servo speed and acceleration for every source→target mode
+// transition. Profiles are stored in NVS and can be tuned by hand or by
+// the auto-tune routine, which times real moves through the servo
+// feedback and keeps the fastest setting that arrives without overshoot.
+
+#define MOTION_MAX_MODES 12
+
+// Defaults match the original follow behaviour (max speed, acc 50)
+#define MOTION_DEFAULT_SPEED 0
+#define MOTION_DEFAULT_ACC 50
+
+// Position error (steps) accepted as "arrived"; anything further past
+// the target counts as overshoot
+#define MOTION_TOLERANCE 8
+
+struct MotionProfile {
+    uint16_t speed;       // Goal speed in steps/s (0 = servo maximum)
+    uint8_t acc;          // Acceleration in 100 steps/s² units (0 = no ramp)
+    uint8_t tuned;        // 1 if written by auto-tune
+    uint16_t arrivalMs;   // Arrival time measured by auto-tune (0 = unknown)
+};
+
+// Profiles indexed [fromMode - 1][toMode - 1]
+extern MotionProfile motionProfiles[MOTION_MAX_MODES][MOTION_MAX_MODES];
+
+// Restores every profile to the defaults (does not store)
+void resetMotionProfiles();
+
+// Returns the profile for a transition. Unknown source modes (-1)
+// fall back to the defaults.
+MotionProfile getMotionProfile(int fromMode, int toMode);
+
+// Sets a hand-tuned profile (does not store)
+bool setMotionProfile(int fromMode, int toMode, uint16_t speed, uint8_t acc);
+
+// Measures from→to moves and keeps the fastest stable setting.
+// Blocking; servo follow must be disabled by the caller.
+bool autoTuneMotion(int fromMode, int toMode);
+
+// Runs autoTuneMotion() for every pair of active modes
+void autoTuneAllMotion();
+
+// Prints the profile table for the active modes
+void printMotionProfiles();
+
+#endif  // MOTION_H
@@ -0,0 +1,56 @@
+#ifndef MOVE_TRACKER_H
+#define MOVE_TRACKER_H
+
+#include <Arduino.h>
+#include "servo_telemetry.h"
+
+// ===============================
+// Move Tracker - Header File
+// ===============================
+// Follows every mode-to-mode servo move from the moment the command is
+// sent, through first motion, to in-position (within MOTION_TOLERANCE
+// and no longer moving) using the telemetry feedback. Keeps a rolling
+// window of actuation latencies per transition for min/avg/p99 reports.
+
+// Samples kept per transition, and across all transitions
+#define LATENCY_WINDOW 16
+#define LATENCY_OVERALL_WINDOW 128
+
+// Moves that take longer than this are counted as timeouts
+#define MOVE_TIMEOUT_MS 3000
+
+struct LatencySummary {
+    uint16_t count;        // Samples in the window
+    uint16_t timeouts;     // Moves that never arrived
+    uint16_t superseded;   // Moves replaced by a newer command before arriving
+    float minMs;
+    float avgMs;
+    float p99Ms;
+    float deadAvgMs;       // Command → first motion
+};
+
+// Called right after a mode move is commanded
+void beginMoveTracking(int fromMode, int toMode, int startPos, int targetPos);
+
+// Called by the telemetry poller with each fresh sample
+void updateMoveTracking(const ServoTelemetry& t);
+
+// True while a commanded move has not yet arrived or timed out
+bool isMoveInProgress();
+
+// Last position the servo was confirmed to reach (-1 if unknown)
+int getArrivedServoPos();
+
+// Rolling stats for one transition (modes are 1-based)
+bool getTransitionLatency(int fromMode, int toMode, LatencySummary& out);
+
+// Rolling stats across every transition
+void getOverallLatency(LatencySummary& out);
+
+// Clears all latency statistics
+void resetMoveLatency();
+
+// Prints the latency table for the active modes
+void printMoveLatency();
+
+#endif  // MOVE_TRACKER_H
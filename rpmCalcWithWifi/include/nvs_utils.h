@@ -30,6 +30,24 @@ bool loadServoPositions();
 bool loadMechanicalParams();
 void storePinAssignments();
 bool loadPinAssignments();
+void storeServoPollRate();
+bool loadServoPollRate();
+void storeMotionProfiles();
+bool loadMotionProfiles();
+void storeActuators();
+bool loadActuators();
+void storeServoLimits();
+bool loadServoLimits();
+void storeControlRate();
+bool loadControlRate();
+void storeModeHysteresis();
+bool loadModeHysteresis();
+void storeUdpTelemetry();
+bool loadUdpTelemetry();
+
+// Stores ranges, positions, mechanics, pins, motion profiles and
+// hysteresis with one commit. False if NVS could not be written.
+bool storeConfig();
 
 #ifdef __cplusplus
 }  // extern "C"
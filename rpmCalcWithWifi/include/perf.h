@@ -0,0 +1,88 @@
+#ifndef PERF_H
+#define PERF_H
+
+#include <Arduino.h>
+
+// ===============================
+// Profiler - Header File
+// ===============================
+// Scoped timing probes on the CPU cycle counter. A probe is a fixed
+// slot (no allocation, safe in ISRs); PERF_SCOPE(id) at the top of a
+// block times it until the block exits and folds the result into the
+// probe's count/min/max/mean and a log2 histogram.
+//
+// Set PERF_ENABLED to 0 to compile every probe out. When compiled in,
+// "perf off" reduces a probe to one flag test.
+
+#ifndef PERF_ENABLED
+#define PERF_ENABLED 1
+#endif
+
+enum PerfProbe : uint8_t {
+    PERF_RPM_ISR,        // rpmSensorISR()
+    PERF_RPM_READ,       // getRPMUnified()
+    PERF_CONTROL,        // One control task cycle / crossing
+    PERF_SERVO_BUS,      // One STS transaction (TX + reply)
+    PERF_SERVO_POLL,     // One telemetry poll cycle, all actuators
+    PERF_NVS_COMMIT,     // nvs_commit() + nvs_close()
+    PERF_HTTP,           // One HTTP handler
+    PERF_JSON,           // JSON serialization in HTTP handlers
+    PERF_CLI,            // One handleCLI() call that processed a line
+    PERF_PROBE_COUNT
+};
+
+// Histogram bucket i counts samples of 2^(i + PERF_HIST_SHIFT) to
+// 2^(i + PERF_HIST_SHIFT + 1) cycles; the first and last are open-ended
+#define PERF_HIST_BUCKETS 16
+#define PERF_HIST_SHIFT 7
+
+struct PerfStats {
+    uint32_t count;
+    uint32_t minCycles;
+    uint32_t maxCycles;
+    uint64_t sumCycles;
+    uint32_t histogram[PERF_HIST_BUCKETS];
+};
+
+extern volatile bool perfEnabled;
+
+// Adds one sample to a probe. ISR-safe.
+void IRAM_ATTR perfRecord(PerfProbe probe, uint32_t cycles);
+
+// Copies a probe's statistics
+void getPerfStats(PerfProbe probe, PerfStats& out);
+const char* getPerfProbeName(PerfProbe probe);
+
+// Cycles to microseconds at the current CPU clock
+float perfCyclesToUs(uint32_t cycles);
+
+void resetPerfStats();
+void setPerfEnabled(bool enabled);
+void printPerfStats();
+
+#if PERF_ENABLED
+
+class PerfScope {
+public:
+    explicit PerfScope(PerfProbe p) : probe(p), active(perfEnabled), start(active ? ESP.getCycleCount() : 0) {}
+    ~PerfScope() {
+        if (active) perfRecord(probe, ESP.getCycleCount() - start);
+    }
+
+private:
+    PerfProbe probe;
+    bool active;
+    uint32_t start;
+};
+
+#define PERF_CONCAT_(a, b) a##b
+#define PERF_CONCAT(a, b) PERF_CONCAT_(a, b)
+#define PERF_SCOPE(probe) PerfScope PERF_CONCAT(perfScope_, __LINE__)(probe)
+
+#else
+
+#define PERF_SCOPE(probe) do {} while (0)
+
+#endif  // PERF_ENABLED
+
+#endif  // PERF_H
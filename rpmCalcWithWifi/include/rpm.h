@@ -45,6 +45,30 @@ void initRpmSensorInterrupt();
 
 int getRpmPin();
 
+// True when RPM comes from the sensor ISR
+bool isRPMFromSensor();
+
+// === Mode Boundary Detection ===
+// The ISR compares each new period against the period-space bounds of
+// the current mode and notifies the crossing task only when the RPM
+// leaves it. Bounds are widened by the hysteresis (RPM, default 0).
+
+// Precomputes the bounds of a mode (1-based) and arms detection.
+// Modes outside the table disarm it.
+void armModeBoundaries(int mode);
+void disarmModeBoundaries();
+bool modeBoundariesArmed();
+
+// Task woken with a notification on each crossing
+void setModeCrossingTask(TaskHandle_t task);
+
+// micros() of the edge that completed the last crossing period
+uint32_t getLastCrossingUs();
+uint32_t getModeCrossingCount();
+
+void setModeHysteresis(int rpm);
+int getModeHysteresis();
+
 void setRpmPin(int pin);
 
 #endif  // RPM_H
\ No newline at end of file
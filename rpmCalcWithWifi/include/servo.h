@@ -2,18 +2,40 @@
 #define SERVO_H
 
 #include <Arduino.h>
-#include <SMS_STS.h>  
-#include <SCServo.h>
+#include "sts_bus.h"
 
-extern SMS_STS st;
+extern StsBus stsBus;
 extern const int SERVO_ID;
 
 extern int SERVO_RX;
 extern int SERVO_TX;
 
+// Last commanded position. See getArrivedServoPos() for the last
+// position the servo actually reached.
 extern int lastServoPos;
+extern int lastServoMode;
 extern bool servoFollowingEnabled;
 
+// ===== Servo Bus Access =====
+// Every transaction on the servo UART goes through the bus lock so the
+// telemetry poller and the command paths never interleave packets.
+
+// Creates the bus lock. Called first thing in setup(), before initNVS()
+// can reconfigure the servo pins.
+void servoBusInit();
+
+// Takes the bus lock, waiting at most timeoutMs. Returns false on timeout.
+bool servoBusLock(uint32_t timeoutMs = 50);
+
+// Releases the bus lock taken with servoBusLock()
+void servoBusUnlock();
+
+// Locked WritePosEx on actuator 0. Returns BUS_BUSY if the lock timed out.
+StsStatus servoWritePosEx(int pos, int speed, int acc);
+
+// Locked ReadPos on actuator 0. Returns -1 on failure.
+int servoReadPos();
+
 // ===== Initialization Functions =====
 
 // Initializes UART communication for the servo using SERVO_RX and SERVO_TX
@@ -25,6 +47,12 @@ void servo_initialize();
 // Combined function to initialize UART and servo using default RX/TX pins
 void servo_defaultInit();
 
+// Boot path: like servo_defaultInit() but keeps the pins loaded from NVS.
+// Waits at most SERVO_BOOT_WAIT_MS for the servo to answer a ping.
+#define SERVO_BOOT_WAIT_MS 300
+#define SERVO_BOOT_POLL_MS 10
+void servo_bootInit();
+
 // Dynamically configure servo RX and TX pins (used by CLI)
 bool configureServoPins(int rx, int tx);
 
@@ -64,6 +92,13 @@ void disableServoFollow();
 // Called regularly in loop() to update servo position if following is enabled
 void updateServoIfFollowing();
 
+// Moves to a mode's position using the motion profile for the transition
+// from the last commanded mode
+void servoMoveToMode(int mode);
+
+// Same move with an explicit speed and acceleration instead of the profile
+void servoMoveToMode(int mode, uint16_t speed, uint8_t acc);
+
 void generateServoPositions(int steps);
 
 void printModeRangeMapping();
@@ -71,12 +106,19 @@ void printModeRangeMapping();
 // Servo status
 void servoStatus();
 
+// Prints per-status transaction counters of the servo bus
+void printServoBusStats();
+
+// Times 'iterations' feedback reads and position writes on the bus
+void servoBenchmark(int iterations);
+
 void servoRPM();
 
 float getPinionRadius();
 
 float getRackLength();
 
+// Mechanical setters; use storeMechanicalParams() to persist
 void setPinionRadius(float newRadius);
 
 void setRackLength(float newLength);
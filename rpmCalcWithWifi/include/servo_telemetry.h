@@ -0,0 +1,59 @@
+#ifndef SERVO_TELEMETRY_H
+#define SERVO_TELEMETRY_H
+
+#include <Arduino.h>
+
+// ===============================
+// Servo Telemetry - Header File
+// ===============================
+// A background task reads the ST3215 feedback block (position, speed,
+// load, voltage, temperature, moving flag, current) in a single
+// multi-register transaction at a configurable rate. Every consumer
+// (CLI, HTTP, logging) reads the cached snapshot instead of talking
+// to the servo bus itself. While a commanded move is being tracked the
+// poller runs at SERVO_POLL_MAX_HZ so arrival times stay precise.
+// With an actuator group every stack gets its own snapshot slot, read
+// back to back in each poll cycle; slot 0 is the original servo.
+
+// Default and allowed poll rates (Hz). 0 disables polling.
+#define SERVO_POLL_DEFAULT_HZ 50
+#define SERVO_POLL_MAX_HZ 200
+
+struct ServoTelemetry {
+    uint32_t sampleCount;    // Successful reads since boot
+    uint32_t errorCount;     // Failed reads since boot
+    uint32_t timestampMs;    // millis() of the last successful read
+    uint32_t timestampUs;    // micros() of the last successful read
+    int16_t position;        // Raw position (0–4095)
+    int16_t speed;           // Steps/s, signed
+    int16_t load;            // 0.1% of max torque, signed
+    int16_t current;         // Raw current units
+    uint8_t voltage;         // 0.1 V
+    uint8_t temperature;     // °C
+    bool moving;             // Servo reports motion in progress
+    bool valid;              // At least one successful read
+};
+
+// Starts the poller task (safe to call more than once)
+void initServoTelemetry();
+
+// Sets the poll rate in Hz (0 = paused). Use storeServoPollRate() to persist.
+void setServoPollRate(int hz);
+
+// Returns the configured poll rate in Hz
+int getServoPollRate();
+
+// Copies the latest snapshot without touching the bus. Holds a spinlock
+// only for the copy; safe to call from any task.
+void getServoTelemetry(ServoTelemetry& out);
+
+// Same for any actuator in the group. Returns false for a bad index.
+bool getActuatorTelemetry(int index, ServoTelemetry& out);
+
+// Age of the last successful sample in ms (UINT32_MAX if none)
+uint32_t getServoTelemetryAge();
+
+// Prints the latest snapshot to Serial
+void printServoTelemetry();
+
+#endif  // SERVO_TELEMETRY_H
@@ -0,0 +1,58 @@
+#ifndef SSE_SERVER_H
+#define SSE_SERVER_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+
+// ===============================
+// Live Event Stream - Header File
+// ===============================
+// Server-Sent Events on port SSE_PORT, so the web app gets RPM, mode,
+// servo target/actual and state pushed instead of polling /data and
+// /current_position. WebServer on port 80 handles one request at a
+// time and cannot hold a stream open, so this is a separate listener
+// with its own task.
+//
+//   GET /events?hz=20&batch=5
+//
+// Each client picks its own sample rate (1–SSE_MAX_HZ) and how many
+// samples go into one event (1–SSE_MAX_BATCH). The first event
+// ("meta") names the columns of the sample arrays. Sockets are written
+// without blocking: while a client has not taken the previous event,
+// new ones are dropped and counted for that client only.
+
+#define SSE_PORT 81
+#define SSE_MAX_CLIENTS 4
+#define SSE_MAX_HZ 100
+#define SSE_DEFAULT_HZ 10
+#define SSE_MAX_BATCH 20
+
+// Task pacing; also the finest sample spacing
+#define SSE_TICK_MS 5
+#define SSE_TASK_PRIORITY 1
+
+// Clients must send their request headers within this time
+#define SSE_HANDSHAKE_MS 1000
+
+struct SseClientInfo {
+    IPAddress ip;
+    uint16_t hz;
+    uint8_t batch;
+    uint32_t connectedMs;     // How long the client has been streaming
+    uint32_t eventsSent;
+    uint32_t eventsDropped;   // Skipped because the client was still busy
+};
+
+// Starts listening (called when the radio comes up; safe to call more than once)
+void startSseServer();
+
+// Disconnects all clients and stops listening
+void stopSseServer();
+
+// Fills up to 'max' entries for streaming clients, returns the count
+int getSseClients(SseClientInfo* out, int max);
+
+// Prints connected clients and their counters to Serial
+void printSseClients();
+
+#endif  // SSE_SERVER_H
@@ -11,6 +11,29 @@ enum class SystemState {
     UNKNOWN
 };
 
+// ====== State Table ======
+// Every state is one row in state.cpp: its name, what it allows
+// (capabilities), which states it may switch to, and optional exit and
+// entry hooks. setState() runs the old state's exit hook, applies the
+// new state's capabilities (servo follow and RPM source first, then the
+// queued Wi-Fi change), then the new state's entry hook.
+enum StateCapability : uint8_t {
+    STATE_CAP_CLI        = 1 << 0,  // Full CLI; other states only get the rows that name them
+    STATE_CAP_WIFI       = 1 << 1,  // Radio on
+    STATE_CAP_FOLLOW     = 1 << 2,  // Servo follows RPM
+    STATE_CAP_SENSOR_RPM = 1 << 3   // RPM from the sensor instead of manual input
+};
+
+// Transitions kept for "state history" and GET /state
+#define STATE_HISTORY_SIZE 16
+
+struct StateTransition {
+    SystemState from;
+    SystemState to;
+    uint32_t atMs;       // millis() when the switch started
+    uint32_t latencyUs;  // Exit hook to end of entry hook; the radio finishes later
+};
+
 // ====== Exposed State API ======
 int getModeSwitchButtonPin();
 void setModeSwitchButtonPin(int pin);
@@ -18,7 +41,19 @@ void initState();
 void initModeButtonInterrupt();
 SystemState getCurrentState();
 const char* getCurrentStateName();
-bool setState(SystemState newState);
+const char* getStateName(SystemState state);
+bool parseStateName(const char* name, SystemState& out);
+bool setState(SystemState newState);     // false if unchanged or not allowed
 bool setStateByName(const String& name);  // CLI/Wi-Fi friendly
 void IRAM_ATTR modeSwitchISR();
 void changeStatus();
+
+// Capabilities and transitions from the state table
+bool stateHasCapability(SystemState state, StateCapability cap);
+bool isTransitionAllowed(SystemState from, SystemState to);
+
+// Copies up to 'max' transitions, oldest first; returns how many
+int getStateHistory(StateTransition* out, int max);
+uint32_t getStateTransitionCount();
+uint32_t getRejectedTransitionCount();
+void printStateHistory();
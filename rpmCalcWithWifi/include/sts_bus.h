@@ -0,0 +1,145 @@
+#ifndef STS_BUS_H
+#define STS_BUS_H
+
+#include <Arduino.h>
+#include "driver/uart.h"
+
+// ===============================
+// STS Bus Driver - Header File
+// ===============================
+// Minimal driver for the Feetech STS protocol spoken by the ST3215.
+// Only the commands this project uses are implemented. Packets are
+// built into preallocated buffers from compile-time templates, and I/O
+// goes through the ESP-IDF UART driver: TX drains from the interrupt-
+// driven FIFO and RX blocks on the driver's ring buffer with a tick
+// timeout, so a waiting task sleeps instead of spinning.
+// Every transaction returns an StsStatus.
+
+// === Protocol constants ===
+#define STS_BROADCAST_ID 0xFE
+
+#define STS_INST_PING 0x01
+#define STS_INST_READ 0x02
+#define STS_INST_WRITE 0x03
+#define STS_INST_SYNC_WRITE 0x83
+
+// Control table addresses (STS series)
+#define STS_REG_TORQUE_ENABLE 40
+#define STS_REG_ACC 41
+#define STS_REG_GOAL_POSITION 42
+#define STS_REG_PRESENT_POSITION 56
+#define STS_REG_PRESENT_CURRENT_H 70
+
+// Feedback block: PRESENT_POSITION_L .. PRESENT_CURRENT_H
+#define STS_FEEDBACK_LEN (STS_REG_PRESENT_CURRENT_H - STS_REG_PRESENT_POSITION + 1)
+
+// Default response timeout
+#define STS_DEFAULT_TIMEOUT_MS 5
+
+// Servos addressed by one SYNC_WRITE frame
+#define STS_MAX_SYNC_SERVOS 4
+
+enum class StsStatus : uint8_t {
+    OK,
+    TIMEOUT,          // No (complete) response within the timeout
+    BAD_HEADER,       // Response did not start with FF FF
+    BAD_CHECKSUM,     // Response checksum mismatch
+    BAD_LENGTH,       // Response length field does not match the request
+    WRONG_ID,         // Response came from another servo
+    SERVO_ERROR,      // Servo set a bit in its error byte
+    TX_FAILED,        // UART refused or did not finish the write
+    BUS_BUSY,         // Could not take the servo bus lock in time
+    NOT_READY,        // begin() not called
+    COUNT
+};
+
+// Decoded feedback block
+struct StsFeedback {
+    int16_t position;
+    int16_t speed;
+    int16_t load;
+    int16_t current;
+    uint8_t voltage;
+    uint8_t temperature;
+    bool moving;
+};
+
+// === Compile-time packet layout ===
+// FF FF ID LEN INSTR PARAMS... CHECKSUM
+// Header, length and instruction are fixed by the template; only the ID,
+// the parameters and the checksum are written per transaction.
+template <uint8_t Instr, uint8_t NParams>
+struct StsPacket {
+    static constexpr uint8_t kLength = NParams + 2;
+    static constexpr size_t kSize = NParams + 6;
+    static constexpr uint8_t kBaseSum = kLength + Instr;
+
+    uint8_t bytes[kSize] = {0xFF, 0xFF, 0x00, kLength, Instr};
+
+    uint8_t* params() { return bytes + 5; }
+
+    // Fills in ID and checksum once the parameters are in place
+    const uint8_t* seal(uint8_t id) {
+        bytes[2] = id;
+        uint8_t sum = kBaseSum + id;
+        for (size_t i = 0; i < NParams; ++i) sum += bytes[5 + i];
+        bytes[kSize - 1] = ~sum;
+        return bytes;
+    }
+};
+
+class StsBus {
+public:
+    // Attaches to a UART already started by HardwareSerial::begin()
+    void begin(uart_port_t port, uint32_t timeoutMs = STS_DEFAULT_TIMEOUT_MS);
+    bool isReady() const { return ready; }
+
+    // Detects whether our own TX is looped back on RX (single-wire wiring)
+    void detectEcho(uint8_t id);
+    bool hasEcho() const { return echo; }
+
+    StsStatus ping(uint8_t id);
+    StsStatus writePosEx(uint8_t id, int16_t position, uint16_t speed, uint8_t acc);
+    StsStatus writeByte(uint8_t id, uint8_t reg, uint8_t value);
+
+    // One broadcast frame carrying goal acc/position/speed for every
+    // servo; they all latch it at the same time. Never answered.
+    StsStatus syncWritePosEx(const uint8_t* ids, uint8_t count, const int16_t* positions,
+                             const uint16_t* speeds, const uint8_t* accs);
+
+    StsStatus readFeedback(uint8_t id, StsFeedback& out);
+    StsStatus readPos(uint8_t id, int16_t& position);
+
+    // Per-status transaction counters
+    uint32_t statusCount(StsStatus s) const { return counters[(int)s]; }
+    void resetCounters() { memset(counters, 0, sizeof(counters)); }
+    uint32_t timeoutMs() const { return rxTimeoutMs; }
+
+private:
+    StsStatus transact(const uint8_t* tx, size_t txLen, uint8_t id,
+                       uint8_t* params, size_t paramLen);
+    StsStatus send(const uint8_t* tx, size_t txLen);
+    bool readExact(uint8_t* buf, size_t len, TickType_t deadline);
+    StsStatus finish(StsStatus s);
+
+    uart_port_t uart = UART_NUM_1;
+    uint32_t rxTimeoutMs = STS_DEFAULT_TIMEOUT_MS;
+    bool ready = false;
+    bool echo = false;
+    uint32_t counters[(int)StsStatus::COUNT] = {};
+
+    // Preallocated packets and receive buffer
+    StsPacket<STS_INST_PING, 0> pingPacket;
+    StsPacket<STS_INST_READ, 2> readPacket;
+    StsPacket<STS_INST_WRITE, 2> writeBytePacket;
+    StsPacket<STS_INST_WRITE, 8> writePosPacket;
+    uint8_t rxBuf[STS_FEEDBACK_LEN + 6];
+
+    // FF FF FE LEN INSTR ADDR DATALEN + (ID + 7 data bytes) per servo + CHECKSUM
+    uint8_t syncBuf[8 + STS_MAX_SYNC_SERVOS * 8];
+};
+
+// Returns a short name for a status code
+const char* stsStatusName(StsStatus s);
+
+#endif  // STS_BUS_H
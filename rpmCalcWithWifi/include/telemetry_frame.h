@@ -0,0 +1,76 @@
+#ifndef TELEMETRY_FRAME_H
+#define TELEMETRY_FRAME_H
+
+#include <Arduino.h>
+
+// ===============================
+// Telemetry Frames - Header File
+// ===============================
+// Compact binary samples for high-rate logging over USB serial
+// ("rpm live bin"). A frame is:
+//
+//   type (1) | seq (1) | fields as varints | CRC-16/CCITT (2, LE)
+//
+// COBS-encoded and terminated by 0x00, so a reader can resync on any
+// zero byte and text printed in between is rejected by the CRC.
+// Keyframes hold each field as a difference from zero, delta frames as
+// a difference from the previous frame that was actually sent. seq
+// counts sent frames only: a gap means a frame was lost in transit and
+// the decoder waits for the next keyframe. Samples dropped on the
+// device because the port was busy set TELEMETRY_DROPPED instead.
+// tools/telemetry_decode.py turns a capture into CSV or Parquet.
+
+#define TELEMETRY_FRAME_KEY 0x01
+#define TELEMETRY_FRAME_DELTA 0x02
+
+// A keyframe is forced after this many delta frames
+#define TELEMETRY_KEYFRAME_INTERVAL 64
+
+// Worst case encoded frame, including COBS overhead and the delimiter
+#define TELEMETRY_MAX_FRAME 40
+
+enum TelemetryFlag : uint8_t {
+    TELEMETRY_FOLLOWING    = 1 << 0,  // Servo follows RPM
+    TELEMETRY_MOVEMENT_PIN = 1 << 1,  // Movement pin level
+    TELEMETRY_SERVO_MOVING = 1 << 2,  // Servo reports motion
+    TELEMETRY_RPM_SENSOR   = 1 << 3,  // RPM comes from the sensor
+    TELEMETRY_SERVO_VALID  = 1 << 4,  // servoActual is from a real read
+    TELEMETRY_DROPPED      = 1 << 5,  // Samples were dropped before this one
+};
+
+struct TelemetrySample {
+    uint32_t timestampUs;   // micros()
+    int32_t rpmX10;         // RPM × 10
+    int32_t rpmRate;        // dRPM/dt in RPM/s
+    int32_t mode;           // Commanded mode, -1 if none
+    int32_t servoTarget;    // Last commanded position
+    int32_t servoActual;    // Position from telemetry
+    uint8_t flags;          // TelemetryFlag bits
+};
+
+class TelemetryEncoder {
+public:
+    // Encodes 's' into 'out' (TELEMETRY_MAX_FRAME bytes) as one
+    // delimited frame and returns its length. Nothing changes until
+    // commit(), so an unsent frame does not become the next baseline.
+    size_t encode(const TelemetrySample& s, uint8_t* out);
+
+    // Marks the last encoded frame as sent
+    void commit();
+
+    // Makes the next frame a keyframe with sequence 0
+    void reset();
+
+private:
+    TelemetrySample base = {};
+    TelemetrySample pending = {};
+    uint8_t seq = 0;
+    uint8_t sinceKey = 0;
+    bool haveBase = false;
+    bool pendingKey = false;
+};
+
+// CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF)
+uint16_t telemetryCrc16(const uint8_t* data, size_t len);
+
+#endif  // TELEMETRY_FRAME_H
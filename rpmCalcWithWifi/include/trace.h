@@ -0,0 +1,89 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <Arduino.h>
+
+// ===============================
+// Trace Recorder - Header File
+// ===============================
+// Timeline of what ran when: a fixed ring of 8-byte event records
+// (µs timestamp, event type, phase, task, 16-bit value) written from
+// tasks and ISRs without allocation. "trace dump" streams the ring as
+// hex between markers; tools/trace2chrome.py turns that into a Chrome
+// trace (chrome://tracing, ui.perfetto.dev).
+//
+// The ring keeps the newest TRACE_CAPACITY events. RPM edges are the
+// busiest source and can be left out with "trace isr off".
+
+#define TRACE_CAPACITY 2048
+
+// Up to this many distinct tasks are told apart; index 0 is "ISR"
+#define TRACE_MAX_TASKS 16
+
+enum TraceType : uint8_t {
+    TRACE_RPM_EDGE,       // Instant, value = period in µs (saturated)
+    TRACE_MODE_CROSSING,  // Instant, ISR saw the period leave the mode's bounds
+    TRACE_MODE,           // Instant, value = mode commanded
+    TRACE_SERVO_CMD,      // Span, value = goal position
+    TRACE_SERVO_BUS,      // Span, one STS transaction
+    TRACE_CONTROL,        // Span, control task handling a crossing
+    TRACE_STATE,          // Instant, value = new SystemState
+    TRACE_HTTP,           // Span, one HTTP handler
+    TRACE_CLI,            // Span, one CLI line
+    TRACE_MARK,           // Instant, "trace mark <n>"
+    TRACE_RADIO,          // Span, Wi-Fi brought up (value 1) or down (0)
+    TRACE_TYPE_COUNT
+};
+
+enum TracePhase : uint8_t {
+    TRACE_INSTANT,
+    TRACE_BEGIN,
+    TRACE_END
+};
+
+struct TraceEvent {
+    uint32_t timestampUs;   // micros()
+    uint8_t type;           // TraceType
+    uint8_t phaseTask;      // Phase in bits 7–6, task index in bits 5–0
+    uint16_t value;
+};
+
+extern volatile bool traceEnabled;
+
+// Appends one event. ISR-safe.
+void IRAM_ATTR traceEvent(TraceType type, TracePhase phase, uint32_t value = 0);
+
+void setTraceEnabled(bool enabled);
+void setTraceIsrEnabled(bool enabled);
+bool isTraceIsrEnabled();
+void clearTrace();
+
+// Number of events currently held
+uint32_t getTraceCount();
+
+// Starts streaming the ring to Serial as hex lines between TRACE
+// BEGIN/END markers. dumpTrace() only prints the header; the records
+// follow from serviceTraceDump(), which the CLI calls every loop() pass
+// until the END marker. Recording and other CLI commands wait until then.
+#define TRACE_DUMP_LINES_PER_CALL 64
+#define TRACE_DUMP_LINE_BYTES 20   // "tttttttt tt pp vvvv\n"
+void dumpTrace();
+bool isTraceDumpActive();
+void serviceTraceDump();
+
+// Begin/end pair around a block
+class TraceScope {
+public:
+    TraceScope(TraceType t, uint32_t v = 0) : type(t), value(v) { traceEvent(type, TRACE_BEGIN, value); }
+    ~TraceScope() { traceEvent(type, TRACE_END, value); }
+
+private:
+    TraceType type;
+    uint32_t value;
+};
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+#define TRACE_SCOPE(...) TraceScope TRACE_CONCAT(traceScope_, __LINE__)(__VA_ARGS__)
+
+#endif  // TRACE_H
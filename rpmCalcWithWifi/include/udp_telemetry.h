@@ -0,0 +1,62 @@
+#ifndef UDP_TELEMETRY_H
+#define UDP_TELEMETRY_H
+
+#include <Arduino.h>
+
+// ===============================
+// UDP Telemetry - Header File
+// ===============================
+// Optional telemetry for the pit: while the system is in diagnostics
+// mode, one fixed-size packet per sample is broadcast on the soft AP
+// subnet (or sent to a multicast group). Every laptop on the AP can
+// listen, and the device sends the same packets whether there are zero
+// listeners or ten. Nothing is acknowledged: listeners detect loss from
+// gaps in the sequence number (tools/udp_listener.py).
+//
+// Packet, little-endian, UDP_PACKET_SIZE bytes:
+//
+//   0  'R' 'T'        magic
+//   2  u8  version    UDP_PACKET_VERSION
+//   3  u8  state      SystemState of the device
+//   4  u32 seq        +1 per packet since boot, also for failed sends
+//   8  u32 t_ms       millis() at sampling
+//  12  i32 rpm_x10    RPM × 10
+//  16  i16 target     Last commanded servo position
+//  18  i16 actual     Servo position from telemetry
+//  20  i8  mode       Mode last commanded, -1 if none
+//  21  u8  flags      TelemetryFlag bits (telemetry_frame.h)
+//  22  u16 rate_hz    Configured packet rate
+
+#define UDP_TELEMETRY_PORT 4210
+#define UDP_MULTICAST_GROUP IPAddress(239, 10, 0, 1)
+
+#define UDP_PACKET_VERSION 1
+#define UDP_PACKET_SIZE 24
+
+#define UDP_MIN_HZ 1
+#define UDP_MAX_HZ 100
+#define UDP_DEFAULT_HZ 20
+
+#define UDP_TASK_PRIORITY 1
+
+// How often an idle stream checks whether it may send again
+#define UDP_IDLE_CHECK_MS 500
+
+// Loads the stored settings and starts the sender task
+void initUdpTelemetry();
+
+// Enables the stream (sent only in diagnostics mode) and stores the
+// settings. 'hz' is clamped to UDP_MIN_HZ..UDP_MAX_HZ.
+void enableUdpTelemetry(int hz, bool multicast);
+void disableUdpTelemetry();
+
+// Settings as stored in NVS (setUdpTelemetry() does not store)
+bool isUdpTelemetryEnabled();
+int getUdpTelemetryRate();
+bool isUdpTelemetryMulticast();
+void setUdpTelemetry(bool enabled, int hz, bool multicast);
+
+// Prints settings, destination and packet counters
+void printUdpTelemetryStatus();
+
+#endif  // UDP_TELEMETRY_H
@@ -0,0 +1,238 @@
+#ifndef WEB_ASSETS_H
+#define WEB_ASSETS_H
+
+#include <Arduino.h>
+
+// ===============================
+// Web Assets - Header File
+// ===============================
+// Generated by tools/embed_web.py from web/ -- do not edit.
+// gzip-compressed dashboard files, served by handleWebAsset().
+
+struct WebAsset {
+    const char* path;
+    const char* contentType;
+    const uint8_t* data;      // gzip
+    size_t length;
+    const char* etag;         // Quoted, as sent
+    bool immutable;           // Versioned URL, cache for good
+};
+
+// app.js: 4669 bytes, 1791 gzipped
+static const uint8_t WEB_APP_JS[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0x9d, 0x57, 0x5d, 0x6e, 0xdb, 0x46,
+    0x10, 0x7e, 0xf7, 0x29, 0xa6, 0x84, 0x51, 0x90, 0x88, 0x4c, 0x49, 0x28, 0x0a, 0x04, 0x56, 0x94,
+    0xa0, 0x09, 0xfc, 0xd0, 0xc2, 0x49, 0x8c, 0xc8, 0xed, 0x8b, 0x20, 0xd8, 0x2b, 0x72, 0x24, 0xb1,
+    0xa1, 0xb8, 0xec, 0xee, 0xca, 0xb6, 0xea, 0x08, 0xc8, 0x1d, 0x7a, 0x87, 0x1e, 0x2c, 0x27, 0xe9,
+    0xcc, 0xee, 0xf2, 0x4f, 0x92, 0xdd, 0xa2, 0x81, 0x23, 0x4a, 0xbb, 0xdf, 0xce, 0x7c, 0xf3, 0xbb,
+    0xc3, 0x60, 0xa3, 0x11, 0xb4, 0x51, 0x59, 0x62, 0x82, 0xd1, 0xc9, 0x49, 0xbf, 0x0f, 0x97, 0xd9,
+    0x1d, 0xc2, 0x9d, 0xc8, 0x37, 0xa8, 0x41, 0x28, 0xc5, 0xbf, 0xe4, 0x1d, 0x2a, 0x30, 0x2b, 0x04,
+    0xbc, 0xc3, 0xc2, 0x30, 0x1c, 0xc5, 0x1a, 0x64, 0x01, 0xa5, 0x54, 0x06, 0x5e, 0x0e, 0x21, 0xd4,
+    0x48, 0x52, 0x34, 0xde, 0x68, 0x54, 0x84, 0x8d, 0x57, 0xd1, 0x88, 0x45, 0x65, 0x0b, 0xc8, 0x0c,
+    0x24, 0xa2, 0x28, 0xa4, 0x81, 0x39, 0x02, 0x1d, 0x4b, 0x56, 0x98, 0xf6, 0xa0, 0x9f, 0x0a, 0x23,
+    0x40, 0x14, 0x29, 0xf4, 0x93, 0x8d, 0x52, 0x24, 0xf4, 0xa6, 0x94, 0x3a, 0x33, 0x19, 0xc9, 0x14,
+    0x0a, 0x49, 0x6e, 0x9e, 0x63, 0x1a, 0x9f, 0x24, 0xb2, 0xd0, 0x06, 0x2e, 0x7e, 0xbb, 0xf8, 0x70,
+    0x3d, 0xb9, 0xf9, 0xf5, 0xd3, 0x25, 0x8c, 0xe1, 0x76, 0x65, 0x4c, 0x79, 0xde, 0xef, 0x9f, 0x3e,
+    0xe6, 0x32, 0x11, 0x7c, 0x22, 0x5e, 0x49, 0x6d, 0x0a, 0xb1, 0xc6, 0xdd, 0xf9, 0xcb, 0x61, 0xdf,
+    0x52, 0xd4, 0x6f, 0x56, 0x7f, 0x8e, 0x87, 0x83, 0xef, 0xe7, 0xc2, 0x24, 0xab, 0xf1, 0xf0, 0x76,
+    0xe4, 0x25, 0x5d, 0x7d, 0xbc, 0xbc, 0xbc, 0x79, 0x3f, 0x21, 0x31, 0x3f, 0x0e, 0x06, 0x64, 0xae,
+    0x5b, 0x3d, 0xa5, 0xdf, 0x61, 0x96, 0x46, 0x30, 0x7e, 0x0d, 0xa9, 0x4c, 0x36, 0x6b, 0x92, 0x10,
+    0x2f, 0xd1, 0x5c, 0xe4, 0xc8, 0x5f, 0xdf, 0x6e, 0x7f, 0x4e, 0x79, 0x9b, 0xf0, 0x8b, 0x4d, 0x91,
+    0x58, 0x92, 0x1a, 0xcd, 0xc4, 0x08, 0xb3, 0xd1, 0xa1, 0xc1, 0x07, 0xd3, 0x83, 0xb9, 0xa0, 0xe3,
+    0x8f, 0x27, 0x00, 0xa7, 0x61, 0xa0, 0xed, 0x46, 0x10, 0xc5, 0xbc, 0xf5, 0x4e, 0x16, 0x86, 0x7d,
+    0x36, 0x06, 0xfe, 0x35, 0xda, 0x43, 0x24, 0xb9, 0xd0, 0xfa, 0x03, 0x51, 0xa7, 0x7d, 0x12, 0x01,
+    0x6f, 0x20, 0xa0, 0x47, 0x00, 0xe7, 0x10, 0x50, 0x34, 0x76, 0x5d, 0x85, 0x97, 0x59, 0xf1, 0xd9,
+    0xab, 0x4b, 0x72, 0x5d, 0xab, 0xcb, 0x69, 0xf9, 0x39, 0x65, 0x7e, 0xbf, 0xad, 0x8a, 0x95, 0x2c,
+    0x11, 0x02, 0x78, 0x01, 0x21, 0x89, 0x82, 0x2f, 0x5f, 0x48, 0x5f, 0x64, 0x15, 0x0a, 0xbd, 0x2d,
+    0x12, 0xa8, 0xd5, 0x2a, 0xfc, 0x83, 0xf2, 0xc0, 0x84, 0xa5, 0x30, 0x2b, 0xb2, 0x52, 0xa6, 0x5b,
+    0xa7, 0xd7, 0x39, 0x4e, 0x96, 0x46, 0x33, 0x73, 0x5a, 0x86, 0xf1, 0x78, 0x0c, 0x9b, 0x22, 0xc5,
+    0x45, 0x56, 0x20, 0x1b, 0xf2, 0xb8, 0x23, 0x2b, 0x18, 0x0a, 0xb0, 0x46, 0xb3, 0x92, 0x29, 0xd9,
+    0x74, 0xf5, 0x71, 0x72, 0x1d, 0xf4, 0xec, 0xda, 0x0a, 0x45, 0x8a, 0x4a, 0x13, 0x04, 0x02, 0x4f,
+    0xfb, 0xec, 0x7a, 0x5b, 0x62, 0x40, 0x30, 0x51, 0x96, 0x79, 0xe6, 0x62, 0xdb, 0xff, 0x5d, 0xcb,
+    0x22, 0x80, 0x9d, 0x3b, 0xc4, 0x8a, 0xce, 0xe1, 0x97, 0xc9, 0xc7, 0x0f, 0x31, 0xa7, 0x6c, 0xb1,
+    0xcc, 0x16, 0xdb, 0xd0, 0x92, 0xe2, 0xfd, 0xdd, 0xa8, 0x26, 0xa6, 0x50, 0x97, 0x44, 0x4c, 0xdc,
+    0x0b, 0xca, 0xbf, 0x05, 0x52, 0x12, 0x78, 0x0b, 0x98, 0x71, 0xd4, 0xe0, 0xd8, 0x4d, 0x35, 0x8e,
+    0x0f, 0x59, 0x37, 0x86, 0x16, 0x41, 0xc9, 0x1b, 0x7e, 0x67, 0xd7, 0xe4, 0xe7, 0x88, 0xb2, 0x5f,
+    0xc9, 0x7b, 0x28, 0xf0, 0x1e, 0x2e, 0x94, 0x92, 0xca, 0xc6, 0x81, 0xfd, 0x66, 0x01, 0x2e, 0x9e,
+    0xd7, 0xb4, 0x64, 0x4f, 0x2a, 0x34, 0x1b, 0x55, 0xf8, 0x18, 0xec, 0xaa, 0x2c, 0xa3, 0x84, 0xfa,
+    0x85, 0x8c, 0x61, 0x75, 0xd6, 0xc7, 0x96, 0x91, 0xcd, 0x39, 0x6b, 0x50, 0x29, 0x94, 0xc6, 0xb0,
+    0x62, 0xd2, 0x78, 0x3d, 0x8a, 0x5c, 0x59, 0x9e, 0xd1, 0xbf, 0x4e, 0x6d, 0xf2, 0x42, 0x3b, 0x41,
+    0x56, 0xf2, 0x7e, 0x22, 0xd6, 0x65, 0x8e, 0x61, 0x22, 0xf3, 0xcd, 0xba, 0xd0, 0x3d, 0x20, 0xca,
+    0x3d, 0x60, 0x72, 0xd8, 0x8e, 0x9a, 0x3d, 0xcf, 0x29, 0xcf, 0x35, 0x63, 0x09, 0x10, 0x6e, 0xea,
+    0x0f, 0xc5, 0x19, 0xc5, 0xf0, 0xe1, 0xe3, 0xc2, 0x6d, 0xce, 0x7c, 0x0e, 0xa9, 0x72, 0x7d, 0x90,
+    0x62, 0xef, 0x89, 0x5c, 0xac, 0x24, 0xc5, 0x3c, 0xb4, 0x12, 0x3d, 0x2a, 0xf2, 0x47, 0xd6, 0x32,
+    0xc5, 0x83, 0x33, 0x1e, 0xe8, 0xf6, 0xe0, 0x35, 0x0c, 0x28, 0x51, 0xba, 0x6b, 0x14, 0xfe, 0x6f,
+    0x5f, 0xff, 0x0a, 0xbc, 0x10, 0x23, 0x14, 0xb9, 0xed, 0x29, 0x31, 0xd5, 0xae, 0x07, 0x8b, 0xc4,
+    0x6c, 0x44, 0xfe, 0x14, 0xb8, 0xda, 0xad, 0x42, 0xeb, 0xdd, 0xe2, 0xab, 0xf1, 0x90, 0xaa, 0x5d,
+    0xdd, 0xab, 0x41, 0x52, 0x68, 0x2e, 0x6c, 0x7f, 0x09, 0x9d, 0x43, 0x73, 0xa4, 0xf6, 0xe6, 0x1c,
+    0x47, 0x47, 0xa6, 0x81, 0xb9, 0x59, 0xeb, 0xa0, 0x07, 0xd6, 0x13, 0xf4, 0xb0, 0x36, 0xd1, 0xd3,
+    0x13, 0xa5, 0x6f, 0x9e, 0x85, 0xf5, 0x2b, 0x1f, 0x96, 0x25, 0x72, 0xb9, 0x8c, 0x61, 0x21, 0x72,
+    0x8d, 0x4d, 0x62, 0xba, 0x2e, 0x46, 0xeb, 0x36, 0xe3, 0xf8, 0xc7, 0x44, 0x6e, 0x54, 0x82, 0x61,
+    0xd3, 0x0b, 0x39, 0x2f, 0xc0, 0x03, 0x63, 0x91, 0xa6, 0x16, 0x75, 0x99, 0x69, 0xe2, 0x8f, 0x8a,
+    0xfc, 0x89, 0x46, 0x90, 0xc6, 0xd0, 0x45, 0xd8, 0x15, 0x62, 0x43, 0xb5, 0x95, 0x72, 0x18, 0x73,
+    0x33, 0x8e, 0xe2, 0x45, 0x86, 0x79, 0xaa, 0x99, 0xc2, 0xce, 0x3a, 0xc9, 0x4b, 0x96, 0x05, 0x73,
+    0xe4, 0x74, 0x69, 0x09, 0xaa, 0x69, 0x1b, 0xb5, 0xb1, 0xac, 0xa1, 0x6e, 0x50, 0xd4, 0x6f, 0xee,
+    0xac, 0xd1, 0xf2, 0xb3, 0x73, 0xf6, 0xae, 0x23, 0x6c, 0x8d, 0x5a, 0x8b, 0xa5, 0x4d, 0xbf, 0x2e,
+    0x33, 0xb6, 0x7a, 0xad, 0x97, 0x47, 0xb9, 0x39, 0x0d, 0x1c, 0x35, 0x42, 0xc4, 0x3a, 0xce, 0xb1,
+    0x58, 0x72, 0xed, 0x1c, 0xcb, 0x79, 0x8b, 0x98, 0xb6, 0x71, 0x70, 0x06, 0xc3, 0x99, 0xdf, 0xb0,
+    0x41, 0x3f, 0x64, 0x85, 0x5c, 0xd3, 0x7b, 0x36, 0xb2, 0x3a, 0x67, 0x67, 0xe4, 0x57, 0x5a, 0x46,
+    0x2a, 0x24, 0xc6, 0x05, 0x52, 0x5e, 0x14, 0xcb, 0x6f, 0x5f, 0xff, 0x66, 0x7b, 0xb9, 0x71, 0x47,
+    0x23, 0x00, 0xaa, 0xd5, 0x56, 0xc0, 0xb8, 0x19, 0xa8, 0x8c, 0xca, 0x75, 0xbe, 0xa5, 0xbb, 0x50,
+    0x63, 0xbe, 0xf0, 0xa2, 0x5c, 0x93, 0x70, 0x96, 0xed, 0xec, 0xa7, 0x67, 0x93, 0xe4, 0x92, 0x2c,
+    0xf7, 0x36, 0xdb, 0x94, 0xbb, 0xa2, 0xdb, 0x90, 0xf4, 0x84, 0x15, 0xf1, 0x83, 0x9c, 0xac, 0x01,
+    0x96, 0x68, 0x4d, 0xb2, 0x74, 0xcb, 0x4c, 0x2e, 0x68, 0x35, 0x3d, 0x5e, 0x6e, 0xba, 0x50, 0xcb,
+    0x62, 0xa3, 0xb6, 0xb5, 0xa5, 0x0e, 0x3a, 0x65, 0xf7, 0x93, 0xeb, 0x28, 0x8f, 0x67, 0x75, 0x9f,
+    0xbc, 0x52, 0x72, 0x9d, 0x69, 0x8c, 0x45, 0x9e, 0x87, 0x53, 0xdf, 0xd5, 0xc2, 0xc0, 0x5e, 0xe9,
+    0x41, 0xd4, 0x83, 0x66, 0x65, 0xff, 0x6a, 0x0f, 0xa2, 0x99, 0x37, 0xeb, 0xbf, 0x34, 0x15, 0x96,
+    0x17, 0x13, 0xa6, 0x7d, 0xe4, 0x68, 0x53, 0xe1, 0xc5, 0x78, 0x5f, 0xd7, 0x68, 0x3f, 0x62, 0x2d,
+    0x67, 0x54, 0x99, 0x49, 0xce, 0xa4, 0xe1, 0x84, 0x2e, 0x07, 0xca, 0x45, 0xa5, 0x8e, 0x44, 0x59,
+    0x2e, 0x16, 0x74, 0x06, 0x9b, 0xe8, 0xb6, 0xa2, 0x45, 0xa0, 0xeb, 0x6c, 0x8d, 0x72, 0x43, 0x6d,
+    0x9a, 0x44, 0xf7, 0xaa, 0xd9, 0xa2, 0xc9, 0x2e, 0x5e, 0x0e, 0xdd, 0xad, 0x5a, 0xf5, 0xef, 0x8b,
+    0x34, 0x33, 0x52, 0x1d, 0xf4, 0xee, 0x62, 0xb3, 0x9e, 0xa3, 0xfa, 0xb9, 0x28, 0x49, 0x58, 0x2e,
+    0xe6, 0x48, 0xd2, 0x6c, 0xd7, 0x22, 0xcf, 0x67, 0x05, 0x7d, 0x88, 0x87, 0x76, 0xff, 0xbe, 0x57,
+    0x82, 0x2f, 0xb7, 0x7a, 0x52, 0x49, 0x68, 0xac, 0x32, 0xe8, 0x87, 0x95, 0x30, 0x48, 0xb3, 0xbb,
+    0x76, 0xb4, 0xf3, 0x79, 0xfe, 0x0c, 0xd8, 0x6a, 0x6b, 0xc3, 0x33, 0x26, 0xf1, 0xcc, 0x01, 0xbb,
+    0xef, 0x0e, 0x90, 0xe4, 0xbd, 0x48, 0x58, 0x69, 0xb6, 0xc1, 0x32, 0x2a, 0x36, 0x74, 0x9f, 0xf3,
+    0xb4, 0xe1, 0xcc, 0x0b, 0x9a, 0x8d, 0xea, 0x06, 0xb2, 0xcf, 0xaa, 0x21, 0x93, 0xa9, 0xf0, 0x5d,
+    0x7b, 0x88, 0x88, 0x3c, 0x9a, 0x37, 0xc6, 0xec, 0x89, 0x1a, 0x29, 0x1e, 0x9e, 0x40, 0xd2, 0xc6,
+    0x98, 0xdd, 0xc5, 0x48, 0x76, 0x53, 0x4c, 0xa3, 0x04, 0x52, 0x2e, 0x11, 0xd5, 0x9e, 0xc3, 0xb4,
+    0x2f, 0x68, 0x46, 0xb4, 0x2e, 0x68, 0x32, 0x34, 0xb5, 0x31, 0xd0, 0xad, 0x79, 0x70, 0x1a, 0xc7,
+    0xf1, 0x29, 0xff, 0x88, 0xe9, 0x4a, 0x56, 0xdb, 0x09, 0xe6, 0x54, 0xf4, 0x52, 0xfd, 0x44, 0xa1,
+    0xad, 0x7c, 0x31, 0x23, 0xbd, 0x65, 0x18, 0x66, 0x16, 0xff, 0xc1, 0xda, 0x1a, 0x66, 0xce, 0xc6,
+    0xa8, 0x33, 0x34, 0x52, 0x82, 0xd2, 0xcc, 0xf3, 0x49, 0x14, 0x4b, 0xd4, 0x34, 0xb6, 0x10, 0x7d,
+    0xc1, 0xad, 0xa1, 0x9e, 0xe4, 0x94, 0xdd, 0xa1, 0xfc, 0x56, 0x58, 0xe6, 0x22, 0xc1, 0x77, 0xab,
+    0x2c, 0x4f, 0xe9, 0x50, 0x48, 0x1c, 0x1a, 0xb8, 0xd3, 0x36, 0x27, 0x7b, 0xac, 0xc2, 0x76, 0xee,
+    0xdc, 0xbe, 0x75, 0xa8, 0x2d, 0x9c, 0x3e, 0x66, 0x34, 0xdc, 0x0d, 0x77, 0xb7, 0x34, 0xb4, 0xf5,
+    0x60, 0x10, 0x45, 0x47, 0xa7, 0xbb, 0x5c, 0x8a, 0xd4, 0xd3, 0x69, 0x27, 0xd8, 0x23, 0x38, 0x26,
+    0x54, 0x1e, 0x55, 0xcd, 0x37, 0x45, 0x5d, 0x91, 0x6c, 0x52, 0xa6, 0xa1, 0x46, 0x70, 0xb7, 0x5d,
+    0x75, 0xde, 0x37, 0x30, 0x75, 0x0b, 0xd3, 0xc1, 0x8c, 0xfe, 0x7a, 0x40, 0x96, 0x78, 0x84, 0xb5,
+    0x42, 0xb9, 0xf1, 0x63, 0x3a, 0x9c, 0x45, 0x33, 0xba, 0xfa, 0xa7, 0x83, 0x1e, 0x0c, 0x07, 0x83,
+    0xc1, 0xcc, 0x05, 0xe9, 0xb8, 0xb7, 0x8e, 0x19, 0xa2, 0xc5, 0x1d, 0x1e, 0x31, 0xa4, 0xcb, 0xac,
+    0x0e, 0x6f, 0xe3, 0x69, 0xd6, 0xb3, 0xa0, 0xce, 0x1f, 0xf2, 0x5d, 0x9c, 0x11, 0x68, 0x38, 0xa2,
+    0xc7, 0xab, 0xd6, 0x41, 0x6f, 0x09, 0x2d, 0xbf, 0x78, 0x11, 0xb5, 0x6e, 0x86, 0x06, 0x31, 0xcd,
+    0x66, 0xf0, 0x6a, 0x0c, 0xed, 0x05, 0x7b, 0xe3, 0x74, 0xfa, 0x89, 0x7f, 0x59, 0x38, 0x0c, 0x10,
+    0xac, 0x37, 0xda, 0xbe, 0x1b, 0x89, 0x39, 0xbd, 0x65, 0x55, 0x52, 0xec, 0x3e, 0x07, 0x8f, 0xef,
+    0xd7, 0xba, 0x01, 0xee, 0x5f, 0x19, 0xfc, 0xbf, 0x3b, 0x30, 0x06, 0x7d, 0xf6, 0xc4, 0x8d, 0x37,
+    0xaf, 0x57, 0x47, 0xf2, 0xbc, 0xed, 0x0a, 0x77, 0xbd, 0x37, 0xa4, 0x02, 0xe7, 0x39, 0xeb, 0xc4,
+    0x74, 0x04, 0xfc, 0x0a, 0x27, 0xa1, 0xea, 0xa3, 0x1a, 0xee, 0x51, 0xf1, 0x2d, 0xb6, 0xe4, 0xb1,
+    0x82, 0x3a, 0x41, 0x1a, 0x3b, 0xb7, 0x39, 0xc5, 0x9c, 0x41, 0x57, 0x15, 0x34, 0x7c, 0x32, 0xc9,
+    0x5a, 0x90, 0x4e, 0x9e, 0xd5, 0x5a, 0x9a, 0x4e, 0x77, 0x34, 0xe9, 0x6a, 0x5c, 0x3d, 0xec, 0xd5,
+    0x2b, 0x67, 0xab, 0xac, 0x38, 0x9c, 0x10, 0x6f, 0x3f, 0x89, 0x7b, 0x6f, 0x09, 0x0d, 0x44, 0xa5,
+    0x86, 0x92, 0xde, 0x60, 0xf9, 0xa2, 0xe8, 0x91, 0x67, 0x49, 0xd5, 0x8e, 0x86, 0x4c, 0xfa, 0x22,
+    0x1e, 0x76, 0xf1, 0xed, 0xbe, 0xc4, 0xe3, 0x05, 0x58, 0x6f, 0xbb, 0xcc, 0x2d, 0x8f, 0xd6, 0xdf,
+    0x7b, 0xd2, 0xd0, 0xae, 0xbd, 0xb2, 0xd5, 0xc1, 0xa3, 0x27, 0x33, 0x77, 0xdf, 0x3b, 0xfb, 0x31,
+    0x6d, 0x98, 0xf5, 0xda, 0x3e, 0x3b, 0xef, 0xa4, 0x74, 0x8b, 0xfe, 0x61, 0x84, 0x27, 0x7b, 0x31,
+    0xb5, 0xa1, 0x8e, 0xfd, 0x2b, 0x5f, 0xcd, 0x65, 0xb9, 0x11, 0x2a, 0x0d, 0x17, 0x85, 0x63, 0xe1,
+    0x9b, 0xe4, 0xf3, 0x63, 0x82, 0x7f, 0xc3, 0x2a, 0xc2, 0x7f, 0xbb, 0x50, 0x3d, 0x13, 0x5a, 0x8e,
+    0xfd, 0x08, 0xd8, 0x49, 0xee, 0x5d, 0x3d, 0xd9, 0x54, 0x7d, 0xf0, 0x8c, 0x46, 0x5a, 0x8a, 0x84,
+    0x2c, 0x12, 0x7a, 0x17, 0xfc, 0xdc, 0x99, 0xcd, 0x7c, 0x71, 0x3f, 0x53, 0xd3, 0x9d, 0xde, 0xc1,
+    0x2d, 0x9c, 0x9a, 0xe0, 0x7c, 0x3a, 0x6f, 0x0f, 0x84, 0x1c, 0x22, 0x6e, 0x35, 0xec, 0x83, 0x51,
+    0xa3, 0x55, 0xe1, 0x9a, 0xea, 0xf0, 0x7f, 0x2b, 0xb6, 0xad, 0xa1, 0x52, 0xf3, 0x1a, 0x7e, 0x88,
+    0xf6, 0xda, 0x58, 0xac, 0x49, 0x28, 0x86, 0xd4, 0xe7, 0xce, 0x86, 0x51, 0x57, 0xb5, 0x3e, 0xe3,
+    0xa8, 0x74, 0x34, 0xbb, 0x80, 0x34, 0xcd, 0x2d, 0xb2, 0xe8, 0x26, 0xf5, 0x9f, 0x39, 0x50, 0xe7,
+    0x14, 0xdf, 0x40, 0x9d, 0x17, 0x97, 0xd1, 0x89, 0x43, 0xed, 0x07, 0xb6, 0x29, 0xe8, 0xaa, 0x93,
+    0x3e, 0x57, 0xe6, 0x11, 0x7f, 0xfe, 0x03, 0xfa, 0x69, 0x4b, 0x12, 0x3d, 0x12, 0x00, 0x00,
+};
+
+// style.css: 1895 bytes, 727 gzipped
+static const uint8_t WEB_STYLE_CSS[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xa5, 0x55, 0x7f, 0x6f, 0x9b, 0x30,
+    0x10, 0xfd, 0xbf, 0x9f, 0xc2, 0x52, 0x34, 0xa9, 0x99, 0x02, 0x0b, 0x3f, 0x92, 0xd2, 0xe4, 0xd3,
+    0x1c, 0x60, 0xc0, 0x0b, 0xd8, 0xc8, 0x36, 0x6d, 0xb2, 0xaa, 0xdf, 0x7d, 0x77, 0x36, 0x49, 0xea,
+    0x34, 0xd3, 0xa6, 0x4e, 0x91, 0x40, 0x3c, 0x9f, 0xef, 0xee, 0x3d, 0x3f, 0x5f, 0x76, 0x5a, 0x29,
+    0xcb, 0xde, 0x1e, 0x18, 0x8b, 0xa2, 0xb2, 0xdd, 0xb1, 0x45, 0x92, 0x27, 0xdb, 0x04, 0xf6, 0x0e,
+    0xa8, 0x40, 0xd7, 0x04, 0xf1, 0x34, 0x4d, 0x0b, 0x0f, 0x59, 0x7e, 0xb4, 0x08, 0xf1, 0x2d, 0x2f,
+    0x78, 0xe9, 0xa1, 0x61, 0xb2, 0x9c, 0xc2, 0x8a, 0xf2, 0x39, 0x7d, 0xae, 0x3c, 0x06, 0x55, 0xc5,
+    0x25, 0x05, 0x36, 0x29, 0x64, 0xd9, 0x9c, 0x4e, 0x1d, 0x10, 0xc8, 0xab, 0x2a, 0x2b, 0x66, 0xa0,
+    0x04, 0xda, 0xc7, 0x37, 0x9b, 0x2c, 0xc7, 0x5c, 0xef, 0x0f, 0x0f, 0xdf, 0xd9, 0x1b, 0x2b, 0xd5,
+    0x31, 0x32, 0xe2, 0x97, 0x90, 0xd8, 0x4d, 0xa9, 0x74, 0xcd, 0x75, 0x84, 0xd0, 0x9e, 0xe1, 0x72,
+    0xa9, 0xea, 0x93, 0xeb, 0x75, 0x00, 0xdd, 0x0a, 0xb9, 0x63, 0x6b, 0xca, 0x53, 0x42, 0x75, 0x68,
+    0xb5, 0x9a, 0x24, 0x26, 0x7b, 0x01, 0xfd, 0x48, 0x44, 0x96, 0xb4, 0x50, 0xa9, 0x5e, 0xe9, 0x33,
+    0x46, 0x8d, 0x3b, 0xb4, 0x51, 0xd4, 0x58, 0xb2, 0x19, 0x8f, 0x3f, 0x92, 0x38, 0x67, 0xe6, 0x64,
+    0x2c, 0x1f, 0xa2, 0x49, 0xac, 0x98, 0x01, 0x69, 0x22, 0xc3, 0xb5, 0x68, 0x5c, 0x33, 0x1d, 0x07,
+    0x2c, 0xee, 0xea, 0xd5, 0xc2, 0x8c, 0x3d, 0x9c, 0x76, 0xac, 0xe9, 0xf9, 0x91, 0x92, 0x40, 0x2f,
+    0x5a, 0x19, 0x09, 0xdc, 0x69, 0x76, 0x8c, 0xa8, 0x72, 0x4d, 0xf0, 0xcf, 0xc9, 0x58, 0xd1, 0x9c,
+    0xa2, 0x0a, 0x6b, 0x38, 0xfe, 0x66, 0x84, 0x8a, 0x47, 0x25, 0xb7, 0xaf, 0x9c, 0x4b, 0x8a, 0x18,
+    0xa1, 0xae, 0x1d, 0xb5, 0x24, 0x1d, 0x8f, 0x2c, 0xd9, 0x8e, 0x2e, 0xdd, 0x85, 0xa7, 0xb5, 0x6a,
+    0xc0, 0x35, 0x5c, 0x32, 0xaa, 0x17, 0x35, 0x5b, 0xa4, 0x90, 0x36, 0xd9, 0x93, 0xef, 0x27, 0x41,
+    0x75, 0xa8, 0x7b, 0x92, 0x87, 0x63, 0x54, 0x81, 0x9b, 0x3f, 0x48, 0x81, 0x0a, 0x75, 0xe9, 0x4d,
+    0xc8, 0x26, 0x08, 0xc1, 0x1f, 0x15, 0x24, 0x29, 0x07, 0x10, 0x12, 0x63, 0x07, 0x38, 0x46, 0xaf,
+    0xa2, 0xb6, 0xdd, 0x8e, 0x3d, 0xa5, 0xeb, 0x30, 0x18, 0x26, 0xab, 0xf6, 0x61, 0xc3, 0x6e, 0x6b,
+    0x4c, 0xb6, 0x70, 0xb2, 0x7c, 0x56, 0x9e, 0x96, 0x96, 0x1f, 0x18, 0x69, 0xa8, 0xc5, 0x84, 0x12,
+    0x15, 0x9e, 0xe7, 0x35, 0x59, 0xee, 0x01, 0x5f, 0xed, 0x4a, 0x9c, 0x6a, 0x10, 0xd7, 0xb8, 0x17,
+    0x2f, 0x3c, 0x94, 0xbe, 0xd5, 0xa2, 0xa6, 0x2d, 0xf4, 0xc6, 0xd3, 0x1c, 0x10, 0xb5, 0x1c, 0x95,
+    0xee, 0xa7, 0x41, 0x62, 0x05, 0xcd, 0x47, 0x0e, 0xf6, 0x91, 0x9a, 0x8e, 0x1a, 0x61, 0x57, 0x6c,
+    0x10, 0x12, 0xd9, 0x3d, 0x26, 0x44, 0x6b, 0xc5, 0x92, 0x46, 0x2f, 0x5d, 0x63, 0x2d, 0x8c, 0x58,
+    0x67, 0x1d, 0xd4, 0xe9, 0xa1, 0xe4, 0xfd, 0x8a, 0xc5, 0x94, 0xda, 0x7f, 0xa0, 0x34, 0x97, 0xc2,
+    0x65, 0xaf, 0xaa, 0xc3, 0x3e, 0x74, 0x93, 0xf3, 0xfc, 0x72, 0x1f, 0x68, 0x3d, 0xeb, 0xe3, 0x53,
+    0xaa, 0xc9, 0x8e, 0x93, 0x0d, 0x4f, 0x23, 0x75, 0x11, 0x0e, 0xc0, 0x2c, 0x02, 0xf0, 0x2d, 0xa7,
+    0x01, 0xfd, 0x56, 0xed, 0x98, 0x85, 0x72, 0xea, 0x41, 0x13, 0x60, 0xae, 0x59, 0x16, 0x7a, 0x1c,
+    0xc2, 0x1c, 0x19, 0x09, 0x17, 0xf6, 0xe2, 0xef, 0xda, 0xd2, 0x9f, 0x8d, 0xa3, 0xf0, 0x75, 0xdd,
+    0xfa, 0xfe, 0x2a, 0xdc, 0xfa, 0x8e, 0x70, 0xc5, 0xac, 0x9b, 0x90, 0x8e, 0x1d, 0xc2, 0xb3, 0x7b,
+    0x30, 0xfa, 0x5b, 0x70, 0xc2, 0x81, 0xb3, 0x03, 0x4b, 0x67, 0xcf, 0xf9, 0x3a, 0x87, 0x3b, 0x26,
+    0x99, 0x3d, 0xf1, 0xa5, 0xfb, 0x2c, 0x64, 0x87, 0x42, 0x5a, 0x7f, 0xa8, 0x50, 0x59, 0xa1, 0xa4,
+    0x71, 0xfe, 0x76, 0xfe, 0xb2, 0xea, 0x7c, 0xe8, 0x37, 0x57, 0xf9, 0xca, 0xca, 0x7d, 0x47, 0xaf,
+    0x9a, 0xbe, 0xe9, 0xe9, 0x07, 0xce, 0x84, 0xbe, 0x94, 0x8e, 0xe7, 0x47, 0x62, 0xb3, 0x4f, 0xff,
+    0x9b, 0xdd, 0xe5, 0x76, 0xff, 0x23, 0x37, 0x0c, 0x9b, 0xb4, 0xa1, 0xb8, 0x51, 0x09, 0x3f, 0x73,
+    0x2e, 0x4d, 0xc6, 0xa3, 0x16, 0xc8, 0xf6, 0x44, 0x13, 0xf4, 0x93, 0x80, 0x17, 0x8b, 0xcc, 0x3d,
+    0xdd, 0xf7, 0xcf, 0x8c, 0x2e, 0x92, 0x24, 0xf1, 0x66, 0xea, 0xb0, 0x08, 0xe6, 0xfb, 0xab, 0xf3,
+    0xb3, 0xdb, 0x29, 0x53, 0x9c, 0x47, 0x05, 0x4e, 0xf8, 0x96, 0xdf, 0xcc, 0x24, 0x77, 0x0b, 0x2e,
+    0x72, 0xd2, 0x18, 0x74, 0xe1, 0x37, 0x72, 0xf9, 0xd3, 0xba, 0xa7, 0x16, 0xdd, 0x0e, 0x97, 0x37,
+    0x56, 0x87, 0xbb, 0x6c, 0xd5, 0xe1, 0x33, 0x99, 0x79, 0x07, 0x3e, 0xef, 0x6e, 0x41, 0xdc, 0x5f,
+    0xa0, 0x85, 0xb1, 0x60, 0x27, 0x67, 0x1d, 0xf4, 0x4d, 0xc7, 0x45, 0xdb, 0xd1, 0xbf, 0x45, 0x9c,
+    0xf3, 0xe1, 0x0f, 0x23, 0xe0, 0xfd, 0xbc, 0x67, 0x4e, 0x1e, 0x04, 0x9d, 0xf3, 0xfe, 0x06, 0x5e,
+    0x63, 0x48, 0xb7, 0x67, 0x07, 0x00, 0x00,
+};
+
+// index.html: 1564 bytes, 610 gzipped
+static const uint8_t WEB_INDEX_HTML[] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xa5, 0x55, 0xcd, 0x6e, 0xdb, 0x30,
+    0x0c, 0xbe, 0xe7, 0x29, 0x34, 0x5d, 0xb7, 0xd4, 0x4b, 0xda, 0xad, 0x05, 0x26, 0x7b, 0xd8, 0xdf,
+    0xb1, 0x58, 0xd1, 0x0e, 0x03, 0x76, 0x94, 0x25, 0x26, 0xd6, 0x2a, 0x4b, 0x86, 0x44, 0xa7, 0xc8,
+    0xad, 0xef, 0xb0, 0x77, 0xd8, 0x83, 0xf5, 0x49, 0x46, 0x59, 0x71, 0x52, 0x34, 0x29, 0x90, 0x6d,
+    0x27, 0xd9, 0x1f, 0xc9, 0x8f, 0xe4, 0x47, 0x99, 0x16, 0x2f, 0x3e, 0x7f, 0xfd, 0xf4, 0xed, 0xc7,
+    0xd5, 0x17, 0xd6, 0x60, 0x6b, 0xab, 0x89, 0x48, 0x07, 0xb3, 0xd2, 0x2d, 0x4b, 0x0e, 0x8e, 0x27,
+    0x00, 0xa4, 0xa6, 0xa3, 0x05, 0x94, 0x4c, 0x35, 0x32, 0x44, 0xc0, 0x92, 0xf7, 0xb8, 0x98, 0x5e,
+    0xf0, 0x11, 0x76, 0xb2, 0x85, 0x92, 0xaf, 0x0c, 0xdc, 0x75, 0x3e, 0x20, 0x67, 0xca, 0x3b, 0x04,
+    0x47, 0x6e, 0x77, 0x46, 0x63, 0x53, 0x6a, 0x58, 0x19, 0x05, 0xd3, 0xe1, 0xe5, 0x15, 0x33, 0xce,
+    0xa0, 0x91, 0x76, 0x1a, 0x95, 0xb4, 0x50, 0xce, 0x12, 0x09, 0x1a, 0xb4, 0x50, 0x7d, 0x07, 0xeb,
+    0x95, 0xc1, 0x35, 0xbb, 0x41, 0xa9, 0x6e, 0x45, 0x91, 0xd1, 0x89, 0xb0, 0xc6, 0xdd, 0xb2, 0x00,
+    0xb6, 0xe4, 0x11, 0xd7, 0x16, 0x62, 0x03, 0x40, 0x39, 0x9a, 0x00, 0x8b, 0x92, 0x17, 0x03, 0x74,
+    0xa2, 0x62, 0x7c, 0xbf, 0x2a, 0x17, 0x70, 0x71, 0xb6, 0x38, 0x7b, 0xa3, 0xd5, 0xf9, 0xeb, 0xf9,
+    0xe9, 0x7c, 0xa1, 0x13, 0x75, 0xb1, 0x29, 0xbf, 0xf6, 0x7a, 0xbd, 0x69, 0x06, 0x42, 0x35, 0x61,
+    0x4c, 0x34, 0xb3, 0xbd, 0x8c, 0x04, 0x25, 0x4b, 0xec, 0xa4, 0x63, 0x46, 0x97, 0x3c, 0x65, 0xa6,
+    0x6e, 0xac, 0x8c, 0xb1, 0xe4, 0xb5, 0xd4, 0x4b, 0xe0, 0x15, 0xf5, 0xe6, 0x40, 0xa1, 0x71, 0xcb,
+    0x87, 0xfb, 0xdf, 0xa2, 0x48, 0xbe, 0x63, 0x9a, 0x44, 0x4c, 0x8a, 0x48, 0xe3, 0x32, 0x4d, 0x72,
+    0xf3, 0x6e, 0x8c, 0x57, 0x32, 0x68, 0x66, 0xcd, 0x8a, 0x38, 0xc8, 0x4a, 0x76, 0x6d, 0x56, 0x95,
+    0xb0, 0xb2, 0x06, 0x5b, 0x5d, 0x5f, 0x5d, 0x8a, 0x22, 0x3f, 0x0a, 0xdf, 0x63, 0xd7, 0xe3, 0x90,
+    0x3f, 0x74, 0x2d, 0xaf, 0x1e, 0xee, 0x7f, 0x89, 0x22, 0x83, 0x95, 0x28, 0x52, 0xd0, 0x5e, 0xf8,
+    0xa5, 0xd7, 0x70, 0x28, 0xbe, 0x25, 0xfc, 0x28, 0x82, 0x1b, 0x08, 0x2b, 0xcf, 0x50, 0x86, 0x25,
+    0xe0, 0x21, 0xa2, 0x6c, 0xf9, 0x0b, 0x2a, 0xa9, 0xb0, 0x97, 0xf6, 0x10, 0x55, 0xb6, 0x1c, 0x47,
+    0x85, 0x12, 0x0f, 0xf6, 0x15, 0x93, 0xe1, 0x19, 0x0a, 0x1a, 0x49, 0xd6, 0x9d, 0x66, 0x71, 0x78,
+    0x08, 0xa3, 0xfe, 0xcd, 0x3c, 0xe9, 0xce, 0x02, 0xdd, 0x75, 0x88, 0x34, 0xc1, 0xf9, 0x06, 0xef,
+    0x46, 0xe7, 0xc6, 0x38, 0xea, 0xf9, 0xa3, 0xef, 0x9d, 0x96, 0xc1, 0x40, 0x64, 0x35, 0xe0, 0x1d,
+    0x80, 0x63, 0x49, 0xd7, 0xf8, 0x6e, 0x38, 0x98, 0x63, 0xa1, 0x77, 0x91, 0x2d, 0x82, 0x6f, 0x59,
+    0x9d, 0x5d, 0xd7, 0x04, 0xa2, 0x67, 0xee, 0xe5, 0xec, 0x44, 0x14, 0xdd, 0xae, 0xaf, 0x3c, 0xd3,
+    0x21, 0xdd, 0xf6, 0x56, 0x2d, 0x83, 0xa1, 0x82, 0x9e, 0x08, 0x30, 0x1a, 0xe5, 0x50, 0x7b, 0xdc,
+    0x14, 0x4c, 0xb6, 0xba, 0x47, 0xf4, 0x6e, 0xc7, 0x33, 0x95, 0x5a, 0x73, 0x86, 0xeb, 0x8e, 0x3e,
+    0xbf, 0x6c, 0xe3, 0xd5, 0x07, 0xad, 0x87, 0xca, 0x44, 0x91, 0x91, 0xe7, 0x83, 0x03, 0xb4, 0x9e,
+    0xae, 0xe3, 0x93, 0xf8, 0xeb, 0x01, 0x3d, 0x8e, 0x22, 0x4e, 0xa3, 0xdc, 0x63, 0x18, 0xab, 0xef,
+    0x82, 0x69, 0x49, 0x0c, 0x5e, 0xdd, 0x90, 0xcf, 0x56, 0xe6, 0xc7, 0x8c, 0xff, 0x36, 0xb4, 0x7c,
+    0xc3, 0x3a, 0x1f, 0xcd, 0xa0, 0xce, 0xb3, 0x93, 0x1b, 0xca, 0xdc, 0xba, 0x4d, 0xf3, 0x34, 0xf7,
+    0x07, 0xb2, 0xf5, 0xf8, 0xff, 0x99, 0xec, 0x92, 0x1d, 0x2d, 0xcb, 0xa3, 0x36, 0x8e, 0x51, 0xa6,
+    0xdb, 0xde, 0xff, 0x9e, 0xea, 0x0d, 0x9e, 0x36, 0xe8, 0xf8, 0x96, 0x5b, 0x13, 0x45, 0xde, 0x3f,
+    0x13, 0x11, 0x55, 0x30, 0x1d, 0xb2, 0x18, 0x14, 0xad, 0x49, 0xd9, 0x75, 0x27, 0x3f, 0xd3, 0x8e,
+    0x3c, 0x9f, 0xe9, 0xd3, 0x7a, 0xfe, 0x56, 0xd5, 0x17, 0x12, 0x66, 0xe7, 0xb5, 0x4a, 0x61, 0xd9,
+    0x33, 0xc5, 0x6e, 0xb6, 0x64, 0x91, 0xff, 0x05, 0x7f, 0x00, 0x58, 0xde, 0x83, 0x56, 0x1c, 0x06,
+    0x00, 0x00,
+};
+
+static const WebAsset WEB_ASSETS[] = {
+    { "/app.js", "application/javascript", WEB_APP_JS, sizeof(WEB_APP_JS), "\"71d3b26cb8ae17bc\"", true },
+    { "/style.css", "text/css", WEB_STYLE_CSS, sizeof(WEB_STYLE_CSS), "\"fe84f45dc70232fd\"", true },
+    { "/", "text/html", WEB_INDEX_HTML, sizeof(WEB_INDEX_HTML), "\"d77adba725dca47e\"", false },
+};
+
+#define WEB_ASSET_COUNT (sizeof(WEB_ASSETS) / sizeof(WEB_ASSETS[0]))
+
+#endif  // WEB_ASSETS_H
@@ -16,15 +16,63 @@ extern "C" {
 #endif
 
 
+// === HTTP server task ===
+// Requests are served by their own FreeRTOS task, below the control
+// task and the telemetry poller, so a slow client or a long handler can
+// never delay a servo command. One connection is handled at a time;
+// WebServer gives up on a client that stalls while sending its request
+// (HTTP_MAX_DATA_WAIT). Handlers that walk through modes get their
+// deadline scaled to the walk (2 s per mode on top of
+// HTTP_REQUEST_TIMEOUT_MS); past it they answer 504 with the partial path.
+#define HTTP_TASK_PRIORITY 1
+#define HTTP_POLL_MS 2
+#define HTTP_REQUEST_TIMEOUT_MS 10000
+#define HTTP_MAX_ROUTES 24
+
+// === Radio task ===
+// enableWiFi()/disableWiFi() only post a request and return; the radio
+// task does the slow driver work afterwards. A state change (e.g. into
+// RACE) therefore finishes its servo setup without waiting on the
+// radio. Only the newest request is kept, so quick toggles collapse
+// into one transition. Routes and the HTTP task are set up once in
+// initWiFi(); turning off stops the radio but keeps the AP
+// configuration, so turning on again is just a restart of the driver.
+// Before stopping the driver the radio task waits, at most
+// RADIO_HTTP_STOP_TIMEOUT_MS, for the HTTP task to close the server.
+#define RADIO_TASK_PRIORITY 1
+#define RADIO_HTTP_STOP_TIMEOUT_MS (HTTP_REQUEST_TIMEOUT_MS + 1000)
+
+struct RadioTransitionStats {
+  uint32_t count;
+  uint32_t lastUs;     // Request to radio ready (or off), including queueing
+  uint32_t maxUs;
+  uint32_t lastWorkUs; // Time spent in the driver calls alone
+};
+
+struct HttpRouteStats {
+  const char* path;
+  uint32_t count;
+  uint32_t timeouts;   // Requests that ran past their deadline
+  uint32_t lastUs;
+  uint32_t maxUs;
+  float avgUs;
+};
+
 extern WebServer server;
 extern IPAddress espAPIP;  // Global declaration of the Access Point IP
 
 extern const char* ssid;
 extern const char* password;
 
-void startWiFi();
+// Registers routes and starts the HTTP and radio tasks (radio stays off)
+void initWiFi();
 void enableWiFi();
 void disableWiFi();
+bool isWiFiOn();  // Radio state after the last finished transition
+
+// 'on' selects turn-on or turn-off transitions
+void getRadioTransitionStats(bool on, RadioTransitionStats& out);
+void printRadioStats();
 
 void handleRPMData();
 void handleRanges();
@@ -34,6 +82,22 @@ void handleTestResult();
 void handleTestCheck();
 void sendCurrentMode();
 void handleSync();
+void handleServoTelemetry();
+void handleServoLatency();
+void handleActuators();
+void handlePerf();
+void handleHttpStats();
+void handleHistory();
+void handlePositions();
+void handleConfig();
+void handleState();
+void handleWebAsset();
+
+// Request latency per registered route; false past the last route
+bool getHttpRouteStats(int index, HttpRouteStats& out);
+void resetHttpStats();
+void printHttpStats();
+
 IPAddress getIpAddress();
 void listConnectedClients();
 void showTxPower();
@@ -6,8 +6,6 @@
 #include "nvs.h"
 #include "esp_wifi.h"
 
-#include <SCServo.h> 
-
 // include rpm data file
 #include "include/rpm_data.h"
 
@@ -15,8 +13,14 @@
 #include "include/nvs_utils.h"
 #include "include/rpm.h"
 #include "include/servo.h"
+#include "include/servo_telemetry.h"
+#include "include/control.h"
 #include "include/state.h"
 #include "include/pin_utils.h"
+#include "include/history.h"
+#include "include/udp_telemetry.h"
+#include "include/wifi_utils.h"
+#include "include/boot.h"
 
 
 
@@ -86,50 +90,84 @@ void IRAM_ATTR handleStatusInterrupt() {
 // }
 
 
+// Boot runs in two stages (see boot.h). Nothing here waits for a USB
+// host: on a bike there is none, and messages from before one attaches
+// are simply lost ("boot" shows the timeline later).
 void setup() { 
   Serial.begin(115200);
+#if ARDUINO_USB_CDC_ON_BOOT
+  Serial.setTxTimeoutMs(0);  // Drop output instead of stalling without a host
+#endif
+  markBootPhase(BOOT_SETUP);
   gpio_install_isr_service(0); 
-  while (!Serial) delay(10); // <-- For ESP32-C3 USB Serial
-  delay(500);
-  // NVS Initialization
+
+  // ===== Stage 1: race-critical =====
+
+  // Servo bus lock: stored pins in NVS reconfigure the UART under it
+  servoBusInit();
+
+  // NVS Initialization (ranges, positions, profiles, pins)
   initNVS();
+  markBootPhase(BOOT_CONFIG);
+
+  // Servo bus on the stored pins, servo homed
+  servo_bootInit();
 
-  // Servo Initialization
-  servo_defaultInit();
+  // RPM Sensor Pin Initialization
+  initRpmSensorInterrupt();
+  markBootPhase(BOOT_RPM_ISR);
+
+  // Fixed-rate servo control task
+  initControlLoop();
+  markBootPhase(BOOT_CONTROL);
+
+  // Init State: enters RACE, servo follows RPM from here on
+  initState();
 
   // Mode Switch Button Initialization
   initModeButtonInterrupt();
 
-  // Init State
-  initState();
+  // ===== Stage 2: diagnostics, deferred =====
 
-  // RPM Sensor Pin Initialization
-  initRpmSensorInterrupt();
+  // Servo Telemetry Poller
+  initServoTelemetry();
+
+  // Sample history for /history
+  initHistory();
+
+  // Pit-side UDP telemetry (diagnostics mode only)
+  initUdpTelemetry();
+
+  // HTTP routes and the radio task; the radio itself stays off
+  initWiFi();
 
   // Mark Pin Initialization
   initMarkPin();
 
+  // CLI command index
+  initCLI();
+
   // button initialization
   pinMode(STATUS_BUTTON, INPUT_PULLUP);  
 
   attachInterrupt(digitalPinToInterrupt(STATUS_BUTTON), handleStatusInterrupt, FALLING);
 
-
+  markBootPhase(BOOT_DEFERRED);
+  printBootTimeline();
 }
 
 
 
 
+// Servo following runs in the control task (see control.h); loop() only
+// carries the low-priority housekeeping
 void loop() {
   
   handleCLI();
   
   changeStatus();
-
-  // Check servo update every 200 ms
-  updateServoIfFollowing();
   
   toggleMovementPin();
 
-  delay(50);
+  delay(10);
 }
@@ -0,0 +1,251 @@
+#include <Arduino.h>
+#include "../include/actuators.h"
+#include "../include/servo.h"
+#include "../include/nvs_utils.h"
+#include "../include/move_tracker.h"
+#include "../include/boot.h"
+
+// Actuator 0 is the original servo from the start, so servo writes
+// address SERVO_ID even when NVS cannot be read
+Actuator actuators[MAX_ACTUATORS] = { { (uint8_t)SERVO_ID } };
+int32_t actuatorCount = 1;
+
+// === Group move skew tracking ===
+struct GroupMove {
+    bool active;
+    uint32_t commandUs;
+    int16_t target[MAX_ACTUATORS];
+    bool arrived[MAX_ACTUATORS];
+    uint32_t arrivalUs[MAX_ACTUATORS];
+};
+
+static portMUX_TYPE groupMux = portMUX_INITIALIZER_UNLOCKED;
+static GroupMove groupMove = {};
+
+static uint32_t skewCount = 0;
+static uint32_t skewTimeouts = 0;
+static uint32_t lastSkewUs = 0;
+static uint32_t minSkewUs = UINT32_MAX;
+static uint32_t maxSkewUs = 0;
+static uint64_t sumSkewUs = 0;
+
+void setDefaultActuators() {
+    memset(actuators, 0, sizeof(actuators));
+    actuatorCount = 1;
+    actuators[0].id = SERVO_ID;
+}
+
+int getActuatorCount() {
+    return actuatorCount;
+}
+
+int getActuatorId(int index) {
+    if (index < 0 || index >= actuatorCount) return -1;
+    return actuators[index].id;
+}
+
+int getActuatorModePosition(int index, int mode) {
+    if (index < 0 || index >= actuatorCount || mode < 1 || mode > numRanges) return -1;
+
+    int base = (index == 0) ? modeServoPositions[mode - 1] : actuators[index].modePositions[mode - 1];
+    return constrain(base + actuators[index].offset, 0, 4095);
+}
+
+int addActuator(uint8_t id) {
+    if (actuatorCount >= MAX_ACTUATORS || id >= STS_BROADCAST_ID) return -1;
+    for (int i = 0; i < actuatorCount; ++i) {
+        if (actuators[i].id == id) return -1;
+    }
+
+    // New stacks start as copies of the original one
+    Actuator& a = actuators[actuatorCount];
+    a.id = id;
+    a.offset = 0;
+    a.rackLength = getRackLength();
+    a.pinionRadius = getPinionRadius();
+    for (int m = 0; m < MOTION_MAX_MODES; ++m) {
+        a.modePositions[m] = modeServoPositions[m];
+    }
+    return actuatorCount++;
+}
+
+bool removeActuator(int index) {
+    if (index <= 0 || index >= actuatorCount) return false;
+    for (int i = index; i < actuatorCount - 1; ++i) {
+        actuators[i] = actuators[i + 1];
+    }
+    actuatorCount--;
+    return true;
+}
+
+bool setActuatorParam(int index, const char* name, float value) {
+    if (index < 0 || index >= actuatorCount) return false;
+    Actuator& a = actuators[index];
+
+    if (strcmp(name, "id") == 0) {
+        int id = (int)value;
+        if (id < 0 || id >= STS_BROADCAST_ID) return false;
+        for (int i = 0; i < actuatorCount; ++i) {
+            if (i != index && actuators[i].id == id) return false;
+        }
+        a.id = id;
+    } else if (strcmp(name, "offset") == 0) {
+        if (value < -4095 || value > 4095) return false;
+        a.offset = (int16_t)value;
+    } else if (strcmp(name, "rack") == 0 && value > 0) {
+        if (index == 0) setRackLength(value);
+        else a.rackLength = value;
+    } else if (strcmp(name, "pinion") == 0 && value > 0) {
+        if (index == 0) setPinionRadius(value);
+        else a.pinionRadius = value;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool setActuatorModePosition(int index, int mode, int position) {
+    if (index < 0 || index >= actuatorCount || mode < 1 || mode > numRanges) return false;
+    if (position < 0 || position > 4095) return false;
+
+    if (index == 0) modeServoPositions[mode - 1] = position;
+    else actuators[index].modePositions[mode - 1] = position;
+    return true;
+}
+
+void generateActuatorPositions(int index, int steps) {
+    if (index == 0) {
+        generateServoPositions(steps);
+        return;
+    }
+    if (index < 0 || index >= actuatorCount || steps < 2 || steps > MOTION_MAX_MODES) return;
+
+    Actuator& a = actuators[index];
+    float maxDegrees = min((a.rackLength / (2 * PI * a.pinionRadius)) * 360.0, 360.0);
+    for (int i = 0; i < steps; ++i) {
+        float degrees = (i * maxDegrees) / (steps - 1);
+        a.modePositions[i] = degreesToPos(degrees);
+    }
+}
+
+void generateAllActuatorPositions(int steps) {
+    generateServoPositions(steps);
+    for (int i = 1; i < actuatorCount; ++i) generateActuatorPositions(i, steps);
+    if (actuatorCount > 1) storeActuators();
+}
+
+bool moveActuatorGroup(int mode, uint16_t speed, uint8_t acc) {
+    uint8_t ids[MAX_ACTUATORS];
+    int16_t positions[MAX_ACTUATORS];
+    uint16_t speeds[MAX_ACTUATORS];
+    uint8_t accs[MAX_ACTUATORS];
+
+    int count = actuatorCount;
+    for (int i = 0; i < count; ++i) {
+        ids[i] = actuators[i].id;
+        positions[i] = getActuatorModePosition(i, mode);
+        speeds[i] = speed;
+        accs[i] = acc;
+        if (positions[i] < 0) return false;
+    }
+
+    if (!servoBusLock()) return false;
+    StsStatus status = stsBus.syncWritePosEx(ids, count, positions, speeds, accs);
+    uint32_t now = micros();
+    servoBusUnlock();
+
+    if (status != StsStatus::OK) return false;
+    markBootPhase(BOOT_FIRST_SERVO_CMD);
+
+    portENTER_CRITICAL(&groupMux);
+    if (groupMove.active) skewTimeouts++;  // Superseded before every stack arrived
+    groupMove.active = true;
+    groupMove.commandUs = now;
+    for (int i = 0; i < count; ++i) {
+        groupMove.target[i] = positions[i];
+        groupMove.arrived[i] = false;
+    }
+    portEXIT_CRITICAL(&groupMux);
+    return true;
+}
+
+void updateGroupSkew(int index, int position, bool moving, uint32_t timestampUs) {
+    portENTER_CRITICAL(&groupMux);
+    GroupMove& g = groupMove;
+    if (!g.active || index >= actuatorCount || g.arrived[index] ||
+        (int32_t)(timestampUs - g.commandUs) <= 0) {
+        portEXIT_CRITICAL(&groupMux);
+        return;
+    }
+
+    if (abs(position - g.target[index]) <= MOTION_TOLERANCE && !moving) {
+        g.arrived[index] = true;
+        g.arrivalUs[index] = timestampUs;
+    } else if (timestampUs - g.commandUs > MOVE_TIMEOUT_MS * 1000UL) {
+        skewTimeouts++;
+        g.active = false;
+        portEXIT_CRITICAL(&groupMux);
+        return;
+    }
+
+    uint32_t first = UINT32_MAX, last = 0;
+    for (int i = 0; i < actuatorCount; ++i) {
+        if (!g.arrived[i]) {
+            portEXIT_CRITICAL(&groupMux);
+            return;
+        }
+        uint32_t t = g.arrivalUs[i] - g.commandUs;
+        first = min(first, t);
+        last = max(last, t);
+    }
+
+    // Every stack is in position
+    g.active = false;
+    lastSkewUs = last - first;
+    minSkewUs = min(minSkewUs, lastSkewUs);
+    maxSkewUs = max(maxSkewUs, lastSkewUs);
+    sumSkewUs += lastSkewUs;
+    skewCount++;
+    portEXIT_CRITICAL(&groupMux);
+}
+
+void printActuators() {
+    Serial.printf("🦾 Actuators (%d)\n", actuatorCount);
+    for (int i = 0; i < actuatorCount; ++i) {
+        const Actuator& a = actuators[i];
+        float rack = (i == 0) ? getRackLength() : a.rackLength;
+        float pinion = (i == 0) ? getPinionRadius() : a.pinionRadius;
+        Serial.printf("  [%d] ID %3u  offset %+5d  rack %.1f mm  pinion %.1f mm\n",
+                      i, a.id, a.offset, rack, pinion);
+        Serial.print("      positions:");
+        for (int m = 1; m <= numRanges; ++m) {
+            Serial.printf(" %d", getActuatorModePosition(i, m));
+        }
+        Serial.println();
+    }
+}
+
+void getActuatorSkew(SkewSummary& out) {
+    portENTER_CRITICAL(&groupMux);
+    out.count = skewCount;
+    out.timeouts = skewTimeouts;
+    out.lastMs = lastSkewUs / 1000.0f;
+    out.minMs = skewCount ? minSkewUs / 1000.0f : 0;
+    out.avgMs = skewCount ? sumSkewUs / 1000.0f / skewCount : 0;
+    out.maxMs = maxSkewUs / 1000.0f;
+    portEXIT_CRITICAL(&groupMux);
+}
+
+void printActuatorSkew() {
+    SkewSummary s;
+    getActuatorSkew(s);
+
+    Serial.println("⚖️ Group arrival skew (first → last stack in position)");
+    if (s.count == 0) {
+        Serial.printf("  No completed group moves yet (%lu timeouts)\n", (unsigned long)s.timeouts);
+        return;
+    }
+    Serial.printf("  Moves: %lu, timeouts/superseded: %lu\n", (unsigned long)s.count, (unsigned long)s.timeouts);
+    Serial.printf("  Last: %.1f ms  Min: %.1f ms  Avg: %.1f ms  Max: %.1f ms\n",
+                  s.lastMs, s.minMs, s.avgMs, s.maxMs);
+}
@@ -0,0 +1,47 @@
+#include <Arduino.h>
+#include "../include/boot.h"
+
+static uint32_t phaseUs[BOOT_PHASE_COUNT] = {};
+
+static const char* const BOOT_PHASE_NAMES[BOOT_PHASE_COUNT] = {
+    "setup",
+    "config",
+    "servo_bus",
+    "rpm_isr",
+    "control",
+    "follow_armed",
+    "first_follow",
+    "first_servo_cmd",
+    "deferred",
+};
+
+void markBootPhase(BootPhase phase) {
+    if (phaseUs[phase] != 0) return;
+    uint32_t now = micros();
+    phaseUs[phase] = now ? now : 1;  // 0 means "not reached"
+}
+
+uint32_t getBootPhaseUs(BootPhase phase) {
+    return phaseUs[phase];
+}
+
+const char* getBootPhaseName(BootPhase phase) {
+    return BOOT_PHASE_NAMES[phase];
+}
+
+void printBootTimeline() {
+    Serial.println("🚀 Boot timeline (ms since reset)");
+    uint32_t previous = 0;
+    for (int p = 0; p < BOOT_PHASE_COUNT; ++p) {
+        uint32_t us = phaseUs[p];
+        if (us == 0) {
+            Serial.printf("  %-16s        —\n", BOOT_PHASE_NAMES[p]);
+            continue;
+        }
+        // Delta to the previous phase reached; the servo command can
+        // land in any order relative to the phases around it
+        Serial.printf("  %-16s %8.1f  (+%.1f)\n", BOOT_PHASE_NAMES[p], us / 1000.0,
+                      us > previous ? (us - previous) / 1000.0 : 0.0);
+        previous = max(previous, us);
+    }
+}
@@ -0,0 +1,164 @@
+#include <Arduino.h>
+#include "../include/calibration.h"
+#include "../include/servo.h"
+#include "../include/servo_telemetry.h"
+#include "../include/motion.h"
+#include "../include/nvs_utils.h"
+
+int32_t servoMinPos = -1;
+int32_t servoMaxPos = -1;
+
+// Anything shorter is a failed run rather than a real mechanism
+#define CAL_MIN_TRAVEL 100
+
+enum class ApproachResult {
+    CONTACT,    // Load or stall detected before the goal
+    REACHED,    // Got to the end of the servo range without touching anything
+    TIMEOUT,
+    ABORTED,
+    BUS_ERROR
+};
+
+bool servoLimitsCalibrated() {
+    return servoMinPos >= 0 && servoMaxPos > servoMinPos;
+}
+
+int getServoMinUsable() {
+    return servoLimitsCalibrated() ? servoMinPos + CAL_MARGIN : 0;
+}
+
+int getServoMaxUsable() {
+    return servoLimitsCalibrated() ? servoMaxPos - CAL_MARGIN : 4095;
+}
+
+void clearServoLimits() {
+    servoMinPos = -1;
+    servoMaxPos = -1;
+}
+
+// Creeps towards 'goal' and stops the servo the moment it touches
+// something. The goal is the end of the servo range, so every real end
+// stop is met on the way.
+static ApproachResult approachStop(int goal, int& stopPos) {
+    ServoTelemetry t;
+    getServoTelemetry(t);
+    uint32_t lastSeen = t.sampleCount;
+    stopPos = t.position;
+
+    int loadSamples = 0;
+    int progressPos = t.position;
+    uint32_t start = millis();
+    uint32_t progressMs = start;
+
+    if (servoWritePosEx(goal, CAL_SPEED, CAL_ACC) != StsStatus::OK) return ApproachResult::BUS_ERROR;
+
+    while (millis() - start < CAL_TIMEOUT_MS) {
+        if (Serial.available()) {
+            servoWritePosEx(stopPos, CAL_SPEED, 0);
+            return ApproachResult::ABORTED;
+        }
+
+        getServoTelemetry(t);
+        if (!t.valid || t.sampleCount == lastSeen || (int32_t)(t.timestampMs - start) < 0) {
+            delay(2);
+            continue;
+        }
+        lastSeen = t.sampleCount;
+        stopPos = t.position;
+
+        if (abs(t.position - goal) <= MOTION_TOLERANCE) return ApproachResult::REACHED;
+
+        loadSamples = (abs(t.load) >= CAL_LOAD_LIMIT) ? loadSamples + 1 : 0;
+        if (abs(t.position - progressPos) > CAL_STALL_STEPS) {
+            progressPos = t.position;
+            progressMs = t.timestampMs;
+        }
+        bool stalled = t.timestampMs - progressMs >= CAL_STALL_MS;
+
+        if (loadSamples >= CAL_LOAD_SAMPLES || stalled) {
+            // Hold where it touched so the servo stops pushing
+            servoWritePosEx(t.position, CAL_SPEED, 0);
+            Serial.printf("  Contact at %d (load %.1f%%%s)\n",
+                          t.position, t.load / 10.0, stalled ? ", stalled" : "");
+            return ApproachResult::CONTACT;
+        }
+    }
+
+    servoWritePosEx(stopPos, CAL_SPEED, 0);
+    return ApproachResult::TIMEOUT;
+}
+
+static bool findStop(const char* name, int goal, int& stopPos) {
+    Serial.printf("  Approaching %s end stop...\n", name);
+    switch (approachStop(goal, stopPos)) {
+        case ApproachResult::CONTACT:
+            return true;
+        case ApproachResult::REACHED:
+            Serial.printf("  No contact before the end of the servo range, using %d\n", stopPos);
+            return true;
+        case ApproachResult::TIMEOUT:
+            Serial.println("❌ Timed out before reaching an end stop.");
+            return false;
+        case ApproachResult::ABORTED:
+            while (Serial.available()) Serial.read();
+            Serial.println("❎ Calibration aborted.");
+            return false;
+        default:
+            Serial.println("❌ Servo bus error.");
+            return false;
+    }
+}
+
+bool calibrateServoEndpoints() {
+    ServoTelemetry t;
+    getServoTelemetry(t);
+    if (!t.valid || getServoTelemetryAge() > 1000) {
+        Serial.println("❌ No servo feedback. Check wiring and 'servo poll'.");
+        return false;
+    }
+
+    Serial.printf("📏 Calibrating end stops at %d steps/s. Press any key to abort.\n", CAL_SPEED);
+
+    // Contact has to be seen as early as possible
+    int previousPollHz = getServoPollRate();
+    setServoPollRate(SERVO_POLL_MAX_HZ);
+
+    int minPos = -1, maxPos = -1;
+    bool ok = findStop("lower", 0, minPos) && findStop("upper", 4095, maxPos);
+
+    setServoPollRate(previousPollHz);
+
+    // The servo was moved behind the follow logic's back
+    lastServoPos = -1;
+    lastServoMode = -1;
+
+    if (!ok) return false;
+
+    if (maxPos - minPos < CAL_MIN_TRAVEL + 2 * CAL_MARGIN) {
+        Serial.printf("❌ Measured travel %d–%d is too short, limits unchanged.\n", minPos, maxPos);
+        return false;
+    }
+
+    servoMinPos = minPos;
+    servoMaxPos = maxPos;
+    storeServoLimits();
+    generateServoPositions(numRanges);
+
+    // Back off the upper stop to the first mode position
+    servoWritePosEx(getServoMinUsable(), CAL_SPEED * 4, CAL_ACC);
+
+    Serial.printf("✅ End stops at %d and %d (%.1f° of travel)\n",
+                  minPos, maxPos, 360.0 * (maxPos - minPos) / 4096.0);
+    printModeRangeMapping();
+    return true;
+}
+
+void printServoLimits() {
+    if (!servoLimitsCalibrated()) {
+        Serial.println("📏 End stops not calibrated (run 'servo calibrate').");
+        return;
+    }
+    Serial.printf("📏 End stops: %d – %d, usable %d – %d (%.1f°)\n",
+                  servoMinPos, servoMaxPos, getServoMinUsable(), getServoMaxUsable(),
+                  360.0 * (getServoMaxUsable() - getServoMinUsable()) / 4096.0);
+}
@@ -7,88 +7,25 @@
 #include "../include/wifi_utils.h"
 #include "../include/state.h"
 #include "../include/pin_utils.h"
+#include "../include/servo_telemetry.h"
+#include "../include/motion.h"
+#include "../include/actuators.h"
+#include "../include/calibration.h"
+#include "../include/control.h"
+#include "../include/perf.h"
+#include "../include/trace.h"
+#include "../include/move_tracker.h"
+#include "../include/line_reader.h"
+#include "../include/live_stream.h"
+#include "../include/sse_server.h"
+#include "../include/udp_telemetry.h"
+#include "../include/boot.h"
 #include <WiFi.h>
 
 
 String SYSTEM_VERSION = "1.2.0";
 
 extern int STATUS_BUTTON;
-
-void printMenu() {
-    Serial.println(F("\n============= 📜 COMMAND MENU ============="));
-
-    Serial.println(F("\n🔧 NVS COMMANDS"));
-    Serial.println(F("  nvs store <thresholds>     – Store servo RPM thresholds"));
-    Serial.println(F("  nvs list                   – List ALL stored values in storage"));
-    Serial.println(F("  nvs reset                  – Reset and restore default ranges"));
-    Serial.println(F("  nvs map                    – Show range → servo mapping"));
-
-    Serial.println(F("\n📈 RPM COMMANDS"));
-    Serial.println(F("  rpm read                   – Show current RPM and source"));
-    Serial.println(F("  rpm set <value>            – Manually set RPM"));
-    Serial.println(F("  rpm source <sensor|sim|manual> – Change RPM input source"));
-    Serial.println(F("  rpm live                   – Live RPM updates (type 'exit' to leave)"));
-    Serial.println(F("  rpm pin get                – Show RPM sensor pin"));
-    Serial.println(F("  rpm pin set <pin>          – Set RPM sensor pin"));
-
-    Serial.println(F("\n🦾 SERVO COMMANDS"));
-    Serial.println(F("  servo set <angle>          – Set servo to angle (0–360°)"));
-    Serial.println(F("  servo get                  – Get current servo angle"));
-    Serial.println(F("  servo sweep <f> <t> <s> <d> – Sweep servo (from–to, step, delay)"));
-    Serial.println(F("  servo full                 – 0→360° sweep (no return)"));
-    Serial.println(F("  servo fullcircle           – 0→360°→0° sweep"));
-    Serial.println(F("  servo reset                – Reset servo to 0°"));
-    Serial.println(F("  servo follow               – Enable servo RPM following"));
-    Serial.println(F("  servo unfollow             – Disable servo tracking"));
-    Serial.println(F("  servo init default         – Init servo UART with default pins"));
-    Serial.println(F("  servo init <rx> <tx>       – Init servo with custom UART pins"));
-    Serial.println(F("  servo positions set        – Manually set servo positions per range"));
-    Serial.println(F("  servo map                  – Show active RPM→position mapping"));
-    Serial.println(F("  servo rpm                  – Print position for current RPM"));
-    Serial.println(F("  servo status               – Print servo config and state"));
-
-    Serial.println(F("\n⚙️ MECHANICAL CONFIGURATION"));
-    Serial.println(F("  rack get                   – Show current rack length (mm)"));
-    Serial.println(F("  rack set <length_mm>       – Set rack length in mm"));
-    Serial.println(F("  pinion get                 – Show current pinion radius (mm)"));
-    Serial.println(F("  pinion set <radius_mm>     – Set pinion gear radius in mm"));
-
-    Serial.println(F("\n📶 WIFI COMMANDS"));
-    Serial.println(F("  wifi enable                – Start Wi-Fi in AP mode"));
-    Serial.println(F("  wifi disable               – Disable Wi-Fi"));
-    Serial.println(F("  wifi ip                    – Show AP IP address"));
-    Serial.println(F("  wifi txpower               – Show TX power"));
-    Serial.println(F("  wifi txpower <value>       – Set TX power in dBm"));
-    Serial.println(F("  wifi mac                   – Print MAC address"));
-    Serial.println(F("  wifi clients               – Show number of connected clients"));
-    Serial.println(F("  wifi status                – Show full Wi-Fi status"));
-
-    Serial.println(F("\n🧭 STATE COMMANDS"));
-    Serial.println(F("  state get                  – Show current system state"));
-    Serial.println(F("  state set <race|diagnostics|config> – Change system state"));
-    Serial.println(F("  state pin get              – Get button pin used for state switching"));
-    Serial.println(F("  state pin set <pin>        – Set button pin and reattach interrupt"));
-    Serial.println(F("  state list                 – Show all valid system states"));
-
-    Serial.println(F("\n📌 PIN COMMANDS"));
-    Serial.println(F("  movement pin get           – Show current movement pin"));
-    Serial.println(F("  movement pin set <pin>     – Change movement pin and reinitialize"));
-    Serial.println(F("  movement pin read          – Read logic level of movement pin"));
-    Serial.println(F("  mark pin get               – Show current mark pin"));
-    Serial.println(F("  mark pin set <pin>         – Change mark pin and reinitialize"));
-    Serial.println(F("  pin clear <pin>            – Detach interrupts and disable pin"));
-    Serial.println(F("  pin status                 – Display all GPIO pin assignments"));
-
-    Serial.println(F("\n🧰 MISC COMMANDS"));
-    Serial.println(F("  status                     – Full system status report"));
-    Serial.println(F("  version                    – Show system version"));
-    Serial.println(F("  pinout                     – Show pinout of board"));
-    Serial.println(F("  reset                      – Reset the board, just like pressing the RST button"));
-    Serial.println(F("  help                       – Show this command menu"));
-
-    Serial.println(F("\n===========================================\n"));
-}
-
 void printPinout() {
     Serial.println("|---------------------------------------------|");
     Serial.println("|             ESP32-C3-WROOM-02               |");
@@ -112,546 +49,1325 @@ void printPinout() {
 }
 
 
-bool isSafeCommand(const String& input) {
-    return input.startsWith("status") || input.startsWith("state");
+static LineReader cliReader;
+
+// ===== Servo position wizard =====
+// "servo positions set" asks for one position per range. Each answer
+// arrives as an ordinary CLI line, so the loop keeps running meanwhile.
+static int wizardRange = -1;  // Range being asked for, -1 when idle
+static int wizardPositions[MOTION_MAX_MODES];
+
+static void promptPositionWizard() {
+    Serial.printf("Enter servo position for RPM range [%d – %d]: ",
+                  modeRanges[wizardRange][0], modeRanges[wizardRange][1]);
 }
 
-void handleCLI() {
-    if (Serial.available()) {
-        String input = Serial.readStringUntil('\n');
-        input.trim();  // Remove whitespace
-
-        // Only allow full CLI in DIAGNOSTICS mode
-        if (getCurrentState() != SystemState::CONFIG && !isSafeCommand(input)) {
-            Serial.println("⚠️ CLI is restricted. Switch to CONFIG mode to access full commands.");
-            return;
-        }
-        
-        // ================ NVS COMMANDS ===================
-        
-        if (input.startsWith("nvs store")) {
-            input.trim();
-            
-            // Prepare a safe mutable buffer
-            char buf[128];
-            input.toCharArray(buf, sizeof(buf));
-            char *token = strtok(buf, " ");
-        
-            int tokenCount = 0;
-            std::vector<int> thresholds;
-        
-            while (token != nullptr) {
-                if (tokenCount >= 2) {
-                    int val = atoi(token);
-                    if (val < 0 || val > 14500) {
-                        Serial.printf("❌ Invalid threshold '%d'. Must be between 0 and 14500.\n", val);
-                        return;
-                    }
-                    thresholds.push_back(val);
-                }
-                token = strtok(nullptr, " ");
-                tokenCount++;
-            }
-        
-            if (thresholds.size() < 1) {
-                Serial.println("⚠️ No thresholds provided. Usage: nvs store 3000 6000 9000");
-                return;
-            }
-        
-            // Sort and validate
-            std::sort(thresholds.begin(), thresholds.end());
-            for (size_t i = 1; i < thresholds.size(); ++i) {
-                if (thresholds[i] <= thresholds[i - 1]) {
-                    Serial.println("❌ Thresholds must be strictly increasing.");
-                    return;
-                }
-            }
-        
-            // Ensure 0 and 14500 are included
-            if (thresholds.front() != 0) thresholds.insert(thresholds.begin(), 0);
-            if (thresholds.back() != 14500) thresholds.push_back(14500);
-        
-            if (thresholds.size() < 3) {
-                Serial.println("❌ At least three thresholds required (including 0 and 14500).");
-                return;
-            }
-        
-            updateAndStoreRanges(thresholds);
-            generateServoPositions(numRanges);
-        }
-        
-        else if (input == "nvs list") {
-            Serial.println("📄 Current active servo RPM ranges:");
-            listNVSContents();  // Just prints modeRanges[]
-        }
-        
-        else if (input == "nvs reset") {
-            Serial.println("♻️ Resetting NVS and restoring defaults...");
-            eraseNVS();  // Erases + reinitializes with setDefaultRanges()
-        }
+static void startPositionWizard() {
+    Serial.println("🔧 Interactive Servo Position Setup (type 'exit' to cancel)");
+    wizardRange = 0;
+    promptPositionWizard();
+}
 
-        else if (input == "nvs map") {
-            printModeRangeMapping();
-        }
+static void handlePositionWizardLine(const char* input) {
+    Serial.println(input);  // Echo the answer after the prompt
 
-        // ================= RPM COMMANDS =================
-        else if (input.startsWith("rpm set ")) {
-            String valStr = input.substring(8);
-            valStr.trim();
-            if (valStr.length() == 0 || !valStr[0] || !valStr[0] >= '0') {
-                Serial.println("⚠️ Invalid RPM value. Use: rpm set <positive_integer>");
-            } else {
-                int value = valStr.toInt();
-                if (value >= 0) {
-                    setRPM(value);
-                    setRPMSource(MANUAL);
-                    Serial.printf("✅ Manual RPM set to %d\n", value);
-                } else {
-                    Serial.println("⚠️ RPM must be non-negative.");
-                }
-            }
-        }
-        
-        else if (input == "rpm read") {
-            Serial.printf("📈 Current RPM (%s): %.2f\n", getRPMSourceName(), getRPMUnified());
-        }
-        
-        else if (input.startsWith("rpm source ")) {
-            String source = input.substring(11);
-            source.trim();
-        
-            if (source == "sensor") {
-                setRPMSource(SENSOR);
-                Serial.println("📡 RPM source set to SENSOR (real input)");
-            } else if (source == "sim") {
-                setRPMSource(SIMULATED);
-                Serial.println("🧪 RPM source set to SIMULATED (test values)");
-            } else if (source == "manual") {
-                setRPMSource(MANUAL);
-                Serial.println("✍️ RPM source set to MANUAL (user-defined)");
-            } else {
-                Serial.println("⚠️ Unknown RPM source. Use one of: sensor, sim, manual");
-            }
-        }
+    if (strcmp(input, "exit") == 0) {
+        wizardRange = -1;
+        Serial.println("❎ Servo position setup cancelled, nothing saved.");
+        return;
+    }
 
-        else if (input == "rpm live") {
-            Serial.println("🔁 Entering live RPM mode. Type 'exit' to stop.");
-        
-            while (true) {
-                // Check for user input to exit
-                if (Serial.available()) {
-                    String exitCommand = Serial.readStringUntil('\n');
-                    exitCommand.trim();
-                    if (exitCommand == "exit") {
-                        Serial.println("❎ Exiting live RPM mode.");
-                        break;
-                    }
-                }
-        
-                // Print current RPM with source
-                float currentRPM = getRPMUnified();
-                Serial.printf("📈 RPM (%s): %.2f\n", getRPMSourceName(), currentRPM);
-                updateServoIfFollowing();
-                delay(200);  // Delay between updates to avoid flooding the output
-            }
-        }
-       
-        else if (input.startsWith("rpm pin")) {
-            if (input == "rpm pin get") {
-                Serial.printf("📍 RPM sensor pin: %d\n", getRpmPin());
-            } else if (input.startsWith("rpm pin set")) {
-                int pin = input.substring(12).toInt();  // skip "rpm pin set "
-                setRpmPin(pin);
-                storePinAssignments();
-                Serial.printf("✅ RPM sensor pin set to %d\n", pin);
-            } else {
-                Serial.println("❌ Usage: 'rpm pin get' or 'rpm pin set <pin>'");
-            }
-        }
+    char* end;
+    long pos = strtol(input, &end, 10);
+    if (end == input || *end != '\0' || pos < 0 || pos > 4095) {
+        Serial.println("❌ Invalid input. Must be between 0 and 4095.");
+        promptPositionWizard();
+        return;
+    }
 
-        // =============== SERVO COMMANDS ================
-        else if (input.startsWith("servo set ")) {
-            int angle = input.substring(10).toInt();
-            if (angle < 0 || angle > 360) {
-                Serial.println("❌ Invalid angle. Use 0–360°");
-            } else {
-                disableServoFollow();
-                setServoAngle(angle);
-                Serial.printf("🎯 Servo angle set to %d°\n", angle);
-            }
-        }
-        
-        else if (input == "servo get") {
-            int angle = getServoAngle();
-            Serial.printf("📏 Current servo angle: %d°\n", angle);
-        }
-        
-        else if (input.startsWith("servo sweep ")) {
-            int f, t, s, d;
-            int matched = sscanf(input.c_str(), "servo sweep %d %d %d %d", &f, &t, &s, &d);
-            if (matched == 4 && s != 0 && d >= 0 && f >= 0 && f <= 360 && t >= 0 && t <= 360) {
-                disableServoFollow();
-                sweepServo(f, t, s, d);
-                Serial.println("🔄 Sweep complete.");
-            } else {
-                Serial.println("❌ Usage: servo sweep <from> <to> <step> <delay_ms> (0–360°)");
-            }
-        }
-        
-        else if (input == "servo fullcircle") {
-            disableServoFollow();
-            servoSweepFullCycle();
-            Serial.println("🌀 Servo did full 0°→360°→0° sweep");
-        }
+    wizardPositions[wizardRange++] = pos;
+    if (wizardRange < numRanges) {
+        promptPositionWizard();
+        return;
+    }
 
-        else if (input == "servo full") {
-            disableServoFollow();
-            servoSweepForward();
-            Serial.println("🌀 Servo did a 0°→360° sweep (no return)");
-        }
-        
-        else if (input == "servo reset") {
-            disableServoFollow();
-            resetServo();
-            Serial.println("↩️ Servo reset to 0°");
-        }
-        
-        else if (input == "servo follow") {
-            enableServoFollow();
-            Serial.println("📡 Servo will now follow RPM live.");
-        }
-        
-        else if (input == "servo unfollow") {
-            disableServoFollow();
-            Serial.println("🛑 Servo tracking disabled. Manual control resumed.");
-        }
-        
-        else if (input == "servo init default") {
-            servo_defaultInit();
-            Serial.println("🔧 Servo and UART initialized with default pins.");
-        }
-        
-        else if (input.startsWith("servo init ")) {
-            int rx, tx;
-            int matched = sscanf(input.c_str(), "servo init %d %d", &rx, &tx);
-            if (matched == 2 && rx >= 0 && tx >= 0) {
-                configureServoPins(rx, tx);
-                storePinAssignments();
-                Serial.printf("🛠️ Servo initialized with RX=%d TX=%d\n", rx, tx);
-            } else {
-                Serial.println("❌ Usage: servo init <rx> <tx> (non-negative values only)");
-            }
-        }
-        
-        else if(input == "servo status"){
-            servoStatus();
-        }
+    wizardRange = -1;
+    for (int i = 0; i < numRanges; ++i) modeServoPositions[i] = wizardPositions[i];
+    storeServoPositions();
+    Serial.println("✅ Custom servo positions saved:");
+    for (int i = 0; i < numRanges; ++i) {
+        Serial.printf("Range %d [%d – %d] => Servo Position: %d\n",
+                    i + 1, modeRanges[i][0], modeRanges[i][1], modeServoPositions[i]);
+    }
+}
 
-        else if(input == "servo positions set"){
-            Serial.println("🔧 Interactive Servo Position Setup");
-            for (int i = 0; i < numRanges; ++i) {
-                int pos = -1;
-                while (true) {
-                    Serial.printf("Enter servo position for RPM range [%d – %d]: ", 
-                                modeRanges[i][0], modeRanges[i][1]);
-                    while (!Serial.available()) delay(10);
-                    
-                    String input = Serial.readStringUntil('\n');
-                    input.trim();
-                    pos = input.toInt();
-                    if (pos >= 0 && pos <= 4095) break;
-
-                    Serial.println("❌ Invalid input. Must be between 0 and 4095.");
-                }
-                modeServoPositions[i] = pos;
-            }
-            storeServoPositions();
-            Serial.println("✅ Custom servo positions saved:");
-            for (int i = 0; i < numRanges; ++i) {
-                Serial.printf("Range %d [%d – %d] => Servo Position: %d\n",
-                            i + 1, modeRanges[i][0], modeRanges[i][1], modeServoPositions[i]);
-            }
-        }
-        
-        else if (input == "servo map") {
-            printModeRangeMapping();
-        }
+// ===== Command table types =====
+// Every command is one row of CLI_COMMANDS: the words that name it, how
+// many arguments may follow, the states it may run in and its help line.
+// Dispatch, "help" and the state check are all driven by that table.
 
-        else if (input == "servo rpm"){
-            servoRPM();
-        }
-        
-        else if (input == "pinion get"){
-            Serial.printf("Current pinion radius: %f mm\n", getPinionRadius());
-        }
+struct CliCommand;
 
-        else if (input == "rack get"){
-            Serial.printf("Current rack length: %f mm\n", getRackLength());
-        }
+// One invocation: the matched row and the tokens after its words
+struct CliCall {
+    const CliCommand* cmd;
+    const char* const* argv;
+    uint8_t argc;
+};
 
-        else if (input.startsWith("rack set ")) {
-            float len = input.substring(9).toFloat();  // "rack set " is 9 chars
-            setRackLength(len);
-            Serial.printf("✅ Rack length set to %.2f mm\n", len);
-        }
-        
-        else if (input.startsWith("pinion set ")) {
-            float rad = input.substring(11).toFloat();  // "pinion set " is 11 chars
-            setPinionRadius(rad);
-            Serial.printf("✅ Pinion radius set to %.2f mm\n", rad);
-        }
+// Returns false on bad arguments; the dispatcher then prints the usage
+typedef bool (*CliHandler)(const CliCall& call);
 
-        
+struct CliCommand {
+    const char* name;       // Command words, separated by single spaces
+    uint32_t hash;          // cliHash(name), computed at compile time
+    uint8_t minArgs;
+    uint8_t maxArgs;
+    uint8_t states;         // CLI_IN() bits of further states it may run in, or CLI_CONFIG_ONLY
+    CliHandler handler;     // nullptr marks a menu heading
+    const char* usage;      // Menu column; nullptr hides the row from help
+    const char* help;
+};
 
-        // ============= WIFI COMMANDS ===================
-        else if (input == "wifi enable") {
-            enableWiFi();
-        }
-          
-        else if (input == "wifi disable") {
-        disableWiFi();
-        }
-          
-        else if (input == "wifi ip") {
-        Serial.print("📡 Access Point IP: ");
-        Serial.println(espAPIP);
-        }
+// Command names are matched on at most this many leading words
+#define CLI_MAX_WORDS 3
 
-        else if (input.startsWith("wifi txpower")) {
-            if (input == "wifi txpower") {
-                showTxPower();
-            } else {
-                float value = input.substring(13).toFloat();  // skip "wifi txpower "
-                setTxPower(value);
-            }
-        }
+// Open-addressed hash → row index, built once by initCLI()
+#define CLI_INDEX_SIZE 256
 
-        else if (input == "wifi clients") {
-            listConnectedClients();
-        }
+// States with STATE_CAP_CLI (see state.h) run every row; CLI_IN() adds
+// a state without the full CLI to a row
+#define CLI_IN(state) (1 << static_cast<int>(SystemState::state))
+#define CLI_CONFIG_ONLY 0
+#define CLI_ANY_STATE 0xFF
 
-        else if (input == "wifi mac") {
-            printWifiMac();
-        }
+// FNV-1a, usable in constant expressions so row hashes cost nothing at runtime
+#define CLI_HASH_SEED 2166136261u
+static constexpr uint32_t cliHashStep(uint32_t h, char c) {
+    return (h ^ (uint8_t)c) * 16777619u;
+}
+static constexpr uint32_t cliHash(const char* s, uint32_t h = CLI_HASH_SEED) {
+    return *s ? cliHash(s + 1, cliHashStep(h, *s)) : h;
+}
 
-        else if (input == "wifi status") {
-            Serial.println(F("📶 Wi-Fi Status Report"));
-        
-            wifi_mode_t mode = WiFi.getMode();
-            int clientCount = WiFi.softAPgetStationNum();
-            float txPower = WiFi.getTxPower();
-            String mac = WiFi.softAPmacAddress();
-        
-            Serial.printf("  MAC Address: %s\n", mac.c_str());
-            showTxPower();
-        
-            if (mode == WIFI_MODE_AP) {
-                Serial.println(F("  Mode: Access Point (AP)"));
-                Serial.print(F("  SSID: ")); Serial.println(ssid);
-                Serial.print(F("  Password: ")); Serial.println(password);
-                Serial.print(F("  IP Address: ")); Serial.println(espAPIP);
-                Serial.print(F("  Clients connected: ")); Serial.println(clientCount);
-            } else if (mode == WIFI_MODE_STA) {
-                Serial.println(F("  Mode: Station (STA)"));
-                Serial.print(F("  Connected to: ")); Serial.println(WiFi.SSID());
-                Serial.print(F("  IP Address: ")); Serial.println(WiFi.localIP());
-                Serial.print(F("  RSSI: ")); Serial.print(WiFi.RSSI()); Serial.println(" dBm");
-            } else {
-                Serial.println(F("  Status: ❌ Wi-Fi is OFF"));
-            }
-        
-            // Optional: show time since enabled
-            static unsigned long wifiStartMillis = millis();
-            unsigned long uptimeSec = (millis() - wifiStartMillis) / 1000;
-            Serial.printf("  Wi-Fi Uptime: %lu seconds\n", uptimeSec);
-        }
+// ===== Argument parsers =====
+// Each prints what was wrong with the argument and returns false, so a
+// handler can simply "return false" to add the usage line.
 
-        // ============= STATE COMMANDS ===================
-        else if (input == "state get") {
-            Serial.printf("📟 Current system state: %s\n", getCurrentStateName());
-        }
-        
-        else if (input.startsWith("state set ")) {
-            String stateName = input.substring(10);  // skip "state set "
-            if (setStateByName(stateName)) {
-                Serial.printf("✅ State switched to: %s\n", getCurrentStateName());
-            } else {
-                Serial.println("❌ Invalid state name. Use: race, diagnostics, or config.");
-            }
-        }
-        
-        else if (input == "state pin get") {
-            Serial.printf("📍 Current button pin: GPIO %d\n", getModeSwitchButtonPin());
+static bool argInt(const CliCall& c, uint8_t i, long lo, long hi, int& out) {
+    if (i >= c.argc) return false;
+    char* end;
+    long v = strtol(c.argv[i], &end, 10);
+    if (end == c.argv[i] || *end != '\0' || v < lo || v > hi) {
+        Serial.printf("❌ '%s' is not a whole number in %ld–%ld\n", c.argv[i], lo, hi);
+        return false;
+    }
+    out = v;
+    return true;
+}
+
+static bool argFloat(const CliCall& c, uint8_t i, float lo, float hi, float& out) {
+    if (i >= c.argc) return false;
+    char* end;
+    float v = strtof(c.argv[i], &end);
+    if (end == c.argv[i] || *end != '\0' || v < lo || v > hi) {
+        Serial.printf("❌ '%s' is not a number in %g–%g\n", c.argv[i], lo, hi);
+        return false;
+    }
+    out = v;
+    return true;
+}
+
+// The last word of the matched command, for rows sharing a handler
+static const char* lastWord(const CliCall& c) {
+    const char* space = strrchr(c.cmd->name, ' ');
+    return space ? space + 1 : c.cmd->name;
+}
+
+// ================ NVS COMMANDS ===================
+
+static bool cmdNvsStore(const CliCall& c) {
+    std::vector<int> thresholds;
+    for (uint8_t i = 0; i < c.argc; ++i) {
+        int val;
+        if (!argInt(c, i, 0, 14500, val)) return false;
+        thresholds.push_back(val);
+    }
+
+    // Sort and validate
+    std::sort(thresholds.begin(), thresholds.end());
+    for (size_t i = 1; i < thresholds.size(); ++i) {
+        if (thresholds[i] <= thresholds[i - 1]) {
+            Serial.println("❌ Thresholds must be strictly increasing.");
+            return true;
         }
-        
-        else if (input.startsWith("state pin set ")) {
-            int pin = input.substring(14).toInt();  // skip "state pin set "
-            if (pin <= 0 || pin >= 40) {
-                Serial.println("❌ Invalid GPIO number.");
-            } else {
-                setModeSwitchButtonPin(pin);
-                storePinAssignments();
-                initModeButtonInterrupt();  // Reattach interrupt to the new pin
-                Serial.printf("📍 Button pin set to GPIO %d and interrupt attached.\n", pin);
+    }
+
+    // Ensure 0 and 14500 are included
+    if (thresholds.front() != 0) thresholds.insert(thresholds.begin(), 0);
+    if (thresholds.back() != 14500) thresholds.push_back(14500);
+
+    if (thresholds.size() < 3) {
+        Serial.println("❌ At least three thresholds required (including 0 and 14500).");
+        return true;
+    }
+
+    updateAndStoreRanges(thresholds);
+    generateAllActuatorPositions(numRanges);
+    return true;
+}
+
+static bool cmdNvsList(const CliCall&) {
+    Serial.println("📄 Current active servo RPM ranges:");
+    listNVSContents();  // Just prints modeRanges[]
+    return true;
+}
+
+static bool cmdNvsReset(const CliCall&) {
+    Serial.println("♻️ Resetting NVS and restoring defaults...");
+    eraseNVS();  // Erases + reinitializes with setDefaultRanges()
+    return true;
+}
+
+static bool cmdRangeMap(const CliCall&) {
+    printModeRangeMapping();
+    return true;
+}
+
+// ================= RPM COMMANDS =================
+
+static bool cmdRpmRead(const CliCall&) {
+    Serial.printf("📈 Current RPM (%s): %.2f\n", getRPMSourceName(), getRPMUnified());
+    return true;
+}
+
+static bool cmdRpmSet(const CliCall& c) {
+    int value;
+    if (!argInt(c, 0, 0, 100000, value)) return false;
+    setRPM(value);
+    setRPMSource(MANUAL);
+    Serial.printf("✅ Manual RPM set to %d\n", value);
+    return true;
+}
+
+static bool cmdRpmSource(const CliCall& c) {
+    const char* source = c.argv[0];
+    if (strcmp(source, "sensor") == 0) {
+        setRPMSource(SENSOR);
+        Serial.println("📡 RPM source set to SENSOR (real input)");
+    } else if (strcmp(source, "sim") == 0) {
+        setRPMSource(SIMULATED);
+        Serial.println("🧪 RPM source set to SIMULATED (test values)");
+    } else if (strcmp(source, "manual") == 0) {
+        setRPMSource(MANUAL);
+        Serial.println("✍️ RPM source set to MANUAL (user-defined)");
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static bool cmdRpmLive(const CliCall& c) {
+    int hz = LIVE_DEFAULT_HZ;
+    uint8_t fields = 0;
+    for (uint8_t i = 0; i < c.argc; ++i) {
+        if (isdigit((unsigned char)c.argv[i][0])) {
+            if (!argInt(c, i, LIVE_MIN_HZ, LIVE_MAX_HZ, hz)) return false;
+        } else {
+            uint8_t field = parseLiveField(c.argv[i]);
+            if (!field) {
+                Serial.printf("❌ Unknown field '%s'\n", c.argv[i]);
+                return false;
             }
+            fields |= field;
         }
+    }
+    startLiveStream(hz, fields);
+    return true;
+}
 
-        else if (input == "state list") {
-            Serial.println("🧭 Valid system modes:");
-            Serial.println("  - race");
-            Serial.println("  - diagnostics");
-            Serial.println("  - config");
-            Serial.println("  - off");
-        }
-       
-        // ============== PIN COMMANDS ===================  
+static bool cmdRpmLiveBin(const CliCall& c) {
+    int hz = LIVE_MAX_HZ;
+    if (c.argc > 0 && !argInt(c, 0, LIVE_MIN_HZ, LIVE_MAX_HZ, hz)) return false;
+    startLiveStream(hz, LIVE_ALL_FIELDS, LIVE_BINARY);
+    return true;
+}
 
-        else if (input == "movement pin get") {
-            Serial.printf("📍 Current movement pin: GPIO %d\n", getMovementPin());
-        }
+static bool cmdRpmPinGet(const CliCall&) {
+    Serial.printf("📍 RPM sensor pin: %d\n", getRpmPin());
+    return true;
+}
+
+static bool cmdRpmPinSet(const CliCall& c) {
+    int pin;
+    if (!argInt(c, 0, 0, 39, pin)) return false;
+    setRpmPin(pin);
+    storePinAssignments();
+    Serial.printf("✅ RPM sensor pin set to %d\n", pin);
+    return true;
+}
+
+// =============== SERVO COMMANDS ================
+
+static bool cmdServoSet(const CliCall& c) {
+    int angle;
+    if (!argInt(c, 0, 0, 360, angle)) return false;
+    disableServoFollow();
+    setServoAngle(angle);
+    Serial.printf("🎯 Servo angle set to %d°\n", angle);
+    return true;
+}
+
+static bool cmdServoGet(const CliCall&) {
+    Serial.printf("📏 Current servo angle: %d°\n", getServoAngle());
+    return true;
+}
+
+static bool cmdServoSweep(const CliCall& c) {
+    int f, t, s, d;
+    if (!argInt(c, 0, 0, 360, f) || !argInt(c, 1, 0, 360, t) ||
+        !argInt(c, 2, -360, 360, s) || !argInt(c, 3, 0, 10000, d) || s == 0) {
+        return false;
+    }
+    disableServoFollow();
+    sweepServo(f, t, s, d);
+    Serial.println("🔄 Sweep complete.");
+    return true;
+}
+
+static bool cmdServoFull(const CliCall&) {
+    disableServoFollow();
+    servoSweepForward();
+    Serial.println("🌀 Servo did a 0°→360° sweep (no return)");
+    return true;
+}
+
+static bool cmdServoFullCircle(const CliCall&) {
+    disableServoFollow();
+    servoSweepFullCycle();
+    Serial.println("🌀 Servo did full 0°→360°→0° sweep");
+    return true;
+}
+
+static bool cmdServoReset(const CliCall&) {
+    disableServoFollow();
+    resetServo();
+    Serial.println("↩️ Servo reset to 0°");
+    return true;
+}
+
+static bool cmdServoFollow(const CliCall&) {
+    enableServoFollow();
+    Serial.println("📡 Servo will now follow RPM live.");
+    return true;
+}
+
+static bool cmdServoUnfollow(const CliCall&) {
+    disableServoFollow();
+    Serial.println("🛑 Servo tracking disabled. Manual control resumed.");
+    return true;
+}
+
+static bool cmdServoInitDefault(const CliCall&) {
+    servo_defaultInit();
+    Serial.println("🔧 Servo and UART initialized with default pins.");
+    return true;
+}
+
+static bool cmdServoInit(const CliCall& c) {
+    int rx, tx;
+    if (!argInt(c, 0, 0, 39, rx) || !argInt(c, 1, 0, 39, tx)) return false;
+    configureServoPins(rx, tx);
+    storePinAssignments();
+    Serial.printf("🛠️ Servo initialized with RX=%d TX=%d\n", rx, tx);
+    return true;
+}
+
+static bool cmdServoPositionsSet(const CliCall&) {
+    startPositionWizard();
+    return true;
+}
+
+static bool cmdServoRpm(const CliCall&) {
+    servoRPM();
+    return true;
+}
+
+static bool cmdServoStatus(const CliCall&) {
+    servoStatus();
+    return true;
+}
+
+static bool cmdServoTelemetry(const CliCall&) {
+    printServoTelemetry();
+    return true;
+}
+
+static bool cmdServoPoll(const CliCall& c) {
+    if (c.argc == 0) {
+        Serial.printf("📡 Servo telemetry poll rate: %d Hz\n", getServoPollRate());
+        return true;
+    }
+    int hz;
+    if (!argInt(c, 0, 0, SERVO_POLL_MAX_HZ, hz)) return false;
+    setServoPollRate(hz);
+    storeServoPollRate();
+    Serial.printf("✅ Servo telemetry poll rate set to %d Hz\n", hz);
+    return true;
+}
+
+static bool cmdServoLatency(const CliCall&) {
+    printMoveLatency();
+    return true;
+}
+
+static bool cmdServoLatencyReset(const CliCall&) {
+    resetMoveLatency();
+    Serial.println("♻️ Latency statistics cleared.");
+    return true;
+}
+
+static bool cmdServoBus(const CliCall&) {
+    printServoBusStats();
+    return true;
+}
+
+static bool cmdServoBench(const CliCall& c) {
+    int n = 200;
+    if (c.argc > 0 && !argInt(c, 0, 1, 10000, n)) return false;
+    servoBenchmark(n);
+    return true;
+}
+
+static bool cmdServoCalibrate(const CliCall&) {
+    disableServoFollow();
+    calibrateServoEndpoints();
+    return true;
+}
+
+static bool cmdServoCalibrateShow(const CliCall&) {
+    printServoLimits();
+    return true;
+}
+
+static bool cmdServoCalibrateClear(const CliCall&) {
+    clearServoLimits();
+    storeServoLimits();
+    generateServoPositions(numRanges);
+    Serial.println("♻️ End stops cleared, positions regenerated from rack/pinion.");
+    return true;
+}
+
+// =============== MOTION COMMANDS ================
+
+static bool cmdMotionShow(const CliCall&) {
+    printMotionProfiles();
+    return true;
+}
+
+static bool cmdMotionSet(const CliCall& c) {
+    int f, t, spd, acc;
+    if (!argInt(c, 0, 1, MOTION_MAX_MODES, f) || !argInt(c, 1, 1, MOTION_MAX_MODES, t) ||
+        !argInt(c, 2, 0, 4000, spd) || !argInt(c, 3, 0, 254, acc) ||
+        !setMotionProfile(f, t, spd, acc)) {
+        return false;
+    }
+    storeMotionProfiles();
+    Serial.printf("✅ Profile %d → %d set to speed %d acc %d\n", f, t, spd, acc);
+    return true;
+}
+
+static bool cmdMotionTune(const CliCall& c) {
+    int f, t;
+    if (!argInt(c, 0, 1, MOTION_MAX_MODES, f) || !argInt(c, 1, 1, MOTION_MAX_MODES, t)) return false;
+    disableServoFollow();
+    if (autoTuneMotion(f, t)) storeMotionProfiles();
+    return true;
+}
+
+static bool cmdMotionTuneAll(const CliCall&) {
+    disableServoFollow();
+    autoTuneAllMotion();
+    storeMotionProfiles();
+    printMotionProfiles();
+    return true;
+}
+
+static bool cmdMotionReset(const CliCall&) {
+    resetMotionProfiles();
+    storeMotionProfiles();
+    Serial.println("♻️ Motion profiles restored to defaults.");
+    return true;
+}
+
+// =============== ACTUATOR COMMANDS ================
+
+static bool cmdActuatorList(const CliCall&) {
+    printActuators();
+    return true;
+}
+
+static bool cmdActuatorAdd(const CliCall& c) {
+    int id;
+    if (!argInt(c, 0, 0, 253, id)) return false;
+    int index = addActuator(id);
+    if (index < 0) {
+        Serial.printf("❌ Could not add ID %d (max %d actuators, IDs unique and < 254)\n", id, MAX_ACTUATORS);
+    } else {
+        storeActuators();
+        Serial.printf("✅ Actuator %d added with servo ID %d\n", index, id);
+    }
+    return true;
+}
+
+static bool cmdActuatorRemove(const CliCall& c) {
+    int index;
+    if (!argInt(c, 0, 0, MAX_ACTUATORS - 1, index)) return false;
+    if (removeActuator(index)) {
+        storeActuators();
+        Serial.printf("🗑️ Actuator %d removed\n", index);
+    } else {
+        Serial.println("❌ Invalid index (actuator 0 cannot be removed)");
+    }
+    return true;
+}
+
+static bool cmdActuatorSet(const CliCall& c) {
+    int index;
+    float value;
+    if (!argInt(c, 0, 0, MAX_ACTUATORS - 1, index) || !argFloat(c, 2, -4095, 4095, value) ||
+        !setActuatorParam(index, c.argv[1], value)) {
+        return false;
+    }
+    storeActuators();
+    if (index == 0) storeMechanicalParams();  // Actuator 0 uses the global rack/pinion
+    Serial.printf("✅ Actuator %d %s set to %g\n", index, c.argv[1], value);
+    return true;
+}
+
+static bool cmdActuatorPositions(const CliCall& c) {
+    if (c.argc - 1 != numRanges) {
+        Serial.printf("❌ Expected %d positions, one per mode\n", numRanges);
+        return false;
+    }
+    int index;
+    if (!argInt(c, 0, 0, getActuatorCount() - 1, index)) return false;
+
+    int positions[MOTION_MAX_MODES];
+    for (int m = 0; m < numRanges; ++m) {
+        if (!argInt(c, m + 1, 0, 4095, positions[m])) return false;
+    }
+
+    for (int m = 0; m < numRanges; ++m) setActuatorModePosition(index, m + 1, positions[m]);
+    if (index == 0) storeServoPositions();
+    storeActuators();
+    Serial.printf("✅ Positions of actuator %d saved\n", index);
+    return true;
+}
+
+static bool cmdActuatorGenerate(const CliCall& c) {
+    int index;
+    if (!argInt(c, 0, 0, getActuatorCount() - 1, index)) return false;
+    generateActuatorPositions(index, numRanges);
+    storeActuators();
+    Serial.printf("✅ Positions of actuator %d regenerated\n", index);
+    return true;
+}
+
+static bool cmdActuatorSkew(const CliCall&) {
+    printActuatorSkew();
+    return true;
+}
+
+// =============== CONTROL LOOP COMMANDS ================
+
+static bool cmdControlStats(const CliCall&) {
+    printControlStats();
+    return true;
+}
+
+static bool cmdControlRate(const CliCall& c) {
+    if (c.argc == 0) {
+        Serial.printf("⏱️ Control loop rate: %d Hz\n", getControlRate());
+        return true;
+    }
+    int hz;
+    if (!argInt(c, 0, 1, CONTROL_MAX_HZ, hz)) return false;
+    setControlRate(hz);
+    storeControlRate();
+    Serial.printf("✅ Control loop rate set to %d Hz\n", hz);
+    return true;
+}
 
-        else if (input.startsWith("movement pin set ")) {
-            int pin = input.substring(17).toInt();  // skip "movement pin set "
-            if (pin <= 0 || pin >= 40) {
-                Serial.println("❌ Invalid GPIO number.");
-            } else {
-                setMovementPin(pin);
-                storePinAssignments();
-                initMovementPin();                
-                Serial.printf("📍 Movement pin set to GPIO %d and initialized.\n", pin);
+static bool cmdControlHysteresis(const CliCall& c) {
+    if (c.argc == 0) {
+        Serial.printf("⏱️ Mode boundary hysteresis: %d RPM\n", getModeHysteresis());
+        return true;
+    }
+    int rpm;
+    if (!argInt(c, 0, 0, 2000, rpm)) return false;
+    setModeHysteresis(rpm);
+    storeModeHysteresis();
+    disarmModeBoundaries();  // Re-armed with the new bounds on the next cycle
+    Serial.printf("✅ Mode boundary hysteresis set to %d RPM\n", rpm);
+    return true;
+}
+
+static bool cmdControlReset(const CliCall&) {
+    resetControlStats();
+    Serial.println("♻️ Control loop statistics cleared.");
+    return true;
+}
+
+// =============== PROFILER COMMANDS ================
+
+static bool cmdPerfShow(const CliCall&) {
+    printPerfStats();
+    return true;
+}
+
+static bool cmdPerfReset(const CliCall&) {
+    resetPerfStats();
+    Serial.println("♻️ Profiler statistics cleared.");
+    return true;
+}
+
+static bool cmdPerfOnOff(const CliCall& c) {
+    setPerfEnabled(strcmp(lastWord(c), "on") == 0);
+    Serial.printf("📊 Profiler %s\n", perfEnabled ? "enabled" : "paused");
+    return true;
+}
+
+// =============== TRACE COMMANDS ================
+
+static bool cmdTraceDump(const CliCall&) {
+    dumpTrace();
+    return true;
+}
+
+static bool cmdTraceClear(const CliCall&) {
+    clearTrace();
+    Serial.println("♻️ Trace cleared.");
+    return true;
+}
+
+static bool cmdTraceOnOff(const CliCall& c) {
+    setTraceEnabled(strcmp(lastWord(c), "on") == 0);
+    Serial.printf("🧵 Trace recording %s (%lu events held)\n",
+                  traceEnabled ? "on" : "paused", (unsigned long)getTraceCount());
+    return true;
+}
+
+static bool cmdTraceIsr(const CliCall& c) {
+    setTraceIsrEnabled(strcmp(lastWord(c), "on") == 0);
+    Serial.printf("🧵 RPM edge events %s\n", isTraceIsrEnabled() ? "included" : "skipped");
+    return true;
+}
+
+static bool cmdTraceMark(const CliCall& c) {
+    int n;
+    if (!argInt(c, 0, 0, 0xFFFF, n)) return false;
+    traceEvent(TRACE_MARK, TRACE_INSTANT, n);
+    Serial.println("🧵 Marker added.");
+    return true;
+}
+
+// ============= MECHANICAL CONFIGURATION ==============
+
+static bool cmdRackGet(const CliCall&) {
+    Serial.printf("Current rack length: %f mm\n", getRackLength());
+    return true;
+}
+
+static bool cmdRackSet(const CliCall& c) {
+    float len;
+    if (!argFloat(c, 0, 1, 1000, len)) return false;
+    setRackLength(len);
+    storeMechanicalParams();
+    Serial.printf("✅ Rack length set to %.2f mm\n", len);
+    return true;
+}
+
+static bool cmdPinionGet(const CliCall&) {
+    Serial.printf("Current pinion radius: %f mm\n", getPinionRadius());
+    return true;
+}
+
+static bool cmdPinionSet(const CliCall& c) {
+    float rad;
+    if (!argFloat(c, 0, 1, 500, rad)) return false;
+    setPinionRadius(rad);
+    storeMechanicalParams();
+    Serial.printf("✅ Pinion radius set to %.2f mm\n", rad);
+    return true;
+}
+
+// ============= WIFI COMMANDS ===================
+
+static bool cmdWifiEnable(const CliCall&) {
+    enableWiFi();
+    Serial.println(F("📶 Wi-Fi turning on"));
+    return true;
+}
+
+static bool cmdWifiDisable(const CliCall&) {
+    disableWiFi();
+    Serial.println(F("📴 Wi-Fi turning off"));
+    return true;
+}
+
+static bool cmdWifiRadio(const CliCall&) {
+    printRadioStats();
+    return true;
+}
+
+static bool cmdWifiIp(const CliCall&) {
+    Serial.print("📡 Access Point IP: ");
+    Serial.println(espAPIP);
+    return true;
+}
+
+static bool cmdWifiTxPower(const CliCall& c) {
+    if (c.argc == 0) {
+        showTxPower();
+        return true;
+    }
+    float value;
+    if (!argFloat(c, 0, -1, 21, value)) return false;
+    setTxPower(value);
+    return true;
+}
+
+static bool cmdWifiMac(const CliCall&) {
+    printWifiMac();
+    return true;
+}
+
+static bool cmdWifiClients(const CliCall&) {
+    listConnectedClients();
+    return true;
+}
+
+static bool cmdWifiHttp(const CliCall&) {
+    printHttpStats();
+    return true;
+}
+
+static bool cmdWifiHttpReset(const CliCall&) {
+    resetHttpStats();
+    Serial.println("♻️ HTTP statistics cleared.");
+    return true;
+}
+
+static bool cmdWifiEvents(const CliCall&) {
+    printSseClients();
+    return true;
+}
+
+static bool cmdWifiUdp(const CliCall&) {
+    printUdpTelemetryStatus();
+    return true;
+}
+
+// wifi udp on [hz] [multicast]
+static bool cmdWifiUdpOn(const CliCall& c) {
+    int hz = getUdpTelemetryRate();
+    bool multicast = isUdpTelemetryMulticast();
+    if (c.argc >= 1 && !argInt(c, 0, UDP_MIN_HZ, UDP_MAX_HZ, hz)) return false;
+    if (c.argc == 2) {
+        if (strcmp(c.argv[1], "multicast") != 0 && strcmp(c.argv[1], "broadcast") != 0) return false;
+        multicast = strcmp(c.argv[1], "multicast") == 0;
+    }
+    enableUdpTelemetry(hz, multicast);
+    printUdpTelemetryStatus();
+    return true;
+}
+
+static bool cmdWifiUdpOff(const CliCall&) {
+    disableUdpTelemetry();
+    Serial.println("📴 UDP telemetry off.");
+    return true;
+}
+
+static bool cmdWifiStatus(const CliCall&) {
+    Serial.println(F("📶 Wi-Fi Status Report"));
+
+    wifi_mode_t mode = WiFi.getMode();
+    int clientCount = WiFi.softAPgetStationNum();
+    String mac = WiFi.softAPmacAddress();
+
+    Serial.printf("  MAC Address: %s\n", mac.c_str());
+    showTxPower();
+
+    if (!isWiFiOn()) {
+        Serial.println(F("  Status: ❌ Wi-Fi is OFF"));
+    } else if (mode == WIFI_MODE_AP) {
+        Serial.println(F("  Mode: Access Point (AP)"));
+        Serial.print(F("  SSID: ")); Serial.println(ssid);
+        Serial.print(F("  Password: ")); Serial.println(password);
+        Serial.print(F("  IP Address: ")); Serial.println(espAPIP);
+        Serial.print(F("  Clients connected: ")); Serial.println(clientCount);
+    } else if (mode == WIFI_MODE_STA) {
+        Serial.println(F("  Mode: Station (STA)"));
+        Serial.print(F("  Connected to: ")); Serial.println(WiFi.SSID());
+        Serial.print(F("  IP Address: ")); Serial.println(WiFi.localIP());
+        Serial.print(F("  RSSI: ")); Serial.print(WiFi.RSSI()); Serial.println(" dBm");
+    } else {
+        Serial.println(F("  Status: ❌ Wi-Fi is OFF"));
+    }
+
+    // Optional: show time since enabled
+    static unsigned long wifiStartMillis = millis();
+    unsigned long uptimeSec = (millis() - wifiStartMillis) / 1000;
+    Serial.printf("  Wi-Fi Uptime: %lu seconds\n", uptimeSec);
+    return true;
+}
+
+// ============= STATE COMMANDS ===================
+
+static bool cmdStateGet(const CliCall&) {
+    SystemState s = getCurrentState();
+    Serial.printf("📟 Current system state: %s (full CLI %s, Wi-Fi %s, servo follow %s, %s RPM)\n",
+                  getCurrentStateName(),
+                  stateHasCapability(s, STATE_CAP_CLI) ? "yes" : "no",
+                  stateHasCapability(s, STATE_CAP_WIFI) ? "on" : "off",
+                  stateHasCapability(s, STATE_CAP_FOLLOW) ? "on" : "off",
+                  stateHasCapability(s, STATE_CAP_SENSOR_RPM) ? "sensor" : "manual");
+    return true;
+}
+
+static bool cmdStateSet(const CliCall& c) {
+    SystemState target;
+    if (!parseStateName(c.argv[0], target)) return false;
+    if (setState(target)) {
+        Serial.printf("✅ State switched to: %s\n", getCurrentStateName());
+    }
+    return true;  // Unchanged or rejected: setState() has said why, or there was nothing to do
+}
+
+static bool cmdStateHistory(const CliCall&) {
+    printStateHistory();
+    return true;
+}
+
+static bool cmdStatePinGet(const CliCall&) {
+    Serial.printf("📍 Current button pin: GPIO %d\n", getModeSwitchButtonPin());
+    return true;
+}
+
+static bool cmdStatePinSet(const CliCall& c) {
+    int pin;
+    if (!argInt(c, 0, 1, 39, pin)) return false;
+    setModeSwitchButtonPin(pin);
+    storePinAssignments();
+    initModeButtonInterrupt();  // Reattach interrupt to the new pin
+    Serial.printf("📍 Button pin set to GPIO %d and interrupt attached.\n", pin);
+    return true;
+}
+
+static bool cmdStateList(const CliCall&) {
+    Serial.println("🧭 Valid system modes:");
+    Serial.println("  - race");
+    Serial.println("  - diagnostics");
+    Serial.println("  - config");
+    Serial.println("  - off");
+    return true;
+}
+
+// ============== PIN COMMANDS ===================
+
+static bool cmdMovementPinGet(const CliCall&) {
+    Serial.printf("📍 Current movement pin: GPIO %d\n", getMovementPin());
+    return true;
+}
+
+static bool cmdMovementPinSet(const CliCall& c) {
+    int pin;
+    if (!argInt(c, 0, 1, 39, pin)) return false;
+    setMovementPin(pin);
+    storePinAssignments();
+    initMovementPin();
+    Serial.printf("📍 Movement pin set to GPIO %d and initialized.\n", pin);
+    return true;
+}
+
+static bool cmdMovementPinRead(const CliCall&) {
+    Serial.printf("Movement pin status: %d\n", getMovementPinState());
+    return true;
+}
+
+static bool cmdMarkPinGet(const CliCall&) {
+    Serial.printf("📍 Current mark pin: GPIO %d\n", getMarkPin());
+    return true;
+}
+
+static bool cmdMarkPinSet(const CliCall& c) {
+    int pin;
+    if (!argInt(c, 0, 1, 39, pin)) return false;
+    setMarkPin(pin);
+    storePinAssignments();
+    initMarkPin();
+    Serial.printf("📍 Mark pin set to GPIO %d and initialized.\n", pin);
+    return true;
+}
+
+static bool cmdPinClear(const CliCall& c) {
+    int pin;
+    if (!argInt(c, 0, 0, 39, pin)) return false;
+    clearInterruptPin(pin);
+    return true;
+}
+
+static bool cmdPinStatus(const CliCall&) {
+    Serial.println(F("\n========= 📊 PIN STATUS =========\n"));
+
+    // RPM interrupt pin
+    Serial.print(F("Interrupt pin for RPM read: "));
+    Serial.println(getRpmPin());
+
+    // Button pin for changing states
+    Serial.print(F("Button pin for changing states: "));
+    Serial.println(getModeSwitchButtonPin());
+
+    // Button pin for viewing system status
+    Serial.printf("Button pin for viewing system status: %d\n", STATUS_BUTTON);
+
+    // Rx/Tx pins used for servo communication
+    Serial.printf("Rx/Tx pins used for servo communication: RX: %d, TX: %d\n", SERVO_RX, SERVO_TX);
+
+    // Pin for servo position
+    Serial.print(F("Pin for servo position: "));
+    Serial.println(getMovementPin());
+
+    // === COMPLETION ===
+    Serial.println(F("\n===========================================\n"));
+    return true;
+}
+
+// ============== MISC COMMANDS ===================
+
+static bool cmdStatus(const CliCall&) {
+    Serial.println(F("\n========= 📊 SYSTEM STATUS REPORT =========\n"));
+
+    // === SYSTEM MODE ===
+    Serial.print(F("🧭 Mode: "));
+    Serial.println(getCurrentStateName());
+
+    // === BUTTON ===
+    Serial.print(F("🔘 Mode Switch Pin: GPIO "));
+    Serial.println(getModeSwitchButtonPin());
+
+    // === RPM ===
+    Serial.println(F("\n📈 RPM Subsystem"));
+    Serial.printf("  Source: %s\n", getRPMSourceName());
+    Serial.printf("  Value: %.2f RPM\n", getRPMUnified());
+    Serial.printf("  Sensor Pin: GPIO %d\n", getRpmPin());
+
+    // === SERVO ===
+    Serial.println(F("\n🦾 Servo Subsystem"));
+    Serial.printf("  RX Pin: GPIO %d\n", SERVO_RX);
+    Serial.printf("  TX Pin: GPIO %d\n", SERVO_TX);
+    Serial.printf("  Following RPM: %s\n", servoFollowingEnabled ? "✅ YES" : "❌ NO");
+    Serial.printf("  Current Angle: %d°\n", getServoAngle());
+    Serial.println("  Range → Position Mapping:");
+    for (int i = 0; i < numRanges; ++i) {
+        Serial.printf("    [%5d – %5d] RPM → Pos: %4d\n",
+                      modeRanges[i][0], modeRanges[i][1], modeServoPositions[i]);
+    }
+
+    // === WIFI ===
+    Serial.println(F("\n📡 Wi-Fi Subsystem"));
+
+    wifi_mode_t mode = WiFi.getMode();
+    int clientCount = WiFi.softAPgetStationNum();
+    String mac = WiFi.softAPmacAddress();
+
+    Serial.printf("  MAC Address: %s\n", mac.c_str());
+    showTxPower();
+
+    if (!isWiFiOn()) {
+        Serial.println(F("  Status: ❌ Wi-Fi is OFF"));
+    } else if (mode == WIFI_MODE_AP) {
+        Serial.println(F("  Mode: Access Point (AP)"));
+        Serial.print(F("  SSID: ")); Serial.println(ssid);
+        Serial.print(F("  Password: ")); Serial.println(password);
+        Serial.print(F("  IP Address: ")); Serial.println(espAPIP);
+        Serial.print(F("  Clients Connected: ")); Serial.println(clientCount);
+    } else if (mode == WIFI_MODE_STA) {
+        Serial.println(F("  Mode: Station (STA)"));
+        Serial.print(F("  Connected to: ")); Serial.println(WiFi.SSID());
+        Serial.print(F("  IP Address: ")); Serial.println(WiFi.localIP());
+        Serial.print(F("  RSSI: ")); Serial.print(WiFi.RSSI()); Serial.println(" dBm");
+    } else {
+        Serial.println(F("  Status: ❌ OFF"));
+    }
+
+    // === COMPLETION ===
+    Serial.println(F("\n===========================================\n"));
+    return true;
+}
+
+static bool cmdBoot(const CliCall&) {
+    printBootTimeline();
+    return true;
+}
+
+static bool cmdVersion(const CliCall&) {
+    Serial.print("Current System Version: ");
+    Serial.println(SYSTEM_VERSION);
+    return true;
+}
+
+static bool cmdHelp(const CliCall&) {
+    printMenu();
+    return true;
+}
+
+static bool cmdPinout(const CliCall&) {
+    printPinout();
+    return true;
+}
+
+static bool cmdReset(const CliCall&) {
+    ESP.restart();
+    return true;
+}
+
+static bool cmdCliBench(const CliCall& c);
+
+// ===== Command table =====
+// Rows are matched on their full name, longest first, so "servo init
+// default" wins over "servo init <rx> <tx>". Rows without usage text are
+// aliases that stay out of the menu.
+
+#define CLI_SECTION(title) { title, 0, 0, 0, 0, nullptr, nullptr, nullptr }
+#define CLI_CMD(name, minArgs, maxArgs, states, handler, usage, help) \
+    { name, cliHash(name), minArgs, maxArgs, states, handler, usage, help }
+
+static constexpr CliCommand CLI_COMMANDS[] = {
+    CLI_SECTION("\n🔧 NVS COMMANDS"),
+    CLI_CMD("nvs store", 1, CLI_MAX_TOKENS, CLI_CONFIG_ONLY, cmdNvsStore, "nvs store <thresholds>", "Store servo RPM thresholds"),
+    CLI_CMD("nvs list", 0, 0, CLI_CONFIG_ONLY, cmdNvsList, "nvs list", "List ALL stored values in storage"),
+    CLI_CMD("nvs reset", 0, 0, CLI_CONFIG_ONLY, cmdNvsReset, "nvs reset", "Reset and restore default ranges"),
+    CLI_CMD("nvs map", 0, 0, CLI_CONFIG_ONLY, cmdRangeMap, "nvs map", "Show range → servo mapping"),
+
+    CLI_SECTION("\n📈 RPM COMMANDS"),
+    CLI_CMD("rpm read", 0, 0, CLI_IN(DIAGNOSTICS), cmdRpmRead, "rpm read", "Show current RPM and source"),
+    CLI_CMD("rpm set", 1, 1, CLI_CONFIG_ONLY, cmdRpmSet, "rpm set <value>", "Manually set RPM"),
+    CLI_CMD("rpm source", 1, 1, CLI_CONFIG_ONLY, cmdRpmSource, "rpm source <sensor|sim|manual>", "Change RPM input source"),
+    CLI_CMD("rpm live", 0, 6, CLI_IN(DIAGNOSTICS), cmdRpmLive, "rpm live [hz] [fields]", "Stream rpm|filt|mode|pos|move|all at 1–1000 Hz (any key stops)"),
+    CLI_CMD("rpm live bin", 0, 1, CLI_IN(DIAGNOSTICS), cmdRpmLiveBin, "rpm live bin [hz]", "Binary COBS frames (decode with tools/telemetry_decode.py)"),
+    CLI_CMD("rpm pin get", 0, 0, CLI_CONFIG_ONLY, cmdRpmPinGet, "rpm pin get", "Show RPM sensor pin"),
+    CLI_CMD("rpm pin set", 1, 1, CLI_CONFIG_ONLY, cmdRpmPinSet, "rpm pin set <pin>", "Set RPM sensor pin"),
+
+    CLI_SECTION("\n🦾 SERVO COMMANDS"),
+    CLI_CMD("servo set", 1, 1, CLI_IN(DIAGNOSTICS), cmdServoSet, "servo set <angle>", "Set servo to angle (0–360°)"),
+    CLI_CMD("servo get", 0, 0, CLI_IN(DIAGNOSTICS), cmdServoGet, "servo get", "Get current servo angle"),
+    CLI_CMD("servo sweep", 4, 4, CLI_IN(DIAGNOSTICS), cmdServoSweep, "servo sweep <f> <t> <s> <d>", "Sweep servo (from–to, step, delay)"),
+    CLI_CMD("servo full", 0, 0, CLI_IN(DIAGNOSTICS), cmdServoFull, "servo full", "0→360° sweep (no return)"),
+    CLI_CMD("servo fullcircle", 0, 0, CLI_IN(DIAGNOSTICS), cmdServoFullCircle, "servo fullcircle", "0→360°→0° sweep"),
+    CLI_CMD("servo reset", 0, 0, CLI_IN(DIAGNOSTICS), cmdServoReset, "servo reset", "Reset servo to 0°"),
+    CLI_CMD("servo follow", 0, 0, CLI_CONFIG_ONLY, cmdServoFollow, "servo follow", "Enable servo RPM following"),
+    CLI_CMD("servo unfollow", 0, 0, CLI_CONFIG_ONLY, cmdServoUnfollow, "servo unfollow", "Disable servo tracking"),
+    CLI_CMD("servo init default", 0, 0, CLI_CONFIG_ONLY, cmdServoInitDefault, "servo init default", "Init servo UART with default pins"),
+    CLI_CMD("servo init", 2, 2, CLI_CONFIG_ONLY, cmdServoInit, "servo init <rx> <tx>", "Init servo with custom UART pins"),
+    CLI_CMD("servo positions set", 0, 0, CLI_CONFIG_ONLY, cmdServoPositionsSet, "servo positions set", "Manually set servo positions per range"),
+    CLI_CMD("servo map", 0, 0, CLI_CONFIG_ONLY, cmdRangeMap, "servo map", "Show active RPM→position mapping"),
+    CLI_CMD("servo rpm", 0, 0, CLI_CONFIG_ONLY, cmdServoRpm, "servo rpm", "Print position for current RPM"),
+    CLI_CMD("servo status", 0, 0, CLI_IN(DIAGNOSTICS), cmdServoStatus, "servo status", "Print servo config and state"),
+    CLI_CMD("servo telemetry", 0, 0, CLI_IN(DIAGNOSTICS), cmdServoTelemetry, "servo telemetry", "Show cached position/speed/load/voltage/temp"),
+    CLI_CMD("servo poll", 0, 1, CLI_CONFIG_ONLY, cmdServoPoll, "servo poll [hz]", "Show or set telemetry poll rate (0 = off)"),
+    CLI_CMD("servo latency", 0, 0, CLI_IN(DIAGNOSTICS), cmdServoLatency, "servo latency", "Show command→in-position latency per transition"),
+    CLI_CMD("servo latency reset", 0, 0, CLI_CONFIG_ONLY, cmdServoLatencyReset, "servo latency reset", "Clear latency statistics"),
+    CLI_CMD("servo bus", 0, 0, CLI_CONFIG_ONLY, cmdServoBus, "servo bus", "Show servo bus transaction counters"),
+    CLI_CMD("servo bench", 0, 1, CLI_CONFIG_ONLY, cmdServoBench, "servo bench [n]", "Benchmark bus reads/writes (default 200)"),
+    CLI_CMD("servo calibrate", 0, 0, CLI_CONFIG_ONLY, cmdServoCalibrate, "servo calibrate", "Find end stops via load feedback, regenerate positions"),
+    CLI_CMD("servo calibrate show", 0, 0, CLI_CONFIG_ONLY, cmdServoCalibrateShow, "servo calibrate show", "Show measured end stops"),
+    CLI_CMD("servo calibrate clear", 0, 0, CLI_CONFIG_ONLY, cmdServoCalibrateClear, "servo calibrate clear", "Forget end stops (use rack/pinion estimate)"),
+
+    CLI_SECTION("\n🏎️ MOTION COMMANDS"),
+    CLI_CMD("motion show", 0, 0, CLI_CONFIG_ONLY, cmdMotionShow, "motion show", "Show speed/acc profile per mode transition"),
+    CLI_CMD("motion set", 4, 4, CLI_CONFIG_ONLY, cmdMotionSet, "motion set <f> <t> <spd> <acc>", "Set profile for transition f→t"),
+    CLI_CMD("motion tune", 2, 2, CLI_CONFIG_ONLY, cmdMotionTune, "motion tune <f> <t>", "Auto-tune transition f→t from servo feedback"),
+    CLI_CMD("motion tune all", 0, 0, CLI_CONFIG_ONLY, cmdMotionTuneAll, "motion tune all", "Auto-tune every transition"),
+    CLI_CMD("motion reset", 0, 0, CLI_CONFIG_ONLY, cmdMotionReset, "motion reset", "Restore default profiles"),
+
+    CLI_SECTION("\n🦾 ACTUATOR COMMANDS"),
+    CLI_CMD("actuator list", 0, 0, CLI_CONFIG_ONLY, cmdActuatorList, "actuator list", "Show IDs, offsets, mechanics and positions"),
+    CLI_CMD("actuator add", 1, 1, CLI_CONFIG_ONLY, cmdActuatorAdd, "actuator add <id>", "Add a servo stack with its bus ID"),
+    CLI_CMD("actuator remove", 1, 1, CLI_CONFIG_ONLY, cmdActuatorRemove, "actuator remove <i>", "Remove actuator i (not 0)"),
+    CLI_CMD("actuator set", 3, 3, CLI_CONFIG_ONLY, cmdActuatorSet, "actuator set <i> <id|offset|rack|pinion> <v>", "Change a setting"),
+    CLI_CMD("actuator positions", 2, CLI_MAX_TOKENS, CLI_CONFIG_ONLY, cmdActuatorPositions, "actuator positions <i> <p1> <p2> ...", "Set per-mode positions"),
+    CLI_CMD("actuator generate", 1, 1, CLI_CONFIG_ONLY, cmdActuatorGenerate, "actuator generate <i>", "Spread positions over the travel"),
+    CLI_CMD("actuator skew", 0, 0, CLI_CONFIG_ONLY, cmdActuatorSkew, "actuator skew", "Show arrival skew of group moves"),
+
+    CLI_SECTION("\n⏱️ CONTROL LOOP COMMANDS"),
+    CLI_CMD("control stats", 0, 0, CLI_IN(DIAGNOSTICS), cmdControlStats, "control stats", "Show cycle time, jitter and overruns"),
+    CLI_CMD("control rate", 0, 1, CLI_CONFIG_ONLY, cmdControlRate, "control rate [hz]", "Show or set the control loop rate"),
+    CLI_CMD("control hysteresis", 0, 1, CLI_CONFIG_ONLY, cmdControlHysteresis, "control hysteresis [rpm]", "Show or set mode boundary hysteresis"),
+    CLI_CMD("control reset", 0, 0, CLI_CONFIG_ONLY, cmdControlReset, "control reset", "Clear cycle statistics"),
+
+    CLI_SECTION("\n📊 PROFILER COMMANDS"),
+    CLI_CMD("perf show", 0, 0, CLI_IN(DIAGNOSTICS), cmdPerfShow, "perf show", "Per-probe count/min/avg/max and histogram"),
+    CLI_CMD("perf reset", 0, 0, CLI_CONFIG_ONLY, cmdPerfReset, "perf reset", "Clear profiler statistics"),
+    CLI_CMD("perf on", 0, 0, CLI_CONFIG_ONLY, cmdPerfOnOff, "perf on|off", "Enable or pause the timing probes"),
+    CLI_CMD("perf off", 0, 0, CLI_CONFIG_ONLY, cmdPerfOnOff, nullptr, nullptr),
+
+    CLI_SECTION("\n🧵 TRACE COMMANDS"),
+    CLI_CMD("trace dump", 0, 0, CLI_IN(DIAGNOSTICS), cmdTraceDump, "trace dump", "Stream the event ring in the background (decode with tools/trace2chrome.py)"),
+    CLI_CMD("trace clear", 0, 0, CLI_CONFIG_ONLY, cmdTraceClear, "trace clear", "Drop recorded events"),
+    CLI_CMD("trace on", 0, 0, CLI_CONFIG_ONLY, cmdTraceOnOff, "trace on|off", "Start or pause recording"),
+    CLI_CMD("trace off", 0, 0, CLI_CONFIG_ONLY, cmdTraceOnOff, nullptr, nullptr),
+    CLI_CMD("trace isr on", 0, 0, CLI_CONFIG_ONLY, cmdTraceIsr, "trace isr on|off", "Include or skip per-edge RPM events"),
+    CLI_CMD("trace isr off", 0, 0, CLI_CONFIG_ONLY, cmdTraceIsr, nullptr, nullptr),
+    CLI_CMD("trace mark", 1, 1, CLI_IN(DIAGNOSTICS), cmdTraceMark, "trace mark <n>", "Add a numbered marker to the timeline"),
+
+    CLI_SECTION("\n⚙️ MECHANICAL CONFIGURATION"),
+    CLI_CMD("rack get", 0, 0, CLI_CONFIG_ONLY, cmdRackGet, "rack get", "Show current rack length (mm)"),
+    CLI_CMD("rack set", 1, 1, CLI_CONFIG_ONLY, cmdRackSet, "rack set <length_mm>", "Set rack length in mm"),
+    CLI_CMD("pinion get", 0, 0, CLI_CONFIG_ONLY, cmdPinionGet, "pinion get", "Show current pinion radius (mm)"),
+    CLI_CMD("pinion set", 1, 1, CLI_CONFIG_ONLY, cmdPinionSet, "pinion set <radius_mm>", "Set pinion gear radius in mm"),
+
+    CLI_SECTION("\n📶 WIFI COMMANDS"),
+    CLI_CMD("wifi enable", 0, 0, CLI_CONFIG_ONLY, cmdWifiEnable, "wifi enable", "Start Wi-Fi in AP mode"),
+    CLI_CMD("wifi disable", 0, 0, CLI_CONFIG_ONLY, cmdWifiDisable, "wifi disable", "Disable Wi-Fi"),
+    CLI_CMD("wifi ip", 0, 0, CLI_IN(DIAGNOSTICS), cmdWifiIp, "wifi ip", "Show AP IP address"),
+    CLI_CMD("wifi txpower", 0, 1, CLI_CONFIG_ONLY, cmdWifiTxPower, "wifi txpower [dBm]", "Show or set TX power"),
+    CLI_CMD("wifi mac", 0, 0, CLI_CONFIG_ONLY, cmdWifiMac, "wifi mac", "Print MAC address"),
+    CLI_CMD("wifi clients", 0, 0, CLI_IN(DIAGNOSTICS), cmdWifiClients, "wifi clients", "Show number of connected clients"),
+    CLI_CMD("wifi status", 0, 0, CLI_IN(DIAGNOSTICS), cmdWifiStatus, "wifi status", "Show full Wi-Fi status"),
+    CLI_CMD("wifi radio", 0, 0, CLI_IN(DIAGNOSTICS), cmdWifiRadio, "wifi radio", "Show Wi-Fi on/off transition times"),
+    CLI_CMD("wifi http", 0, 0, CLI_IN(DIAGNOSTICS), cmdWifiHttp, "wifi http", "Show request latency per HTTP route"),
+    CLI_CMD("wifi http reset", 0, 0, CLI_CONFIG_ONLY, cmdWifiHttpReset, "wifi http reset", "Clear HTTP statistics"),
+    CLI_CMD("wifi events", 0, 0, CLI_IN(DIAGNOSTICS), cmdWifiEvents, "wifi events", "Show live event stream clients"),
+    CLI_CMD("wifi udp", 0, 0, CLI_IN(DIAGNOSTICS), cmdWifiUdp, "wifi udp", "Show UDP telemetry settings and counters"),
+    CLI_CMD("wifi udp on", 0, 2, CLI_IN(DIAGNOSTICS), cmdWifiUdpOn, "wifi udp on [hz] [broadcast|multicast]", "Send UDP telemetry in diagnostics mode"),
+    CLI_CMD("wifi udp off", 0, 0, CLI_IN(DIAGNOSTICS), cmdWifiUdpOff, "wifi udp off", "Stop UDP telemetry"),
+
+    CLI_SECTION("\n🧭 STATE COMMANDS"),
+    CLI_CMD("state get", 0, 0, CLI_ANY_STATE, cmdStateGet, "state get", "Show current system state"),
+    CLI_CMD("state set", 1, 1, CLI_ANY_STATE, cmdStateSet, "state set <race|diagnostics|config|off>", "Change system state"),
+    CLI_CMD("state history", 0, 0, CLI_ANY_STATE, cmdStateHistory, "state history", "Recent transitions with their latency"),
+    CLI_CMD("state pin get", 0, 0, CLI_ANY_STATE, cmdStatePinGet, "state pin get", "Get button pin used for state switching"),
+    CLI_CMD("state pin set", 1, 1, CLI_ANY_STATE, cmdStatePinSet, "state pin set <pin>", "Set button pin and reattach interrupt"),
+    CLI_CMD("state list", 0, 0, CLI_ANY_STATE, cmdStateList, "state list", "Show all valid system states"),
+
+    CLI_SECTION("\n📌 PIN COMMANDS"),
+    CLI_CMD("movement pin get", 0, 0, CLI_CONFIG_ONLY, cmdMovementPinGet, "movement pin get", "Show current movement pin"),
+    CLI_CMD("movement pin set", 1, 1, CLI_CONFIG_ONLY, cmdMovementPinSet, "movement pin set <pin>", "Change movement pin and reinitialize"),
+    CLI_CMD("movement pin read", 0, 0, CLI_CONFIG_ONLY, cmdMovementPinRead, "movement pin read", "Read logic level of movement pin"),
+    CLI_CMD("mark pin get", 0, 0, CLI_CONFIG_ONLY, cmdMarkPinGet, "mark pin get", "Show current mark pin"),
+    CLI_CMD("mark pin set", 1, 1, CLI_CONFIG_ONLY, cmdMarkPinSet, "mark pin set <pin>", "Change mark pin and reinitialize"),
+    CLI_CMD("pin clear", 1, 1, CLI_CONFIG_ONLY, cmdPinClear, "pin clear <pin>", "Detach interrupts and disable pin"),
+    CLI_CMD("pin status", 0, 0, CLI_CONFIG_ONLY, cmdPinStatus, "pin status", "Display all GPIO pin assignments"),
+
+    CLI_SECTION("\n🧰 MISC COMMANDS"),
+    CLI_CMD("status", 0, 0, CLI_ANY_STATE, cmdStatus, "status", "Full system status report"),
+    CLI_CMD("boot", 0, 0, CLI_ANY_STATE, cmdBoot, "boot", "Show boot phase timestamps"),
+    CLI_CMD("version", 0, 0, CLI_CONFIG_ONLY, cmdVersion, "version", "Show system version"),
+    CLI_CMD("pinout", 0, 0, CLI_CONFIG_ONLY, cmdPinout, "pinout", "Show pinout of board"),
+    CLI_CMD("reset", 0, 0, CLI_CONFIG_ONLY, cmdReset, "reset", "Reset the board, just like pressing the RST button"),
+    CLI_CMD("cli bench", 0, 1, CLI_CONFIG_ONLY, cmdCliBench, "cli bench [n]", "Time command lookup over the whole table"),
+    CLI_CMD("help", 0, 0, CLI_CONFIG_ONLY, cmdHelp, "help", "Show this command menu"),
+};
+
+#define CLI_COMMAND_COUNT (sizeof(CLI_COMMANDS) / sizeof(CLI_COMMANDS[0]))
+static_assert(CLI_COMMAND_COUNT < 0xFF, "Row indices are stored as uint8_t");
+static_assert(CLI_COMMAND_COUNT < CLI_INDEX_SIZE / 2, "Keep the hash index at most half full");
+
+// ===== Lookup =====
+
+static uint8_t cliIndex[CLI_INDEX_SIZE];  // Row + 1, 0 = empty slot
+
+void initCLI() {
+    memset(cliIndex, 0, sizeof(cliIndex));
+    for (uint8_t row = 0; row < CLI_COMMAND_COUNT; ++row) {
+        const CliCommand& cmd = CLI_COMMANDS[row];
+        if (!cmd.handler) continue;
+
+        uint32_t slot = cmd.hash & (CLI_INDEX_SIZE - 1);
+        while (cliIndex[slot]) {
+            if (CLI_COMMANDS[cliIndex[slot] - 1].hash == cmd.hash) {
+                Serial.printf("⚠️ CLI: '%s' has the same hash as '%s' and is unreachable\n",
+                              cmd.name, CLI_COMMANDS[cliIndex[slot] - 1].name);
             }
+            slot = (slot + 1) & (CLI_INDEX_SIZE - 1);
         }
+        cliIndex[slot] = row + 1;
+    }
+}
 
-        else if (input == "movement pin read") {
-            Serial.printf("Movement pin status: %d\n", getMovementPinState());
-        }
+// True if the first 'words' tokens spell the row's name exactly
+static bool nameMatches(const char* name, const char* const* argv, uint8_t words) {
+    for (uint8_t i = 0; i < words; ++i) {
+        size_t len = strlen(argv[i]);
+        if (strncmp(name, argv[i], len) != 0) return false;
+        name += len;
+        if (*name != (i + 1 < words ? ' ' : '\0')) return false;
+        name++;
+    }
+    return true;
+}
+
+static const CliCommand* lookupCommand(uint32_t hash, const char* const* argv, uint8_t words) {
+    uint32_t slot = hash & (CLI_INDEX_SIZE - 1);
+    while (cliIndex[slot]) {
+        const CliCommand* cmd = &CLI_COMMANDS[cliIndex[slot] - 1];
+        if (cmd->hash == hash && nameMatches(cmd->name, argv, words)) return cmd;
+        slot = (slot + 1) & (CLI_INDEX_SIZE - 1);
+    }
+    return nullptr;
+}
+
+// Finds the row with the longest name that prefixes the tokens
+static const CliCommand* findCommand(const char* const* argv, uint8_t argc, uint8_t& words) {
+    uint32_t hashes[CLI_MAX_WORDS];
+    uint8_t n = argc < CLI_MAX_WORDS ? argc : CLI_MAX_WORDS;
+
+    uint32_t h = CLI_HASH_SEED;
+    for (uint8_t i = 0; i < n; ++i) {
+        if (i > 0) h = cliHashStep(h, ' ');
+        for (const char* p = argv[i]; *p; ++p) h = cliHashStep(h, *p);
+        hashes[i] = h;
+    }
+
+    for (words = n; words > 0; --words) {
+        const CliCommand* cmd = lookupCommand(hashes[words - 1], argv, words);
+        if (cmd) return cmd;
+    }
+    return nullptr;
+}
+
+static bool isCommandAllowed(const CliCommand& cmd, SystemState state) {
+    if (stateHasCapability(state, STATE_CAP_CLI)) return true;
+    return cmd.states & (1 << static_cast<int>(state));
+}
+
+static void dispatchCommand(const CliArgs& args) {
+    uint8_t words;
+    const CliCommand* cmd = findCommand(args.argv, args.argc, words);
+    if (!cmd) {
+        Serial.println("❌ Unknown command. Type 'help' to see available commands.");
+        return;
+    }
+
+    if (!isCommandAllowed(*cmd, getCurrentState())) {
+        Serial.println("⚠️ CLI is restricted. Switch to CONFIG mode to access full commands.");
+        return;
+    }
+
+    CliCall call = { cmd, args.argv + words, (uint8_t)(args.argc - words) };
+    if (call.argc < cmd->minArgs || call.argc > cmd->maxArgs || !cmd->handler(call)) {
+        Serial.printf("❌ Usage: %s\n", cmd->usage ? cmd->usage : cmd->name);
+    }
+}
+
+// ===== Lookup benchmark =====
+// Times findCommand() for the name of every row, against a linear
+// prefix scan over the same rows as the old if/else chain did.
+
+static bool cmdCliBench(const CliCall& c) {
+    int iterations = 100;
+    if (c.argc > 0 && !argInt(c, 0, 1, 10000, iterations)) return false;
+
+    uint32_t hashTotal = 0, hashMax = 0, scanTotal = 0, scanMax = 0;
+    const char* slowest = "";
+    int commands = 0;
 
-        else if (input == "mark pin get") {
-            Serial.printf("📍 Current mark pin: GPIO %d\n", getMarkPin());
+    for (uint8_t row = 0; row < CLI_COMMAND_COUNT; ++row) {
+        const CliCommand& cmd = CLI_COMMANDS[row];
+        if (!cmd.handler) continue;
+
+        // Split the name the way the line reader would
+        char buf[CLI_LINE_MAX];
+        strlcpy(buf, cmd.name, sizeof(buf));
+        const char* argv[CLI_MAX_WORDS];
+        uint8_t argc = 0;
+        for (char* tok = strtok(buf, " "); tok && argc < CLI_MAX_WORDS; tok = strtok(nullptr, " ")) {
+            argv[argc++] = tok;
         }
 
-        else if (input.startsWith("mark pin set ")) {
-            int pin = input.substring(13).toInt();  // skip "mark pin set "
-            if (pin <= 0 || pin >= 40) {
-                Serial.println("❌ Invalid GPIO number.");
-            } else {
-                setMarkPin(pin);
-                storePinAssignments();
-                initMarkPin();                
-                Serial.printf("📍 Mark pin set to GPIO %d and initialized.\n", pin);
+        uint8_t words;
+        uint32_t start = ESP.getCycleCount();
+        for (int i = 0; i < iterations; ++i) {
+            if (findCommand(argv, argc, words) != &cmd) {
+                Serial.printf("❌ '%s' resolved to another row\n", cmd.name);
+                return true;
             }
         }
+        uint32_t hashCycles = (ESP.getCycleCount() - start) / iterations;
 
-        else if (input.startsWith("pin clear ")) {
-            int pin = input.substring(10).toInt();  // skip "pin clear "
-            clearInterruptPin(pin);
+        start = ESP.getCycleCount();
+        for (int i = 0; i < iterations; ++i) {
+            for (uint8_t r = 0; r < CLI_COMMAND_COUNT; ++r) {
+                const char* name = CLI_COMMANDS[r].name;
+                if (CLI_COMMANDS[r].handler && strncmp(cmd.name, name, strlen(name)) == 0) break;
+            }
         }
+        uint32_t scanCycles = (ESP.getCycleCount() - start) / iterations;
 
-        else if (input == "pin status") {
-            Serial.println(F("\n========= 📊 PIN STATUS =========\n"));
-
-            // RPM interrupt pin
-            Serial.print(F("Interrupt pin for RPM read: "));
-            Serial.println(getRpmPin());
-            
-            // Button pin for changing states
-            Serial.print(F("Button pin for changing states: "));
-            Serial.println(getModeSwitchButtonPin());
-
-            // Button pin for viewing system status
-            Serial.printf("Button pin for viewing system status: %d\n", STATUS_BUTTON);
-            
-            // Rx/Tx pins used for servo communication
-            Serial.printf("Rx/Tx pins used for servo communication: RX: %d, TX: %d\n", SERVO_RX, SERVO_TX);
-            
-            // Pin for servo position
-            Serial.print(F("Pin for servo position: "));
-            Serial.println(getMovementPin());
-
-            // === COMPLETION ===
-            Serial.println(F("\n===========================================\n"));
+        hashTotal += hashCycles;
+        scanTotal += scanCycles;
+        if (hashCycles > hashMax) {
+            hashMax = hashCycles;
+            slowest = cmd.name;
         }
+        if (scanCycles > scanMax) scanMax = scanCycles;
+        commands++;
+    }
 
-        // ============== MISC COMMANDS ===================     
-        
-        else if (input == "status") {
-            Serial.println(F("\n========= 📊 SYSTEM STATUS REPORT =========\n"));
-        
-            // === SYSTEM MODE ===
-            Serial.print(F("🧭 Mode: "));
-            Serial.println(getCurrentStateName());
-        
-            // === BUTTON ===
-            Serial.print(F("🔘 Mode Switch Pin: GPIO "));
-            Serial.println(getModeSwitchButtonPin());
-        
-            // === RPM ===
-            Serial.println(F("\n📈 RPM Subsystem"));
-            Serial.printf("  Source: %s\n", getRPMSourceName());
-            Serial.printf("  Value: %.2f RPM\n", getRPMUnified());
-            Serial.printf("  Sensor Pin: GPIO %d\n", getRpmPin());
-        
-            // === SERVO ===
-            Serial.println(F("\n🦾 Servo Subsystem"));
-            Serial.printf("  RX Pin: GPIO %d\n", SERVO_RX);
-            Serial.printf("  TX Pin: GPIO %d\n", SERVO_TX);
-            Serial.printf("  Following RPM: %s\n", servoFollowingEnabled ? "✅ YES" : "❌ NO");
-            Serial.printf("  Current Angle: %d°\n", getServoAngle());
-            Serial.println("  Range → Position Mapping:");
-            for (int i = 0; i < numRanges; ++i) {
-                Serial.printf("    [%5d – %5d] RPM → Pos: %4d\n",
-                              modeRanges[i][0], modeRanges[i][1], modeServoPositions[i]);
-            }
-        
-            // === WIFI ===
-            Serial.println(F("\n📡 Wi-Fi Subsystem"));
-        
-            wifi_mode_t mode = WiFi.getMode();
-            int clientCount = WiFi.softAPgetStationNum();
-            float txPower = WiFi.getTxPower();
-            String mac = WiFi.softAPmacAddress();
-        
-            Serial.printf("  MAC Address: %s\n", mac.c_str());
-            showTxPower();
-        
-            if (mode == WIFI_MODE_AP) {
-                Serial.println(F("  Mode: Access Point (AP)"));
-                Serial.print(F("  SSID: ")); Serial.println(ssid);
-                Serial.print(F("  Password: ")); Serial.println(password);
-                Serial.print(F("  IP Address: ")); Serial.println(espAPIP);
-                Serial.print(F("  Clients Connected: ")); Serial.println(clientCount);
-            } else if (mode == WIFI_MODE_STA) {
-                Serial.println(F("  Mode: Station (STA)"));
-                Serial.print(F("  Connected to: ")); Serial.println(WiFi.SSID());
-                Serial.print(F("  IP Address: ")); Serial.println(WiFi.localIP());
-                Serial.print(F("  RSSI: ")); Serial.print(WiFi.RSSI()); Serial.println(" dBm");
-            } else {
-                Serial.println(F("  Status: ❌ OFF"));
-            }
-        
-            // === COMPLETION ===
-            Serial.println(F("\n===========================================\n"));
-        }
+    Serial.printf("⌨️ CLI lookup over %d commands, %d runs each\n", commands, iterations);
+    Serial.printf("  hash index : avg %.2f µs, max %.2f µs ('%s')\n",
+                  perfCyclesToUs(hashTotal / commands), perfCyclesToUs(hashMax), slowest);
+    Serial.printf("  linear scan: avg %.2f µs, max %.2f µs\n",
+                  perfCyclesToUs(scanTotal / commands), perfCyclesToUs(scanMax));
+    return true;
+}
 
-       else if (input == "version") {
-        Serial.print("Current System Version: ");
-        Serial.println(SYSTEM_VERSION);
-       } 
+// ===== Menu =====
 
-        else if (input == "help") {
-            printMenu();
-        }
+void printMenu() {
+    Serial.println(F("\n============= 📜 COMMAND MENU ============="));
 
-        else if (input == "pinout") {
-            printPinout();
+    for (uint8_t row = 0; row < CLI_COMMAND_COUNT; ++row) {
+        const CliCommand& cmd = CLI_COMMANDS[row];
+        if (!cmd.handler) {
+            Serial.println(cmd.name);
+        } else if (cmd.usage) {
+            Serial.printf("  %-26s – %s\n", cmd.usage, cmd.help);
         }
+    }
 
-        else if (input == "reset") {
-            ESP.restart();
-        }
+    Serial.println(F("\n===========================================\n"));
+}
 
-        else {
-            Serial.println("❌ Unknown command. Type 'help' to see available commands.");
-        }
+void handleCLI() {
+    // A trace dump owns the port until its END marker; input waits
+    if (isTraceDumpActive()) {
+        serviceTraceDump();
+        return;
+    }
+
+    // While streaming, the first key typed only cancels the stream
+    if (isLiveStreamActive() && Serial.available()) {
+        stopLiveStream();
+        while (Serial.available()) Serial.read();
+        cliReader.clear();
+        return;
     }
-}
\ No newline at end of file
+
+    bool lineReady = cliReader.poll(Serial);
+    if (cliReader.overflowed()) {
+        Serial.printf("❌ Line too long (max %d characters), ignored.\n", CLI_LINE_MAX - 1);
+    }
+    if (!lineReady) return;
+
+    if (wizardRange >= 0) {
+        handlePositionWizardLine(cliReader.line());
+        return;
+    }
+
+    PERF_SCOPE(PERF_CLI);
+    TRACE_SCOPE(TRACE_CLI);
+    dispatchCommand(cliReader.args());
+}
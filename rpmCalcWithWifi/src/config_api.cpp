@@ -0,0 +1,333 @@
+#include <Arduino.h>
+#include "../include/config_api.h"
+#include "../include/nvs_utils.h"
+#include "../include/servo.h"
+#include "../include/rpm.h"
+#include "../include/state.h"
+#include "../include/pin_utils.h"
+#include "../include/motion.h"
+#include "../include/calibration.h"
+
+// Same limits as the CLI setters
+#define CONFIG_MAX_HYSTERESIS 2000
+#define CONFIG_MAX_PIN 39
+#define CONFIG_MAX_SPEED 4000
+#define CONFIG_MAX_ACC 254
+
+struct ConfigPins {
+    int32_t rpm;
+    int32_t modeButton;
+    int32_t movement;
+    int32_t mark;
+    int32_t servoRx;
+    int32_t servoTx;
+};
+
+// Everything an update may change, checked in full before any of it
+// is applied
+struct StagedConfig {
+    int32_t numRanges;
+    int32_t ranges[MOTION_MAX_MODES][2];
+    int32_t positions[MOTION_MAX_MODES];
+    int32_t hysteresis;
+    float rackLength;
+    float pinionRadius;
+    ConfigPins pins;
+    MotionProfile profiles[MOTION_MAX_MODES][MOTION_MAX_MODES];
+};
+
+static const char* const TOP_KEYS[] = {
+    "version", "ranges", "positions", "hysteresis_rpm", "mechanical", "pins", "profiles"
+};
+
+static ConfigPins currentPins() {
+    return { getRpmPin(), getModeSwitchButtonPin(), getMovementPin(), getMarkPin(), SERVO_RX, SERVO_TX };
+}
+
+// Collects the first validation error
+struct ConfigCheck {
+    char* error;
+    size_t len;
+
+    bool fail(const char* fmt, ...) __attribute__((format(printf, 2, 3))) {
+        va_list args;
+        va_start(args, fmt);
+        vsnprintf(error, len, fmt, args);
+        va_end(args);
+        return false;
+    }
+
+    bool intIn(JsonVariant v, long lo, long hi, const char* what, int32_t& out) {
+        if (!v.is<long>() || v.as<long>() < lo || v.as<long>() > hi) {
+            return fail("%s must be an integer in %ld..%ld", what, lo, hi);
+        }
+        out = v.as<long>();
+        return true;
+    }
+
+    bool numberIn(JsonVariant v, float lo, float hi, const char* what, float& out) {
+        if (!v.is<float>() || v.as<float>() < lo || v.as<float>() > hi) {
+            return fail("%s must be a number in %g..%g", what, lo, hi);
+        }
+        out = v.as<float>();
+        return true;
+    }
+
+    bool arrayOf(JsonVariant v, size_t n, const char* what) {
+        if (!v.is<JsonArray>() || v.as<JsonArray>().size() != n) {
+            return fail("%s must be an array of %u", what, (unsigned)n);
+        }
+        return true;
+    }
+};
+
+bool buildConfig(JsonDocument& doc) {
+    doc["version"] = CONFIG_VERSION;
+
+    JsonArray ranges = doc.createNestedArray("ranges");
+    for (int i = 0; i < numRanges; ++i) {
+        JsonArray r = ranges.createNestedArray();
+        r.add(modeRanges[i][0]);
+        r.add(modeRanges[i][1]);
+    }
+
+    JsonArray positions = doc.createNestedArray("positions");
+    for (int i = 0; i < numRanges; ++i) positions.add(modeServoPositions[i]);
+
+    doc["hysteresis_rpm"] = getModeHysteresis();
+
+    JsonObject mechanical = doc.createNestedObject("mechanical");
+    mechanical["rack_length_mm"] = getRackLength();
+    mechanical["pinion_radius_mm"] = getPinionRadius();
+
+    ConfigPins p = currentPins();
+    JsonObject pins = doc.createNestedObject("pins");
+    pins["rpm"] = p.rpm;
+    pins["mode_button"] = p.modeButton;
+    pins["movement"] = p.movement;
+    pins["mark"] = p.mark;
+    pins["servo_rx"] = p.servoRx;
+    pins["servo_tx"] = p.servoTx;
+
+    JsonArray profiles = doc.createNestedArray("profiles");
+    for (int from = 0; from < numRanges; ++from) {
+        JsonArray row = profiles.createNestedArray();
+        for (int to = 0; to < numRanges; ++to) {
+            JsonArray profile = row.createNestedArray();
+            profile.add(motionProfiles[from][to].speed);
+            profile.add(motionProfiles[from][to].acc);
+        }
+    }
+    return !doc.overflowed();
+}
+
+// FNV-1a over the serialized document, fed byte by byte by serializeJson()
+struct EtagWriter {
+    uint32_t hash = 2166136261u;
+
+    size_t write(uint8_t c) {
+        hash = (hash ^ c) * 16777619u;
+        return 1;
+    }
+
+    size_t write(const uint8_t* buf, size_t n) {
+        for (size_t i = 0; i < n; ++i) write(buf[i]);
+        return n;
+    }
+};
+
+String getConfigEtag(const JsonDocument& doc) {
+    EtagWriter writer;
+    serializeJson(doc, writer);
+    char etag[12];
+    snprintf(etag, sizeof(etag), "\"%08lx\"", (unsigned long)writer.hash);
+    return String(etag);
+}
+
+static bool checkRanges(ConfigCheck& check, JsonVariant v, StagedConfig& s) {
+    if (!v.is<JsonArray>()) return check.fail("ranges must be an array");
+    JsonArray ranges = v.as<JsonArray>();
+    if (ranges.size() < 1 || (int)ranges.size() > MAX_RANGES) {
+        return check.fail("ranges must hold 1..%d modes", MAX_RANGES);
+    }
+
+    s.numRanges = ranges.size();
+    for (int i = 0; i < s.numRanges; ++i) {
+        char what[24];
+        snprintf(what, sizeof(what), "ranges[%d]", i);
+        if (!check.arrayOf(ranges[i], 2, what) ||
+            !check.intIn(ranges[i][0], 0, 100000, what, s.ranges[i][0]) ||
+            !check.intIn(ranges[i][1], 0, 100000, what, s.ranges[i][1])) {
+            return false;
+        }
+        if (s.ranges[i][0] > s.ranges[i][1]) return check.fail("%s ends below its start", what);
+        if (i > 0 && s.ranges[i][0] <= s.ranges[i - 1][1]) {
+            return check.fail("%s overlaps the mode below it", what);
+        }
+    }
+    return true;
+}
+
+static bool checkPositions(ConfigCheck& check, JsonVariant v, StagedConfig& s) {
+    if (!check.arrayOf(v, s.numRanges, "positions")) return false;
+    int lo = getServoMinUsable();
+    int hi = getServoMaxUsable();
+    for (int i = 0; i < s.numRanges; ++i) {
+        char what[24];
+        snprintf(what, sizeof(what), "positions[%d]", i);
+        if (!check.intIn(v[i], lo, hi, what, s.positions[i])) return false;
+    }
+    return true;
+}
+
+static bool checkMechanical(ConfigCheck& check, JsonVariant v, StagedConfig& s) {
+    if (!v.is<JsonObject>()) return check.fail("mechanical must be an object");
+    if (!v["rack_length_mm"].isNull() &&
+        !check.numberIn(v["rack_length_mm"], 1, 1000, "mechanical.rack_length_mm", s.rackLength)) {
+        return false;
+    }
+    if (!v["pinion_radius_mm"].isNull() &&
+        !check.numberIn(v["pinion_radius_mm"], 1, 500, "mechanical.pinion_radius_mm", s.pinionRadius)) {
+        return false;
+    }
+    return true;
+}
+
+static bool checkPins(ConfigCheck& check, JsonVariant v, StagedConfig& s) {
+    if (!v.is<JsonObject>()) return check.fail("pins must be an object");
+
+    struct { const char* name; int32_t* pin; long min; } fields[] = {
+        { "rpm", &s.pins.rpm, 0 },
+        { "mode_button", &s.pins.modeButton, 1 },
+        { "movement", &s.pins.movement, 1 },
+        { "mark", &s.pins.mark, 1 },
+        { "servo_rx", &s.pins.servoRx, 0 },
+        { "servo_tx", &s.pins.servoTx, 0 },
+    };
+    for (auto& f : fields) {
+        char what[24];
+        snprintf(what, sizeof(what), "pins.%s", f.name);
+        if (!v[f.name].isNull() && !check.intIn(v[f.name], f.min, CONFIG_MAX_PIN, what, *f.pin)) return false;
+    }
+
+    // One function per GPIO
+    for (size_t i = 0; i < sizeof(fields) / sizeof(fields[0]); ++i) {
+        for (size_t j = i + 1; j < sizeof(fields) / sizeof(fields[0]); ++j) {
+            if (*fields[i].pin == *fields[j].pin) {
+                return check.fail("pins.%s and pins.%s are both GPIO %ld", fields[i].name, fields[j].name,
+                                  (long)*fields[i].pin);
+            }
+        }
+    }
+    return true;
+}
+
+static bool checkProfiles(ConfigCheck& check, JsonVariant v, StagedConfig& s) {
+    if (!check.arrayOf(v, s.numRanges, "profiles")) return false;
+    for (int from = 0; from < s.numRanges; ++from) {
+        char what[32];
+        snprintf(what, sizeof(what), "profiles[%d]", from);
+        if (!check.arrayOf(v[from], s.numRanges, what)) return false;
+
+        for (int to = 0; to < s.numRanges; ++to) {
+            JsonVariant p = v[from][to];
+            int32_t speed, acc;
+            snprintf(what, sizeof(what), "profiles[%d][%d]", from, to);
+            if (!check.arrayOf(p, 2, what) ||
+                !check.intIn(p[0], 0, CONFIG_MAX_SPEED, what, speed) ||
+                !check.intIn(p[1], 0, CONFIG_MAX_ACC, what, acc)) {
+                return false;
+            }
+
+            // Unchanged entries keep their auto-tune results
+            MotionProfile& m = s.profiles[from][to];
+            if (m.speed != speed || m.acc != acc) m = { (uint16_t)speed, (uint8_t)acc, 0, 0 };
+        }
+    }
+    return true;
+}
+
+static bool checkConfig(ConfigCheck& check, JsonDocument& doc, StagedConfig& s) {
+    for (JsonPair kv : doc.as<JsonObject>()) {
+        bool known = false;
+        for (const char* key : TOP_KEYS) known |= strcmp(kv.key().c_str(), key) == 0;
+        if (!known) return check.fail("unknown key '%s'", kv.key().c_str());
+    }
+
+    JsonVariant version = doc["version"];
+    if (!version.is<int>() || version.as<int>() != CONFIG_VERSION) {
+        return check.fail("version must be %d", CONFIG_VERSION);
+    }
+
+    if (!doc["ranges"].isNull() && !checkRanges(check, doc["ranges"], s)) return false;
+    bool countChanged = s.numRanges != numRanges;
+
+    if (!doc["positions"].isNull()) {
+        if (!checkPositions(check, doc["positions"], s)) return false;
+    } else if (countChanged) {
+        return check.fail("positions are required when the number of ranges changes");
+    }
+
+    if (!doc["hysteresis_rpm"].isNull() &&
+        !check.intIn(doc["hysteresis_rpm"], 0, CONFIG_MAX_HYSTERESIS, "hysteresis_rpm", s.hysteresis)) {
+        return false;
+    }
+    if (!doc["mechanical"].isNull() && !checkMechanical(check, doc["mechanical"], s)) return false;
+    if (!doc["pins"].isNull() && !checkPins(check, doc["pins"], s)) return false;
+    if (!doc["profiles"].isNull() && !checkProfiles(check, doc["profiles"], s)) return false;
+    return true;
+}
+
+static void applyPins(const ConfigPins& p) {
+    ConfigPins now = currentPins();
+    if (p.rpm != now.rpm) setRpmPin(p.rpm);
+    if (p.modeButton != now.modeButton) {
+        setModeSwitchButtonPin(p.modeButton);
+        initModeButtonInterrupt();
+    }
+    if (p.movement != now.movement) {
+        setMovementPin(p.movement);
+        initMovementPin();
+    }
+    if (p.mark != now.mark) {
+        setMarkPin(p.mark);
+        initMarkPin();
+    }
+    if (p.servoRx != now.servoRx || p.servoTx != now.servoTx) configureServoPins(p.servoRx, p.servoTx);
+}
+
+ConfigResult applyConfig(JsonDocument& doc, char* error, size_t errorLen) {
+    static StagedConfig s;  // Only the HTTP task applies configs
+
+    // Start from the current values; sections in 'doc' overwrite them
+    s.numRanges = numRanges;
+    memcpy(s.ranges, modeRanges, sizeof(s.ranges));
+    memcpy(s.positions, modeServoPositions, sizeof(s.positions));
+    s.hysteresis = getModeHysteresis();
+    s.rackLength = getRackLength();
+    s.pinionRadius = getPinionRadius();
+    s.pins = currentPins();
+    memcpy(s.profiles, motionProfiles, sizeof(s.profiles));
+
+    ConfigCheck check = { error, errorLen };
+    if (!checkConfig(check, doc, s)) return CONFIG_INVALID;
+
+    // The control task reads these tables; it never sees them half-copied
+    vTaskSuspendAll();
+    numRanges = s.numRanges;
+    memcpy(modeRanges, s.ranges, sizeof(s.ranges));
+    memcpy(modeServoPositions, s.positions, sizeof(s.positions));
+    memcpy(motionProfiles, s.profiles, sizeof(s.profiles));
+    xTaskResumeAll();
+
+    setModeHysteresis(s.hysteresis);
+    setRackLength(s.rackLength);
+    setPinionRadius(s.pinionRadius);
+    applyPins(s.pins);
+
+    if (!storeConfig()) {
+        snprintf(error, errorLen, "config applied but could not be stored");
+        return CONFIG_STORE_FAILED;
+    }
+    return CONFIG_OK;
+}
@@ -0,0 +1,213 @@
+#include <Arduino.h>
+#include "../include/control.h"
+#include "../include/servo.h"
+#include "../include/nvs_utils.h"
+#include "../include/rpm.h"
+#include "../include/perf.h"
+#include "../include/trace.h"
+
+static volatile int controlRateHz = CONTROL_DEFAULT_HZ;
+static TaskHandle_t controlTaskHandle = nullptr;
+
+// === Cycle statistics ===
+static portMUX_TYPE statsMux = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t cycleCount = 0;
+static uint32_t overrunCount = 0;
+static uint32_t execLastUs = 0;
+static uint32_t execMinUs = UINT32_MAX;
+static uint32_t execMaxUs = 0;
+static uint64_t execSumUs = 0;
+static uint32_t jitterMaxUs = 0;
+static uint64_t jitterSumUs = 0;
+static uint32_t jitterSamples = 0;
+
+// Event-driven wake-ups (RPM boundary crossings)
+static uint32_t eventCount = 0;
+static uint32_t eventLastUs = 0;
+static uint32_t eventMinUs = UINT32_MAX;
+static uint32_t eventMaxUs = 0;
+static uint64_t eventSumUs = 0;
+static uint32_t idleTimeouts = 0;
+
+static void recordCycle(uint32_t execUs, uint32_t periodUs, int32_t jitterUs) {
+    portENTER_CRITICAL(&statsMux);
+    cycleCount++;
+    execLastUs = execUs;
+    execMinUs = min(execMinUs, execUs);
+    execMaxUs = max(execMaxUs, execUs);
+    execSumUs += execUs;
+    if (execUs > periodUs) overrunCount++;
+
+    if (jitterUs >= 0) {
+        jitterMaxUs = max(jitterMaxUs, (uint32_t)jitterUs);
+        jitterSumUs += jitterUs;
+        jitterSamples++;
+    }
+    portEXIT_CRITICAL(&statsMux);
+}
+
+static void recordCrossing(uint32_t latencyUs) {
+    portENTER_CRITICAL(&statsMux);
+    eventCount++;
+    eventLastUs = latencyUs;
+    eventMinUs = min(eventMinUs, latencyUs);
+    eventMaxUs = max(eventMaxUs, latencyUs);
+    eventSumUs += latencyUs;
+    portEXIT_CRITICAL(&statsMux);
+}
+
+// Boundary crossings can only be detected on sensor RPM; manual and
+// simulated sources, and follow being off, keep the fixed-rate loop
+static bool canWaitForCrossings() {
+    return servoFollowingEnabled && isRPMFromSensor();
+}
+
+// Bounds follow the mode the servo is in, not the raw RPM, so a
+// reading inside the hysteresis band does not move the target. Out of
+// all ranges there is nothing to arm and the fixed-rate loop takes over.
+static void rearmBoundaries() {
+    if (canWaitForCrossings() && lastServoMode >= 1 && determineMode(getRPMUnified()) >= 1) {
+        armModeBoundaries(lastServoMode);
+    } else {
+        disarmModeBoundaries();
+    }
+}
+
+static void controlTask(void* arg) {
+    TickType_t lastWake = xTaskGetTickCount();
+    uint32_t lastStartUs = 0;
+    int lastHz = 0;
+
+    setModeCrossingTask(xTaskGetCurrentTaskHandle());
+
+    for (;;) {
+        // === Event-driven: sleep until the ISR sees the mode change ===
+        if (canWaitForCrossings() && modeBoundariesArmed()) {
+            if (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(CONTROL_RESYNC_MS)) > 0) {
+                PERF_SCOPE(PERF_CONTROL);
+                TRACE_SCOPE(TRACE_CONTROL);
+                updateServoIfFollowing();
+                recordCrossing(micros() - getLastCrossingUs());
+            } else {
+                portENTER_CRITICAL(&statsMux);
+                idleTimeouts++;
+                portEXIT_CRITICAL(&statsMux);
+            }
+            rearmBoundaries();
+
+            // Fixed-rate timing restarts from here if we fall back
+            lastWake = xTaskGetTickCount();
+            lastHz = 0;
+            continue;
+        }
+
+        // === Fixed-rate ===
+        int hz = controlRateHz;
+        TickType_t period = max<TickType_t>(configTICK_RATE_HZ / hz, 1);
+        uint32_t periodUs = period * (1000000UL / configTICK_RATE_HZ);
+
+        uint32_t startUs = micros();
+
+        // Jitter is only meaningful between two cycles at the same rate
+        int32_t jitterUs = -1;
+        if (hz == lastHz) {
+            jitterUs = abs((int32_t)(startUs - lastStartUs - periodUs));
+        }
+        lastHz = hz;
+        lastStartUs = startUs;
+
+        {
+            PERF_SCOPE(PERF_CONTROL);
+            updateServoIfFollowing();
+            rearmBoundaries();
+        }
+
+        recordCycle(micros() - startUs, periodUs, jitterUs);
+        vTaskDelayUntil(&lastWake, period);
+    }
+}
+
+void initControlLoop() {
+    if (controlTaskHandle != nullptr) return;
+    loadControlRate();
+    loadModeHysteresis();
+    xTaskCreate(controlTask, "control", 4096, nullptr, CONTROL_TASK_PRIORITY, &controlTaskHandle);
+}
+
+void setControlRate(int hz) {
+    controlRateHz = constrain(hz, 1, CONTROL_MAX_HZ);
+    resetControlStats();
+}
+
+int getControlRate() {
+    return controlRateHz;
+}
+
+void getControlStats(ControlStats& out) {
+    int hz = controlRateHz;
+    out.eventDriven = canWaitForCrossings() && modeBoundariesArmed();
+    portENTER_CRITICAL(&statsMux);
+    out.cycles = cycleCount;
+    out.overruns = overrunCount;
+    out.periodUs = max<uint32_t>(configTICK_RATE_HZ / hz, 1) * (1000000UL / configTICK_RATE_HZ);
+    out.execLastUs = execLastUs;
+    out.execMinUs = cycleCount ? execMinUs : 0;
+    out.execMaxUs = execMaxUs;
+    out.execAvgUs = cycleCount ? (float)execSumUs / cycleCount : 0;
+    out.jitterMaxUs = jitterMaxUs;
+    out.jitterAvgUs = jitterSamples ? (float)jitterSumUs / jitterSamples : 0;
+    out.events = eventCount;
+    out.idleTimeouts = idleTimeouts;
+    out.eventLastUs = eventLastUs;
+    out.eventMinUs = eventCount ? eventMinUs : 0;
+    out.eventMaxUs = eventMaxUs;
+    out.eventAvgUs = eventCount ? (float)eventSumUs / eventCount : 0;
+    portEXIT_CRITICAL(&statsMux);
+}
+
+void resetControlStats() {
+    portENTER_CRITICAL(&statsMux);
+    cycleCount = 0;
+    overrunCount = 0;
+    execLastUs = 0;
+    execMinUs = UINT32_MAX;
+    execMaxUs = 0;
+    execSumUs = 0;
+    jitterMaxUs = 0;
+    jitterSumUs = 0;
+    jitterSamples = 0;
+    eventCount = 0;
+    eventLastUs = 0;
+    eventMinUs = UINT32_MAX;
+    eventMaxUs = 0;
+    eventSumUs = 0;
+    idleTimeouts = 0;
+    portEXIT_CRITICAL(&statsMux);
+}
+
+void printControlStats() {
+    ControlStats s;
+    getControlStats(s);
+
+    Serial.printf("⏱️ Control loop: %d Hz (period %lu µs, priority %d), %s\n",
+                  getControlRate(), (unsigned long)s.periodUs, CONTROL_TASK_PRIORITY,
+                  s.eventDriven ? "waiting for RPM boundary crossings" : "fixed-rate");
+    Serial.printf("  Hysteresis: %d RPM, crossings seen by ISR: %lu\n",
+                  getModeHysteresis(), (unsigned long)getModeCrossingCount());
+    if (s.events > 0) {
+        Serial.printf("  Crossing → command: %lu events, last %lu µs  min %lu µs  avg %.1f µs  max %lu µs\n",
+                      (unsigned long)s.events, (unsigned long)s.eventLastUs, (unsigned long)s.eventMinUs,
+                      s.eventAvgUs, (unsigned long)s.eventMaxUs);
+    }
+    Serial.printf("  Idle resyncs: %lu\n", (unsigned long)s.idleTimeouts);
+    if (s.cycles == 0) {
+        Serial.println("  No fixed-rate cycles recorded yet.");
+        return;
+    }
+    Serial.printf("  Cycles:   %lu, overruns: %lu (%.2f%%)\n",
+                  (unsigned long)s.cycles, (unsigned long)s.overruns, 100.0 * s.overruns / s.cycles);
+    Serial.printf("  Exec:     last %lu µs  min %lu µs  avg %.1f µs  max %lu µs\n",
+                  (unsigned long)s.execLastUs, (unsigned long)s.execMinUs, s.execAvgUs,
+                  (unsigned long)s.execMaxUs);
+    Serial.printf("  Jitter:   avg %.1f µs  max %lu µs\n", s.jitterAvgUs, (unsigned long)s.jitterMaxUs);
+}
@@ -0,0 +1,94 @@
+#include <Arduino.h>
+#include "../include/history.h"
+#include "../include/rpm.h"
+#include "../include/servo.h"
+#include "../include/servo_telemetry.h"
+#include "../include/pin_utils.h"
+#include "../include/telemetry_frame.h"
+
+static HistorySample ring[HISTORY_CAPACITY];
+static volatile uint32_t head = 0;  // Written only by the history task
+static TaskHandle_t historyTaskHandle = nullptr;
+
+// Bit order of HistoryField
+static const char* const FIELD_NAMES[HISTORY_FIELD_COUNT] = {
+    "t_ms", "rpm", "mode", "target", "actual", "flags"
+};
+
+static void takeSample(HistorySample& s) {
+    ServoTelemetry t;
+    getServoTelemetry(t);
+
+    s.ms = millis();
+    s.rpmX10 = lroundf(getRPMUnified() * 10);
+    s.mode = lastServoMode;
+    s.target = lastServoPos;
+    s.actual = t.position;
+    s.flags = (servoFollowingEnabled ? TELEMETRY_FOLLOWING : 0) |
+              (getMovementPinState() ? TELEMETRY_MOVEMENT_PIN : 0) |
+              (t.moving ? TELEMETRY_SERVO_MOVING : 0) |
+              (isRPMFromSensor() ? TELEMETRY_RPM_SENSOR : 0) |
+              (t.valid ? TELEMETRY_SERVO_VALID : 0);
+}
+
+static void historyTask(void* arg) {
+    TickType_t lastWake = xTaskGetTickCount();
+    const TickType_t period = max<TickType_t>(pdMS_TO_TICKS(1000 / HISTORY_HZ), 1);
+
+    for (;;) {
+        uint32_t seq = head;
+        takeSample(ring[seq % HISTORY_CAPACITY]);
+        head = seq + 1;  // Publish only once the slot is complete
+        vTaskDelayUntil(&lastWake, period);
+    }
+}
+
+void initHistory() {
+    if (historyTaskHandle == nullptr) {
+        xTaskCreate(historyTask, "history", 2048, nullptr, HISTORY_TASK_PRIORITY, &historyTaskHandle);
+    }
+}
+
+uint32_t getHistoryHead() {
+    return head;
+}
+
+uint32_t getHistoryOldest() {
+    uint32_t h = head;
+    uint32_t keep = HISTORY_CAPACITY - HISTORY_GUARD_SAMPLES;
+    return h > keep ? h - keep : 0;
+}
+
+bool getHistorySample(uint32_t seq, HistorySample& out) {
+    if (seq >= head) return false;
+    out = ring[seq % HISTORY_CAPACITY];
+    // While sample seq + CAPACITY is written, head still points at it
+    return head - seq < HISTORY_CAPACITY;
+}
+
+uint8_t parseHistoryFields(const char* list) {
+    uint8_t fields = 0;
+    while (*list) {
+        const char* end = strchr(list, ',');
+        size_t len = end ? (size_t)(end - list) : strlen(list);
+
+        if (len == 3 && strncmp(list, "all", 3) == 0) {
+            fields |= HISTORY_ALL_FIELDS;
+        } else {
+            int i = 0;
+            for (; i < HISTORY_FIELD_COUNT; ++i) {
+                if (strlen(FIELD_NAMES[i]) == len && strncmp(list, FIELD_NAMES[i], len) == 0) break;
+            }
+            if (i == HISTORY_FIELD_COUNT) return 0;
+            fields |= 1 << i;
+        }
+
+        if (!end) break;
+        list = end + 1;
+    }
+    return fields;
+}
+
+const char* getHistoryFieldName(int index) {
+    return index >= 0 && index < HISTORY_FIELD_COUNT ? FIELD_NAMES[index] : "";
+}
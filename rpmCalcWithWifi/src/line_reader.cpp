@@ -0,0 +1,69 @@
+#include <Arduino.h>
+#include "../include/line_reader.h"
+
+void LineReader::clear() {
+    len = 0;
+    buf[0] = '\0';
+    ready = false;
+    discarding = false;
+}
+
+void LineReader::finishLine() {
+    // Trim both ends in place
+    while (len > 0 && isspace((unsigned char)buf[len - 1])) len--;
+    buf[len] = '\0';
+    size_t start = 0;
+    while (start < len && isspace((unsigned char)buf[start])) start++;
+    if (start > 0) {
+        memmove(buf, buf + start, len - start + 1);
+        len -= start;
+    }
+
+    // Tokens are split from a copy so the line itself stays intact
+    memcpy(tokenBuf, buf, len + 1);
+    tokens.argc = 0;
+    char* p = tokenBuf;
+    while (*p && tokens.argc < CLI_MAX_TOKENS) {
+        while (*p == ' ' || *p == '\t') *p++ = '\0';
+        if (!*p) break;
+        tokens.argv[tokens.argc++] = p;
+        while (*p && *p != ' ' && *p != '\t') p++;
+    }
+
+    ready = len > 0;
+}
+
+bool LineReader::poll(Stream& in) {
+    if (ready) clear();  // Previous line has been handled
+
+    overflow = false;
+    while (in.available() > 0) {
+        int c = in.read();
+        if (c < 0) break;
+
+        if (c == '\n' || c == '\r') {
+            if (discarding) {
+                overflow = true;
+                clear();
+                return false;
+            }
+            finishLine();
+            if (ready) return true;
+            continue;  // Empty line, e.g. the LF of a CRLF pair
+        }
+
+        if (discarding) continue;
+
+        if (c == '\b' || c == 0x7F) {
+            if (len > 0) len--;
+            continue;
+        }
+
+        if (len + 1 >= CLI_LINE_MAX) {
+            discarding = true;  // Drop the rest of this line
+            continue;
+        }
+        buf[len++] = (char)c;
+    }
+    return false;
+}
@@ -0,0 +1,208 @@
+#include <Arduino.h>
+#include "../include/live_stream.h"
+#include "../include/rpm.h"
+#include "../include/servo.h"
+#include "../include/servo_telemetry.h"
+#include "../include/pin_utils.h"
+#include "../include/telemetry_frame.h"
+
+static TaskHandle_t liveTaskHandle = nullptr;
+static volatile bool liveActive = false;
+static volatile int liveHz = LIVE_DEFAULT_HZ;
+static volatile uint8_t liveFields = LIVE_DEFAULT_FIELDS;
+static volatile LiveFormat liveFormat = LIVE_TEXT;
+static TelemetryEncoder liveEncoder;
+
+static uint32_t liveStartMs = 0;
+static uint32_t samplesSent = 0;
+static uint32_t samplesDropped = 0;
+static uint32_t liveSamples = 0;  // Sent or dropped, for the effective rate
+
+// Filter state, restarted with every subscription
+static float filteredRpm = 0;
+static float rpmRate = 0;  // dRPM/dt of the filtered RPM, RPM/s
+static uint32_t lastSampleUs = 0;
+static bool filterPrimed = false;
+static bool droppedSinceSent = false;
+
+struct LiveFieldName {
+    const char* name;
+    LiveField field;
+};
+
+// Also the column order of the output
+static const LiveFieldName LIVE_FIELD_NAMES[] = {
+    { "rpm", LIVE_RPM },
+    { "filt", LIVE_RPM_FILTERED },
+    { "mode", LIVE_MODE },
+    { "pos", LIVE_SERVO_POS },
+    { "move", LIVE_MOVEMENT },
+};
+
+static void emitFrame(uint32_t nowUs, float rpm) {
+    ServoTelemetry t;
+    getServoTelemetry(t);
+
+    TelemetrySample s;
+    s.timestampUs = nowUs;
+    s.rpmX10 = lroundf(rpm * 10);
+    s.rpmRate = lroundf(rpmRate);
+    s.mode = lastServoMode;
+    s.servoTarget = lastServoPos;
+    s.servoActual = t.position;
+    s.flags = (servoFollowingEnabled ? TELEMETRY_FOLLOWING : 0) |
+              (getMovementPinState() ? TELEMETRY_MOVEMENT_PIN : 0) |
+              (t.moving ? TELEMETRY_SERVO_MOVING : 0) |
+              (isRPMFromSensor() ? TELEMETRY_RPM_SENSOR : 0) |
+              (t.valid ? TELEMETRY_SERVO_VALID : 0) |
+              (droppedSinceSent ? TELEMETRY_DROPPED : 0);
+
+    uint8_t frame[TELEMETRY_MAX_FRAME];
+    size_t len = liveEncoder.encode(s, frame);
+    if (Serial.availableForWrite() >= (int)len) {
+        Serial.write(frame, len);
+        liveEncoder.commit();
+        droppedSinceSent = false;
+        samplesSent++;
+    } else {
+        droppedSinceSent = true;
+        samplesDropped++;
+    }
+}
+
+static void emitSample() {
+    uint32_t nowUs = micros();
+    float rpm = getRPMUnified();
+
+    // dt-weighted EMA so the time constant holds at any stream rate
+    if (!filterPrimed) {
+        filteredRpm = rpm;
+        filterPrimed = true;
+        rpmRate = 0;
+    } else {
+        float dtMs = (nowUs - lastSampleUs) / 1000.0f;
+        float previous = filteredRpm;
+        filteredRpm += (rpm - filteredRpm) * dtMs / (LIVE_FILTER_TAU_MS + dtMs);
+        if (dtMs > 0) rpmRate = (filteredRpm - previous) * 1000.0f / dtMs;
+    }
+    lastSampleUs = nowUs;
+
+    if (liveFormat == LIVE_BINARY) {
+        emitFrame(nowUs, rpm);
+        return;
+    }
+
+    uint8_t fields = liveFields;
+    char line[96];
+    int len = snprintf(line, sizeof(line), "%lu", (unsigned long)(millis() - liveStartMs));
+
+    if (fields & LIVE_RPM) len += snprintf(line + len, sizeof(line) - len, " %.1f", rpm);
+    if (fields & LIVE_RPM_FILTERED) len += snprintf(line + len, sizeof(line) - len, " %.1f", filteredRpm);
+    if (fields & LIVE_MODE) len += snprintf(line + len, sizeof(line) - len, " %d", lastServoMode);
+    if (fields & LIVE_SERVO_POS) {
+        ServoTelemetry t;
+        getServoTelemetry(t);
+        len += snprintf(line + len, sizeof(line) - len, " %d", t.position);
+    }
+    if (fields & LIVE_MOVEMENT) len += snprintf(line + len, sizeof(line) - len, " %d", getMovementPinState());
+    len += snprintf(line + len, sizeof(line) - len, "\n");
+
+    // Whole lines or nothing: a full buffer must not block the sampler
+    if (Serial.availableForWrite() >= len) {
+        Serial.write((const uint8_t*)line, len);
+        samplesSent++;
+    } else {
+        samplesDropped++;
+    }
+}
+
+// The period is kept in µs and the part that is not a whole tick is
+// carried into the next one, so the average rate is the one asked for
+// (300 Hz alternates 3- and 4-tick periods) instead of whatever whole
+// tick count is closest. Above the tick rate a tick may hold two
+// samples; their timestamps show the real spacing.
+static void liveTask(void* arg) {
+    TickType_t lastWake = xTaskGetTickCount();
+    uint32_t carryUs = 0;
+    const uint32_t tickUs = 1000000UL / configTICK_RATE_HZ;
+
+    for (;;) {
+        if (!liveActive) {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            lastWake = xTaskGetTickCount();
+            carryUs = 0;
+            continue;
+        }
+
+        emitSample();
+        liveSamples++;
+
+        carryUs += 1000000UL / liveHz;
+        TickType_t ticks = carryUs / tickUs;
+        carryUs -= ticks * tickUs;
+        if (ticks > 0) {
+            vTaskDelayUntil(&lastWake, ticks);
+        } else {
+            taskYIELD();
+        }
+    }
+}
+
+void startLiveStream(int hz, uint8_t fields, LiveFormat format) {
+    liveActive = false;  // Pause while reconfiguring
+
+    liveHz = constrain(hz, LIVE_MIN_HZ, LIVE_MAX_HZ);
+    liveFields = fields ? fields : LIVE_DEFAULT_FIELDS;
+    liveFormat = format;
+    liveStartMs = millis();
+    samplesSent = 0;
+    samplesDropped = 0;
+    liveSamples = 0;
+    filterPrimed = false;
+    droppedSinceSent = false;
+    liveEncoder.reset();
+
+    if (liveHz != hz) Serial.printf("⚠️ %d Hz is out of range, using %d Hz\n", hz, liveHz);
+    Serial.printf("🔁 Live stream at %d Hz, press any key to stop\n", liveHz);
+    if (format == LIVE_BINARY) {
+        // Frames follow; the zero ends the text so the first one decodes
+        Serial.println("# binary frames, decode with tools/telemetry_decode.py");
+        Serial.write((uint8_t)0x00);
+    } else {
+        Serial.print("# t_ms");
+        for (const LiveFieldName& f : LIVE_FIELD_NAMES) {
+            if (liveFields & f.field) Serial.printf(" %s", f.name);
+        }
+        Serial.println();
+    }
+
+    if (liveTaskHandle == nullptr) {
+        xTaskCreate(liveTask, "live", 3072, nullptr, LIVE_TASK_PRIORITY, &liveTaskHandle);
+    }
+    liveActive = true;
+    xTaskNotifyGive(liveTaskHandle);
+}
+
+void stopLiveStream() {
+    if (!liveActive) return;
+    liveActive = false;
+    Serial.printf("❎ Live stream stopped: %lu samples sent, %lu dropped, %.1f Hz effective (%d Hz asked)\n",
+                  (unsigned long)samplesSent, (unsigned long)samplesDropped, getLiveStreamRate(), (int)liveHz);
+}
+
+bool isLiveStreamActive() {
+    return liveActive;
+}
+
+float getLiveStreamRate() {
+    uint32_t elapsedMs = millis() - liveStartMs;
+    return elapsedMs ? liveSamples * 1000.0f / elapsedMs : 0;
+}
+
+uint8_t parseLiveField(const char* name) {
+    if (strcmp(name, "all") == 0) return LIVE_ALL_FIELDS;
+    for (const LiveFieldName& f : LIVE_FIELD_NAMES) {
+        if (strcmp(name, f.name) == 0) return f.field;
+    }
+    return 0;
+}
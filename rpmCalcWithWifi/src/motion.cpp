@@ -0,0 +1,214 @@
+#include <Arduino.h>
+#include "../include/motion.h"
+#include "../include/servo.h"
+#include "../include/servo_telemetry.h"
+#include "../include/nvs_utils.h"
+
+MotionProfile motionProfiles[MOTION_MAX_MODES][MOTION_MAX_MODES];
+
+// === Auto-tune search space ===
+// Speeds go from gentle to servo maximum (0); for each speed the
+// acceleration is raised until the move stops being stable.
+static const uint16_t TUNE_SPEEDS[] = {1000, 2000, 3000, 0};
+static const uint8_t TUNE_ACCS[] = {10, 20, 35, 50, 80, 120, 180, 254};
+#define TUNE_TRIALS 3
+#define TUNE_TIMEOUT_MS 3000
+#define TUNE_SETTLE_MS 150
+
+static bool tuneAborted = false;
+
+struct MoveResult {
+    bool arrived;
+    uint32_t arrivalMs;
+    int overshoot;   // Steps travelled past the target (0 if none)
+};
+
+void resetMotionProfiles() {
+    for (int i = 0; i < MOTION_MAX_MODES; ++i) {
+        for (int j = 0; j < MOTION_MAX_MODES; ++j) {
+            motionProfiles[i][j] = {MOTION_DEFAULT_SPEED, MOTION_DEFAULT_ACC, 0, 0};
+        }
+    }
+}
+
+MotionProfile getMotionProfile(int fromMode, int toMode) {
+    if (fromMode < 1 || fromMode > MOTION_MAX_MODES ||
+        toMode < 1 || toMode > MOTION_MAX_MODES) {
+        return {MOTION_DEFAULT_SPEED, MOTION_DEFAULT_ACC, 0, 0};
+    }
+    return motionProfiles[fromMode - 1][toMode - 1];
+}
+
+bool setMotionProfile(int fromMode, int toMode, uint16_t speed, uint8_t acc) {
+    if (fromMode < 1 || fromMode > numRanges || toMode < 1 || toMode > numRanges) {
+        return false;
+    }
+    motionProfiles[fromMode - 1][toMode - 1] = {speed, acc, 0, 0};
+    return true;
+}
+
+// Commands a move and watches the telemetry snapshot until the servo
+// reports in-position and stopped, then keeps watching for a short
+// settle window to catch any overshoot.
+static MoveResult measureMove(int startPos, int targetPos, const MotionProfile& p) {
+    MoveResult r = {false, 0, 0};
+    int direction = (targetPos >= startPos) ? 1 : -1;
+    uint32_t lastSeen = 0;
+    uint32_t settleStart = 0;
+
+    uint32_t start = millis();
+    servoWritePosEx(targetPos, p.speed, p.acc);
+
+    while (millis() - start < TUNE_TIMEOUT_MS) {
+        ServoTelemetry t;
+        getServoTelemetry(t);
+
+        if (t.valid && t.sampleCount != lastSeen && (int32_t)(t.timestampMs - start) >= 0) {
+            lastSeen = t.sampleCount;
+
+            int past = (t.position - targetPos) * direction;
+            if (past > r.overshoot) r.overshoot = past;
+
+            if (!r.arrived && abs(t.position - targetPos) <= MOTION_TOLERANCE && !t.moving) {
+                r.arrived = true;
+                r.arrivalMs = t.timestampMs - start;
+                settleStart = millis();
+            }
+        }
+
+        if (r.arrived && millis() - settleStart >= TUNE_SETTLE_MS) break;
+        delay(2);
+    }
+    return r;
+}
+
+// Moves back to the start position before a trial; false if the servo
+// never got there, in which case the trial would measure the wrong move
+static bool returnToStart(int startPos) {
+    MotionProfile gentle = {MOTION_DEFAULT_SPEED, MOTION_DEFAULT_ACC, 0, 0};
+    ServoTelemetry t;
+    getServoTelemetry(t);
+    return measureMove(t.position, startPos, gentle).arrived;
+}
+
+bool autoTuneMotion(int fromMode, int toMode) {
+    if (fromMode < 1 || fromMode > numRanges || toMode < 1 || toMode > numRanges) {
+        Serial.println("❌ Invalid mode pair.");
+        return false;
+    }
+
+    int fromPos = modeServoPositions[fromMode - 1];
+    int toPos = modeServoPositions[toMode - 1];
+    if (abs(toPos - fromPos) <= MOTION_TOLERANCE) {
+        Serial.printf("⚠️ Modes %d and %d share a position, nothing to tune.\n", fromMode, toMode);
+        return false;
+    }
+
+    Serial.printf("🔧 Tuning %d → %d (pos %d → %d). Press any key to abort.\n",
+                  fromMode, toMode, fromPos, toPos);
+
+    // Sample as fast as the poller allows while measuring
+    int previousPollHz = getServoPollRate();
+    setServoPollRate(SERVO_POLL_MAX_HZ);
+
+    MotionProfile best = getMotionProfile(fromMode, toMode);
+    bool found = false;
+    bool aborted = false;
+    bool stuck = false;
+    tuneAborted = false;
+
+    for (uint16_t speed : TUNE_SPEEDS) {
+        for (uint8_t acc : TUNE_ACCS) {
+            MotionProfile candidate = {speed, acc, 1, 0};
+            uint32_t total = 0;
+            int worstOvershoot = 0;
+            bool stable = true;
+
+            for (int trial = 0; trial < TUNE_TRIALS; ++trial) {
+                if (Serial.available()) {
+                    aborted = true;
+                    break;
+                }
+                if (!returnToStart(fromPos)) {
+                    stuck = true;
+                    break;
+                }
+                MoveResult r = measureMove(fromPos, toPos, candidate);
+                worstOvershoot = max(worstOvershoot, r.overshoot);
+                if (!r.arrived || r.overshoot > MOTION_TOLERANCE) {
+                    stable = false;
+                    break;
+                }
+                total += r.arrivalMs;
+            }
+            if (aborted || stuck) break;
+
+            if (!stable) {
+                Serial.printf("  speed %4u acc %3u → ❌ unstable (overshoot %d)\n",
+                              speed, acc, worstOvershoot);
+                break;  // Steeper ramps at this speed only overshoot more
+            }
+
+            uint32_t avg = total / TUNE_TRIALS;
+            Serial.printf("  speed %4u acc %3u → %lu ms (overshoot %d)\n",
+                          speed, acc, (unsigned long)avg, worstOvershoot);
+            if (!found || avg < best.arrivalMs) {
+                best = candidate;
+                best.arrivalMs = avg;
+                found = true;
+            }
+        }
+        if (aborted || stuck) break;
+    }
+
+    setServoPollRate(previousPollHz);
+
+    // The servo was moved behind the follow logic's back
+    lastServoPos = -1;
+    lastServoMode = -1;
+
+    if (aborted) {
+        tuneAborted = true;
+        while (Serial.available()) Serial.read();
+        Serial.println("❎ Auto-tune aborted, profile unchanged.");
+        return false;
+    }
+    if (stuck) {
+        Serial.printf("❌ Servo did not return to mode %d (pos %d), profile unchanged.\n",
+                      fromMode, fromPos);
+        return false;
+    }
+    if (!found) {
+        Serial.println("❌ No stable setting found, profile unchanged.");
+        return false;
+    }
+
+    motionProfiles[fromMode - 1][toMode - 1] = best;
+    Serial.printf("✅ %d → %d: speed %u acc %u (%u ms)\n",
+                  fromMode, toMode, best.speed, best.acc, best.arrivalMs);
+    return true;
+}
+
+void autoTuneAllMotion() {
+    for (int from = 1; from <= numRanges; ++from) {
+        for (int to = 1; to <= numRanges; ++to) {
+            if (from == to) continue;
+            autoTuneMotion(from, to);
+            if (tuneAborted) return;
+        }
+    }
+}
+
+void printMotionProfiles() {
+    Serial.println("🏎️ Motion profiles (from → to: speed / acc / measured arrival)");
+    for (int from = 1; from <= numRanges; ++from) {
+        for (int to = 1; to <= numRanges; ++to) {
+            if (from == to) continue;
+            const MotionProfile& p = motionProfiles[from - 1][to - 1];
+            Serial.printf("  %2d → %2d: speed %4u  acc %3u  %s",
+                          from, to, p.speed, p.acc, p.tuned ? "tuned" : "manual");
+            if (p.arrivalMs > 0) Serial.printf("  (%u ms)", p.arrivalMs);
+            Serial.println();
+        }
+    }
+}
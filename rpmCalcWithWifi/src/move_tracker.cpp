@@ -0,0 +1,204 @@
+#include <Arduino.h>
+#include <algorithm>
+#include "../include/move_tracker.h"
+#include "../include/motion.h"
+#include "../include/nvs_utils.h"
+
+// Latencies are stored in 0.1 ms units so a window entry fits in 16 bits
+struct LatencyWindow {
+    uint16_t arrival[LATENCY_WINDOW];
+    uint16_t deadTime[LATENCY_WINDOW];
+    uint8_t head;
+    uint8_t count;
+    uint16_t timeouts;
+    uint16_t superseded;
+};
+
+struct OverallWindow {
+    uint16_t arrival[LATENCY_OVERALL_WINDOW];
+    uint16_t deadTime[LATENCY_OVERALL_WINDOW];
+    uint8_t head;
+    uint8_t count;
+    uint16_t timeouts;
+    uint16_t superseded;
+};
+
+struct ActiveMove {
+    bool active;
+    bool moved;
+    int8_t fromMode;
+    int8_t toMode;
+    int16_t startPos;
+    int16_t targetPos;
+    uint32_t commandUs;
+    uint32_t firstMotionUs;
+};
+
+static portMUX_TYPE trackerMux = portMUX_INITIALIZER_UNLOCKED;
+static ActiveMove activeMove = {};
+static LatencyWindow transitionStats[MOTION_MAX_MODES][MOTION_MAX_MODES];
+static OverallWindow overallStats;
+static volatile int arrivedServoPos = -1;
+
+static uint16_t toTenthsMs(uint32_t us) {
+    uint32_t tenths = us / 100;
+    return tenths > UINT16_MAX ? UINT16_MAX : tenths;
+}
+
+// Must be called with trackerMux held
+static LatencyWindow* statsFor(int fromMode, int toMode) {
+    if (fromMode < 1 || fromMode > MOTION_MAX_MODES || toMode < 1 || toMode > MOTION_MAX_MODES) {
+        return nullptr;
+    }
+    return &transitionStats[fromMode - 1][toMode - 1];
+}
+
+// Must be called with trackerMux held
+static void recordArrival(const ActiveMove& m, uint32_t arrivalUs) {
+    uint16_t arrival = toTenthsMs(arrivalUs - m.commandUs);
+    uint16_t dead = toTenthsMs((m.moved ? m.firstMotionUs : arrivalUs) - m.commandUs);
+
+    LatencyWindow* w = statsFor(m.fromMode, m.toMode);
+    if (w != nullptr) {
+        w->arrival[w->head] = arrival;
+        w->deadTime[w->head] = dead;
+        w->head = (w->head + 1) % LATENCY_WINDOW;
+        if (w->count < LATENCY_WINDOW) w->count++;
+    }
+
+    overallStats.arrival[overallStats.head] = arrival;
+    overallStats.deadTime[overallStats.head] = dead;
+    overallStats.head = (overallStats.head + 1) % LATENCY_OVERALL_WINDOW;
+    if (overallStats.count < LATENCY_OVERALL_WINDOW) overallStats.count++;
+}
+
+// Must be called with trackerMux held
+static void recordFailure(const ActiveMove& m, bool timedOut) {
+    LatencyWindow* w = statsFor(m.fromMode, m.toMode);
+    if (timedOut) {
+        if (w != nullptr) w->timeouts++;
+        overallStats.timeouts++;
+    } else {
+        if (w != nullptr) w->superseded++;
+        overallStats.superseded++;
+    }
+}
+
+void beginMoveTracking(int fromMode, int toMode, int startPos, int targetPos) {
+    uint32_t now = micros();
+
+    portENTER_CRITICAL(&trackerMux);
+    if (activeMove.active) {
+        recordFailure(activeMove, false);
+    }
+    activeMove = {true, false, (int8_t)fromMode, (int8_t)toMode,
+                  (int16_t)startPos, (int16_t)targetPos, now, 0};
+    portEXIT_CRITICAL(&trackerMux);
+}
+
+void updateMoveTracking(const ServoTelemetry& t) {
+    portENTER_CRITICAL(&trackerMux);
+    ActiveMove& m = activeMove;
+
+    // Ignore samples read before the command went out
+    if (!m.active || (int32_t)(t.timestampUs - m.commandUs) <= 0) {
+        portEXIT_CRITICAL(&trackerMux);
+        return;
+    }
+
+    if (!m.moved && (t.moving || abs(t.position - m.startPos) > MOTION_TOLERANCE)) {
+        m.moved = true;
+        m.firstMotionUs = t.timestampUs;
+    }
+
+    if (abs(t.position - m.targetPos) <= MOTION_TOLERANCE && !t.moving) {
+        recordArrival(m, t.timestampUs);
+        arrivedServoPos = m.targetPos;
+        m.active = false;
+    } else if (t.timestampUs - m.commandUs > MOVE_TIMEOUT_MS * 1000UL) {
+        recordFailure(m, true);
+        m.active = false;
+    }
+    portEXIT_CRITICAL(&trackerMux);
+}
+
+bool isMoveInProgress() {
+    return activeMove.active;
+}
+
+int getArrivedServoPos() {
+    return arrivedServoPos;
+}
+
+// Sorts a copy of the window and fills in the summary
+static void summarize(const uint16_t* arrival, const uint16_t* dead, int count,
+                      uint16_t timeouts, uint16_t superseded, LatencySummary& out) {
+    out = {(uint16_t)count, timeouts, superseded, 0, 0, 0, 0};
+    if (count == 0) return;
+
+    uint16_t sorted[LATENCY_OVERALL_WINDOW];
+    uint32_t sum = 0, deadSum = 0;
+    for (int i = 0; i < count; ++i) {
+        sorted[i] = arrival[i];
+        sum += arrival[i];
+        deadSum += dead[i];
+    }
+    std::sort(sorted, sorted + count);
+
+    int p99Index = (count * 99 + 99) / 100 - 1;
+    out.minMs = sorted[0] / 10.0f;
+    out.avgMs = sum / 10.0f / count;
+    out.p99Ms = sorted[p99Index] / 10.0f;
+    out.deadAvgMs = deadSum / 10.0f / count;
+}
+
+bool getTransitionLatency(int fromMode, int toMode, LatencySummary& out) {
+    LatencyWindow copy;
+    portENTER_CRITICAL(&trackerMux);
+    LatencyWindow* w = statsFor(fromMode, toMode);
+    if (w != nullptr) copy = *w;
+    portEXIT_CRITICAL(&trackerMux);
+
+    if (w == nullptr) return false;
+    summarize(copy.arrival, copy.deadTime, copy.count, copy.timeouts, copy.superseded, out);
+    return true;
+}
+
+void getOverallLatency(LatencySummary& out) {
+    static OverallWindow copy;  // Too large for a comfortable stack copy
+    portENTER_CRITICAL(&trackerMux);
+    copy = overallStats;
+    portEXIT_CRITICAL(&trackerMux);
+
+    summarize(copy.arrival, copy.deadTime, copy.count, copy.timeouts, copy.superseded, out);
+}
+
+void resetMoveLatency() {
+    portENTER_CRITICAL(&trackerMux);
+    memset(transitionStats, 0, sizeof(transitionStats));
+    memset(&overallStats, 0, sizeof(overallStats));
+    portEXIT_CRITICAL(&trackerMux);
+}
+
+void printMoveLatency() {
+    Serial.println("⏱️ Actuation latency (command → in position)");
+    Serial.println("  from → to   count    min     avg     p99    dead  timeouts");
+
+    for (int from = 1; from <= numRanges; ++from) {
+        for (int to = 1; to <= numRanges; ++to) {
+            LatencySummary s;
+            if (from == to || !getTransitionLatency(from, to, s)) continue;
+            if (s.count == 0 && s.timeouts == 0) continue;
+            Serial.printf("  %2d → %2d   %5u  %6.1f  %6.1f  %6.1f  %6.1f  %u\n",
+                          from, to, s.count, s.minMs, s.avgMs, s.p99Ms, s.deadAvgMs, s.timeouts);
+        }
+    }
+
+    LatencySummary all;
+    getOverallLatency(all);
+    Serial.printf("  overall   %5u  %6.1f  %6.1f  %6.1f  %6.1f  %u (superseded %u)\n",
+                  all.count, all.minMs, all.avgMs, all.p99Ms, all.deadAvgMs,
+                  all.timeouts, all.superseded);
+    Serial.printf("  Move in progress: %s, last arrived position: %d\n",
+                  isMoveInProgress() ? "yes" : "no", getArrivedServoPos());
+}
@@ -6,12 +6,26 @@
 #include "../include/pin_utils.h"
 #include "../include/rpm.h"
 #include "../include/state.h"
+#include "../include/servo_telemetry.h"
+#include "../include/motion.h"
+#include "../include/actuators.h"
+#include "../include/calibration.h"
+#include "../include/control.h"
+#include "../include/perf.h"
+#include "../include/udp_telemetry.h"
 
 const int MAX_RANGES = 12;
+static_assert(MAX_RANGES <= MOTION_MAX_MODES, "CONFIG_DOC_SIZE and the profile table assume MOTION_MAX_MODES");
 int32_t numRanges = 0;
 int32_t modeRanges[MAX_RANGES][2];
 int32_t modeServoPositions[MAX_RANGES];
 
+static void commitAndClose(nvs_handle_t handle) {
+  PERF_SCOPE(PERF_NVS_COMMIT);
+  nvs_commit(handle);
+  nvs_close(handle);
+}
+
 void setDefaultRanges() {
   numRanges = 4;
   modeRanges[0][0] = 0;       modeRanges[0][1] = 3000;
@@ -20,6 +34,8 @@ void setDefaultRanges() {
   modeRanges[3][0] = 8001;    modeRanges[3][1] = 14000;
 }
 
+// Boot critical path: only fallbacks and failures are printed here,
+// "nvs list" shows what was loaded
 void initNVS() {
   if (nvs_flash_init() != ESP_OK) {
     Serial.println("❌ NVS initialization failed.");
@@ -31,16 +47,15 @@ void initNVS() {
     Serial.println("⚠️ No stored ranges found. Using defaults...");
     setDefaultRanges();
     storeRanges();
-  } else {
-    Serial.println("✅ Loaded RPM ranges from NVS.");
   }
 
+  // === Servo End Stops ===
+  loadServoLimits();
+
   // === Servo Positions ===
   if (!loadServoPositions()) {
     Serial.println("⚠️ No stored servo positions found. Using default 0° positions.");
     generateServoPositions(numRanges);
-  } else {
-    Serial.println("✅ Loaded servo positions from NVS.");
   }
 
   // === Mechanical Parameters ===
@@ -49,9 +64,19 @@ void initNVS() {
     setPinionRadius(15.5);    // mm
     setRackLength(57.0);      // mm
     storeMechanicalParams();
-  } else {
-    Serial.println("✅ Loaded pinion & rack values from NVS.");
   }
+  // === Motion Profiles ===
+  if (!loadMotionProfiles()) {
+    Serial.println("⚠️ No motion profiles found. Using defaults.");
+    resetMotionProfiles();
+  }
+
+  // === Actuators ===
+  if (!loadActuators()) {
+    Serial.println("⚠️ No actuator table found. Using the single default servo.");
+    setDefaultActuators();
+  }
+
   // === Pin Assignments ===
   loadPinAssignments();
 }
@@ -67,10 +92,11 @@ void eraseNVS() {
   }
 }
 
-void storeRanges() {
-  nvs_handle_t handle;
-  if (nvs_open("storage", NVS_READWRITE, &handle) != ESP_OK) return;
+// === Writers ===
+// Each store*() below is one of these plus a commit; storeConfig()
+// runs them all under a single commit.
 
+static void writeRanges(nvs_handle_t handle) {
   nvs_set_i32(handle, "numRanges", numRanges);
 
   for (int i = 0; i < numRanges; i++) {
@@ -80,9 +106,67 @@ void storeRanges() {
     nvs_set_i32(handle, key0, modeRanges[i][0]);
     nvs_set_i32(handle, key1, modeRanges[i][1]);
   }
+}
 
-  nvs_commit(handle);
+static void writeServoPositions(nvs_handle_t handle) {
+  for (int i = 0; i < numRanges; ++i) {
+    char key[20];
+    sprintf(key, "servo_pos_%d", i);
+    int32_t pos = getServoPositionForMode(i + 1);
+    nvs_set_i32(handle, key, pos);
+  }
+}
+
+static void writeMechanicalParams(nvs_handle_t handle) {
+  nvs_set_i32(handle, "rack_len", (int32_t)(getRackLength() * 1000));
+  nvs_set_i32(handle, "pinion_rad", (int32_t)(getPinionRadius() * 1000));
+}
+
+static void writePinAssignments(nvs_handle_t handle) {
+  nvs_set_i32(handle, "rpm_pin", getRpmPin());
+  nvs_set_i32(handle, "mode_button_pin", getModeSwitchButtonPin());
+  nvs_set_i32(handle, "servo_rx_pin", SERVO_RX);
+  nvs_set_i32(handle, "servo_tx_pin", SERVO_TX);
+  nvs_set_i32(handle, "movement_pin", getMovementPin());
+  nvs_set_i32(handle, "mark_pin", getMarkPin());
+}
+
+static void writeMotionProfiles(nvs_handle_t handle) {
+  nvs_set_blob(handle, "motion_prof", motionProfiles, sizeof(motionProfiles));
+}
+
+static void writeModeHysteresis(nvs_handle_t handle) {
+  nvs_set_i32(handle, "mode_hyst", getModeHysteresis());
+}
+
+void storeRanges() {
+  disarmModeBoundaries();  // Bounds of the old table are stale
+
+  nvs_handle_t handle;
+  if (nvs_open("storage", NVS_READWRITE, &handle) != ESP_OK) return;
+
+  writeRanges(handle);
+
+  commitAndClose(handle);
+}
+
+bool storeConfig() {
+  disarmModeBoundaries();
+
+  nvs_handle_t handle;
+  if (nvs_open("storage", NVS_READWRITE, &handle) != ESP_OK) return false;
+
+  writeRanges(handle);
+  writeServoPositions(handle);
+  writeMechanicalParams(handle);
+  writePinAssignments(handle);
+  writeMotionProfiles(handle);
+  writeModeHysteresis(handle);
+
+  PERF_SCOPE(PERF_NVS_COMMIT);
+  bool ok = nvs_commit(handle) == ESP_OK;
   nvs_close(handle);
+  return ok;
 }
 
 bool loadRanges() {
@@ -157,6 +241,12 @@ void listNVSContents() {
     Serial.printf("\n⍉ Pinion Radius: %.3f mm\n", pinion / 1000.0f);
   }
 
+  // === SERVO TELEMETRY ===
+  int32_t pollHz;
+  if (nvs_get_i32(handle, "servo_poll_hz", &pollHz) == ESP_OK) {
+    Serial.printf("\n📡 Servo Poll Rate: %d Hz\n", pollHz);
+  }
+
   // === PIN DEFINITIONS ===
   int32_t rpmPin, buttonPin, movementPin, rxPin, txPin, markPin;
 
@@ -224,15 +314,9 @@ void storeServoPositions() {
   nvs_handle_t handle;
   if (nvs_open("storage", NVS_READWRITE, &handle) != ESP_OK) return;
 
-  for (int i = 0; i < numRanges; ++i) {
-    char key[20];
-    sprintf(key, "servo_pos_%d", i);
-    int32_t pos = getServoPositionForMode(i + 1);
-    nvs_set_i32(handle, key, pos);
-  }
+  writeServoPositions(handle);
 
-  nvs_commit(handle);
-  nvs_close(handle);
+  commitAndClose(handle);
 }
 
 bool loadServoPositions() {
@@ -256,11 +340,9 @@ void storeMechanicalParams() {
   nvs_handle_t handle;
   if (nvs_open("storage", NVS_READWRITE, &handle) != ESP_OK) return;
 
-  nvs_set_i32(handle, "rack_len", (int32_t)(getRackLength() * 1000));
-  nvs_set_i32(handle, "pinion_rad", (int32_t)(getPinionRadius() * 1000));
+  writeMechanicalParams(handle);
 
-  nvs_commit(handle);
-  nvs_close(handle);
+  commitAndClose(handle);
 }
 
 bool loadMechanicalParams() {
@@ -283,14 +365,8 @@ void storePinAssignments() {
   nvs_handle_t handle;
   if (nvs_open("storage", NVS_READWRITE, &handle) != ESP_OK) return;
 
-  nvs_set_i32(handle, "rpm_pin", getRpmPin());
-  nvs_set_i32(handle, "mode_button_pin", getModeSwitchButtonPin());
-  nvs_set_i32(handle, "servo_rx_pin", SERVO_RX);
-  nvs_set_i32(handle, "servo_tx_pin", SERVO_TX);
-  nvs_set_i32(handle, "movement_pin", getMovementPin());
-  nvs_set_i32(handle, "mark_pin", getMarkPin());
-  nvs_commit(handle);
-  nvs_close(handle);
+  writePinAssignments(handle);
+  commitAndClose(handle);
 }
 
 
@@ -307,7 +383,6 @@ bool loadPinAssignments() {
   // === RPM PIN ===
   if (nvs_get_i32(handle, "rpm_pin", &val) == ESP_OK) {
     setRpmPin(val);
-    Serial.printf("✅ Loaded RPM pin: %d\n", val);
   } else {
     // setRpmPin(DEFAULT_RPM_PIN);  // e.g. 18
     // nvs_set_i32(handle, "rpm_pin", DEFAULT_RPM_PIN);
@@ -318,7 +393,6 @@ bool loadPinAssignments() {
   // === MODE BUTTON ===
   if (nvs_get_i32(handle, "mode_button_pin", &val) == ESP_OK) {
     setModeSwitchButtonPin(val);
-    Serial.printf("✅ Loaded Mode button pin: %d\n", val);
   } else {
     // setModeSwitchButtonPin(DEFAULT_MODE_BUTTON);
     // nvs_set_i32(handle, "mode_button_pin", DEFAULT_MODE_BUTTON);
@@ -329,7 +403,6 @@ bool loadPinAssignments() {
   // === MOVEMENT PIN ===
   if (nvs_get_i32(handle, "movement_pin", &val) == ESP_OK) {
     setMovementPin(val);
-    Serial.printf("✅ Loaded Movement pin: %d\n", val);
   } else {
     // setMovementPin(DEFAULT_MOVEMENT_PIN);  // e.g. 10
     // nvs_set_i32(handle, "movement_pin", DEFAULT_MOVEMENT_PIN);
@@ -340,7 +413,6 @@ bool loadPinAssignments() {
   // === MARK PIN ===
   if (nvs_get_i32(handle, "mark_pin", &val) == ESP_OK) {
     setMarkPin(val);
-    Serial.printf("✅ Loaded Mark pin: %d\n", val);
   } else {
     // setMovementPin(DEFAULT_MOVEMENT_PIN);  // e.g. 10
     // nvs_set_i32(handle, "movement_pin", DEFAULT_MOVEMENT_PIN);
@@ -352,7 +424,6 @@ bool loadPinAssignments() {
   if (nvs_get_i32(handle, "servo_rx_pin", &val) == ESP_OK && 
       nvs_get_i32(handle, "servo_tx_pin", &val1) == ESP_OK ) {
         configureServoPins(val, val1);
-    Serial.printf("✅ Loaded Servo RX pin: %d\n", val);
   } else {
     // setServoRxPin(DEFAULT_SERVO_RX);
     // nvs_set_i32(handle, "servo_rx_pin", DEFAULT_SERVO_RX);
@@ -364,9 +435,175 @@ bool loadPinAssignments() {
 
   if (updated) {
     Serial.println("💾 Some pin values were missing — default values written to NVS.");
+    PERF_SCOPE(PERF_NVS_COMMIT);
     nvs_commit(handle);
   }
 
   nvs_close(handle);
   return true;
 }
+
+void storeServoPollRate() {
+  nvs_handle_t handle;
+  if (nvs_open("storage", NVS_READWRITE, &handle) != ESP_OK) return;
+
+  nvs_set_i32(handle, "servo_poll_hz", getServoPollRate());
+
+  commitAndClose(handle);
+}
+
+bool loadServoPollRate() {
+  nvs_handle_t handle;
+  if (nvs_open("storage", NVS_READONLY, &handle) != ESP_OK) return false;
+
+  int32_t hz;
+  bool found = nvs_get_i32(handle, "servo_poll_hz", &hz) == ESP_OK;
+  if (found) {
+    setServoPollRate(hz);
+  }
+
+  nvs_close(handle);
+  return found;
+}
+
+void storeMotionProfiles() {
+  nvs_handle_t handle;
+  if (nvs_open("storage", NVS_READWRITE, &handle) != ESP_OK) return;
+
+  writeMotionProfiles(handle);
+
+  commitAndClose(handle);
+}
+
+bool loadMotionProfiles() {
+  nvs_handle_t handle;
+  if (nvs_open("storage", NVS_READONLY, &handle) != ESP_OK) return false;
+
+  size_t size = sizeof(motionProfiles);
+  bool found = nvs_get_blob(handle, "motion_prof", motionProfiles, &size) == ESP_OK &&
+               size == sizeof(motionProfiles);
+
+  nvs_close(handle);
+  return found;
+}
+
+void storeActuators() {
+  nvs_handle_t handle;
+  if (nvs_open("storage", NVS_READWRITE, &handle) != ESP_OK) return;
+
+  nvs_set_i32(handle, "act_count", actuatorCount);
+  nvs_set_blob(handle, "act_table", actuators, sizeof(actuators));
+
+  commitAndClose(handle);
+}
+
+bool loadActuators() {
+  nvs_handle_t handle;
+  if (nvs_open("storage", NVS_READONLY, &handle) != ESP_OK) return false;
+
+  int32_t count = 0;
+  size_t size = sizeof(actuators);
+  bool found = nvs_get_i32(handle, "act_count", &count) == ESP_OK &&
+               count >= 1 && count <= MAX_ACTUATORS &&
+               nvs_get_blob(handle, "act_table", actuators, &size) == ESP_OK &&
+               size == sizeof(actuators);
+  if (found) actuatorCount = count;
+
+  nvs_close(handle);
+  return found;
+}
+
+void storeServoLimits() {
+  nvs_handle_t handle;
+  if (nvs_open("storage", NVS_READWRITE, &handle) != ESP_OK) return;
+
+  nvs_set_i32(handle, "servo_min", servoMinPos);
+  nvs_set_i32(handle, "servo_max", servoMaxPos);
+
+  commitAndClose(handle);
+}
+
+bool loadServoLimits() {
+  nvs_handle_t handle;
+  if (nvs_open("storage", NVS_READONLY, &handle) != ESP_OK) return false;
+
+  bool found = nvs_get_i32(handle, "servo_min", &servoMinPos) == ESP_OK &&
+               nvs_get_i32(handle, "servo_max", &servoMaxPos) == ESP_OK;
+  if (!found) clearServoLimits();
+
+  nvs_close(handle);
+  return found && servoLimitsCalibrated();
+}
+
+void storeControlRate() {
+  nvs_handle_t handle;
+  if (nvs_open("storage", NVS_READWRITE, &handle) != ESP_OK) return;
+
+  nvs_set_i32(handle, "ctrl_hz", getControlRate());
+
+  commitAndClose(handle);
+}
+
+bool loadControlRate() {
+  nvs_handle_t handle;
+  if (nvs_open("storage", NVS_READONLY, &handle) != ESP_OK) return false;
+
+  int32_t hz;
+  bool found = nvs_get_i32(handle, "ctrl_hz", &hz) == ESP_OK;
+  if (found) {
+    setControlRate(hz);
+  }
+
+  nvs_close(handle);
+  return found;
+}
+
+void storeModeHysteresis() {
+  nvs_handle_t handle;
+  if (nvs_open("storage", NVS_READWRITE, &handle) != ESP_OK) return;
+
+  writeModeHysteresis(handle);
+
+  commitAndClose(handle);
+}
+
+bool loadModeHysteresis() {
+  nvs_handle_t handle;
+  if (nvs_open("storage", NVS_READONLY, &handle) != ESP_OK) return false;
+
+  int32_t rpm;
+  bool found = nvs_get_i32(handle, "mode_hyst", &rpm) == ESP_OK;
+  if (found) {
+    setModeHysteresis(rpm);
+  }
+
+  nvs_close(handle);
+  return found;
+}
+
+void storeUdpTelemetry() {
+  nvs_handle_t handle;
+  if (nvs_open("storage", NVS_READWRITE, &handle) != ESP_OK) return;
+
+  nvs_set_i32(handle, "udp_on", isUdpTelemetryEnabled());
+  nvs_set_i32(handle, "udp_hz", getUdpTelemetryRate());
+  nvs_set_i32(handle, "udp_mcast", isUdpTelemetryMulticast());
+
+  commitAndClose(handle);
+}
+
+bool loadUdpTelemetry() {
+  nvs_handle_t handle;
+  if (nvs_open("storage", NVS_READONLY, &handle) != ESP_OK) return false;
+
+  int32_t on, hz, mcast;
+  bool found = nvs_get_i32(handle, "udp_on", &on) == ESP_OK &&
+               nvs_get_i32(handle, "udp_hz", &hz) == ESP_OK &&
+               nvs_get_i32(handle, "udp_mcast", &mcast) == ESP_OK;
+  if (found) {
+    setUdpTelemetry(on, hz, mcast);
+  }
+
+  nvs_close(handle);
+  return found;
+}
@@ -0,0 +1,90 @@
+#include <Arduino.h>
+#include "../include/perf.h"
+
+volatile bool perfEnabled = true;
+
+static portMUX_TYPE perfMux = portMUX_INITIALIZER_UNLOCKED;
+static PerfStats perfStats[PERF_PROBE_COUNT];
+
+static const char* const PERF_PROBE_NAMES[PERF_PROBE_COUNT] = {
+    "rpm_isr",
+    "rpm_read",
+    "control",
+    "servo_bus",
+    "servo_poll",
+    "nvs_commit",
+    "http",
+    "json",
+    "cli",
+};
+
+void IRAM_ATTR perfRecord(PerfProbe probe, uint32_t cycles) {
+    int bits = cycles ? 32 - __builtin_clz(cycles) : 0;
+    int bucket = constrain(bits - 1 - PERF_HIST_SHIFT, 0, PERF_HIST_BUCKETS - 1);
+
+    // Probes fire from the RPM ISR as well as from tasks
+    portENTER_CRITICAL_SAFE(&perfMux);
+    PerfStats& s = perfStats[probe];
+    if (s.count == 0 || cycles < s.minCycles) s.minCycles = cycles;
+    if (cycles > s.maxCycles) s.maxCycles = cycles;
+    s.sumCycles += cycles;
+    s.count++;
+    s.histogram[bucket]++;
+    portEXIT_CRITICAL_SAFE(&perfMux);
+}
+
+void getPerfStats(PerfProbe probe, PerfStats& out) {
+    portENTER_CRITICAL(&perfMux);
+    out = perfStats[probe];
+    portEXIT_CRITICAL(&perfMux);
+}
+
+const char* getPerfProbeName(PerfProbe probe) {
+    return probe < PERF_PROBE_COUNT ? PERF_PROBE_NAMES[probe] : "unknown";
+}
+
+float perfCyclesToUs(uint32_t cycles) {
+    return (float)cycles / ESP.getCpuFreqMHz();
+}
+
+void resetPerfStats() {
+    portENTER_CRITICAL(&perfMux);
+    memset(perfStats, 0, sizeof(perfStats));
+    portEXIT_CRITICAL(&perfMux);
+}
+
+void setPerfEnabled(bool enabled) {
+    perfEnabled = enabled;
+}
+
+void printPerfStats() {
+    Serial.printf("📊 Profiler %s (CPU %lu MHz, PERF_ENABLED=%d)\n",
+                  perfEnabled ? "on" : "off", (unsigned long)ESP.getCpuFreqMHz(), PERF_ENABLED);
+    Serial.println("  probe          count      min µs     avg µs     max µs");
+
+    for (int p = 0; p < PERF_PROBE_COUNT; ++p) {
+        PerfStats s;
+        getPerfStats((PerfProbe)p, s);
+        if (s.count == 0) continue;
+
+        float avgCycles = (float)s.sumCycles / s.count;
+        Serial.printf("  %-12s %8lu %10.2f %10.2f %10.2f\n",
+                      getPerfProbeName((PerfProbe)p), (unsigned long)s.count,
+                      perfCyclesToUs(s.minCycles), avgCycles / ESP.getCpuFreqMHz(),
+                      perfCyclesToUs(s.maxCycles));
+
+        // Histogram, non-empty buckets only: "<upper bound µs>:count"
+        Serial.print("               ");
+        for (int b = 0; b < PERF_HIST_BUCKETS; ++b) {
+            if (s.histogram[b] == 0) continue;
+            if (b == PERF_HIST_BUCKETS - 1) {
+                Serial.printf(" ≥%.1f:%lu", perfCyclesToUs(1UL << (b + PERF_HIST_SHIFT)),
+                              (unsigned long)s.histogram[b]);
+            } else {
+                Serial.printf(" <%.1f:%lu", perfCyclesToUs(1UL << (b + PERF_HIST_SHIFT + 1)),
+                              (unsigned long)s.histogram[b]);
+            }
+        }
+        Serial.println();
+    }
+}
@@ -2,6 +2,8 @@
 #include "include/rpm_data.h"
 #include "include/nvs_utils.h"
 #include "include/rpm.h"
+#include "include/perf.h"
+#include "include/trace.h"
 #include <pins_arduino.h>
 
 // === Internal Timing Variables ===
@@ -15,8 +17,24 @@ RPMSource currentRPMSource = SENSOR;  // Default source
 
 int RPM_SENSOR_PIN = 18;
 
+// === Mode Boundaries (period space) ===
+// rpm = 1e6 / period * 120 / 36, so an RPM threshold maps to a fixed
+// period in µs and the ISR can test the current mode with two integer
+// compares instead of a division and a range search.
+static const float RPM_PERIOD_CONSTANT = 1000000.0 * 120.0 / 36.0;
+
+static portMUX_TYPE boundaryMux = portMUX_INITIALIZER_UNLOCKED;
+static volatile bool boundariesArmed = false;
+static volatile uint32_t boundaryMinPeriodUs = 0;           // At or below: left upwards
+static volatile uint32_t boundaryMaxPeriodUs = UINT32_MAX;  // Above: left downwards
+static volatile uint32_t lastCrossingUs = 0;
+static volatile uint32_t crossingCount = 0;
+static TaskHandle_t crossingTask = nullptr;
+static int modeHysteresisRpm = 0;
+
 // === Sensor Interrupt Service Routine ===
 void IRAM_ATTR rpmSensorISR() {
+    PERF_SCOPE(PERF_RPM_ISR);
     static unsigned long last_rise_time = 0;
     unsigned long current_time = micros();
 
@@ -26,7 +44,23 @@ void IRAM_ATTR rpmSensorISR() {
         if (risingEdgeDetected) {
             t2 = current_time;
             if (t1 < t2) {
-                period = t2 - t1;
+                uint32_t periodUs = t2 - t1;
+                period = periodUs;
+                traceEvent(TRACE_RPM_EDGE, TRACE_INSTANT, periodUs);
+
+                if (boundariesArmed &&
+                    (periodUs <= boundaryMinPeriodUs || periodUs > boundaryMaxPeriodUs)) {
+                    // One wake-up per crossing; the control task re-arms
+                    boundariesArmed = false;
+                    lastCrossingUs = current_time;
+                    crossingCount++;
+                    traceEvent(TRACE_MODE_CROSSING, TRACE_INSTANT, periodUs);
+                    if (crossingTask != nullptr) {
+                        BaseType_t woken = pdFALSE;
+                        vTaskNotifyGiveFromISR(crossingTask, &woken);
+                        if (woken) portYIELD_FROM_ISR();
+                    }
+                }
             }
             risingEdgeDetected = false;
         } else {
@@ -89,6 +123,7 @@ float getCurrentRPM() {
 
 // === Unified RPM Accessor Based on Input Source ===
 float getRPMUnified() {
+    PERF_SCOPE(PERF_RPM_READ);
     if (currentRPMSource == SIMULATED) {
         rpm = simulateMoto3RPM();  // overwrite directly
     }
@@ -108,4 +143,57 @@ void setRpmPin(int pin) {
     detachInterrupt(digitalPinToInterrupt(RPM_SENSOR_PIN));
     RPM_SENSOR_PIN = pin;
     initRpmSensorInterrupt();
-}
\ No newline at end of file
+}
+
+// === Mode Boundary Detection ===
+void armModeBoundaries(int mode) {
+    if (mode < 1 || mode > numRanges) {
+        disarmModeBoundaries();
+        return;
+    }
+
+    // determineMode() truncates, so mode m covers [lo, hi + 1) RPM
+    float upRpm = modeRanges[mode - 1][1] + 1 + modeHysteresisRpm;
+    float downRpm = modeRanges[mode - 1][0] - modeHysteresisRpm;
+
+    uint32_t minPeriod = (uint32_t)(RPM_PERIOD_CONSTANT / upRpm);
+    uint32_t maxPeriod = (downRpm > 0) ? (uint32_t)(RPM_PERIOD_CONSTANT / downRpm) : UINT32_MAX;
+
+    portENTER_CRITICAL(&boundaryMux);
+    boundaryMinPeriodUs = minPeriod;
+    boundaryMaxPeriodUs = maxPeriod;
+    boundariesArmed = true;
+    portEXIT_CRITICAL(&boundaryMux);
+}
+
+void disarmModeBoundaries() {
+    boundariesArmed = false;
+}
+
+bool modeBoundariesArmed() {
+    return boundariesArmed;
+}
+
+void setModeCrossingTask(TaskHandle_t task) {
+    crossingTask = task;
+}
+
+uint32_t getLastCrossingUs() {
+    return lastCrossingUs;
+}
+
+uint32_t getModeCrossingCount() {
+    return crossingCount;
+}
+
+void setModeHysteresis(int rpm) {
+    modeHysteresisRpm = max(rpm, 0);
+}
+
+int getModeHysteresis() {
+    return modeHysteresisRpm;
+}
+
+bool isRPMFromSensor() {
+    return currentRPMSource == SENSOR;
+}
@@ -3,12 +3,18 @@
 #define DEFAULT_SERVO_TX 3
 
 #include <Arduino.h>
-#include <SCServo.h>
 #include "include/rpm_data.h"
 #include "include/rpm.h"
 #include "include/nvs_utils.h"
 #include "include/pin_utils.h"
 #include "include/servo.h"
+#include "include/servo_telemetry.h"
+#include "include/motion.h"
+#include "include/move_tracker.h"
+#include "include/actuators.h"
+#include "include/calibration.h"
+#include "include/trace.h"
+#include "include/boot.h"
 
 
 
@@ -23,12 +29,48 @@ float pinionRadius = 15.5; // mm
 
 float maxServoDegrees = 0;
 
-SMS_STS st;
+StsBus stsBus;
 HardwareSerial servoSerial(1);;
 
 int lastServoPos = -1;
+int lastServoMode = -1;
 bool servoFollowingEnabled = false;
 
+static SemaphoreHandle_t servoBusMutex = nullptr;
+
+// ===== Bus Access =====
+
+void servoBusInit() {
+    if (servoBusMutex == nullptr) servoBusMutex = xSemaphoreCreateMutex();
+}
+
+// servoBusInit() has run first thing in setup(), before anything
+// (NVS pin loading included) touches the bus
+bool servoBusLock(uint32_t timeoutMs) {
+    TickType_t ticks = (timeoutMs == portMAX_DELAY) ? portMAX_DELAY : pdMS_TO_TICKS(timeoutMs);
+    return xSemaphoreTake(servoBusMutex, ticks) == pdTRUE;
+}
+
+void servoBusUnlock() {
+    xSemaphoreGive(servoBusMutex);
+}
+
+StsStatus servoWritePosEx(int pos, int speed, int acc) {
+    if (!servoBusLock()) return StsStatus::BUS_BUSY;
+    StsStatus result = stsBus.writePosEx(getActuatorId(0), pos, speed, acc);
+    servoBusUnlock();
+    if (result == StsStatus::OK) markBootPhase(BOOT_FIRST_SERVO_CMD);
+    return result;
+}
+
+int servoReadPos() {
+    if (!servoBusLock()) return -1;
+    int16_t pos = -1;
+    StsStatus result = stsBus.readPos(getActuatorId(0), pos);
+    servoBusUnlock();
+    return (result == StsStatus::OK || result == StsStatus::SERVO_ERROR) ? pos : -1;
+}
+
 // ===== Initialization =====
 
 void calculateMaxServoDegrees(){
@@ -36,18 +78,37 @@ void calculateMaxServoDegrees(){
 }
 
 void servo_init_uart() {
-    servoSerial.end();  // In case it was previously running
-    delay(50);
+    servoBusLock(portMAX_DELAY);
+    if (servoSerial) {  // In case it was previously running
+        servoSerial.end();
+        delay(50);
+    }
     servoSerial.begin(1000000, SERIAL_8N1, SERVO_RX, SERVO_TX);
-    st.pSerial = &servoSerial;
+    stsBus.begin(UART_NUM_1);
+    stsBus.detectEcho(getActuatorId(0));
+    servoBusUnlock();
+}
+
+// Polls until the servo answers instead of a fixed power-up delay
+static bool waitForServo(uint32_t timeoutMs) {
+    uint32_t start = millis();
+    do {
+        if (servoBusLock()) {
+            StsStatus status = stsBus.ping(getActuatorId(0));
+            servoBusUnlock();
+            if (status == StsStatus::OK || status == StsStatus::SERVO_ERROR) return true;
+        }
+        delay(SERVO_BOOT_POLL_MS);
+    } while (millis() - start < timeoutMs);
+    return false;
 }
 
 void servo_initialize() {
-    delay(300);
-    st.WritePosEx(SERVO_ID, 0, 0, 20);  // Move to 0°
-    Serial.println("About to initialize movement pin from servo.cpp");
+    if (!waitForServo(SERVO_BOOT_WAIT_MS)) {
+        Serial.println("⚠️ Servo did not answer at startup");
+    }
+    servoWritePosEx(0, 0, 20);  // Move to 0°
     initMovementPin();
-    delay(500);
     calculateMaxServoDegrees();
 }
 
@@ -61,6 +122,12 @@ void servo_defaultInit() {
     // generateServoPositions(numRanges); 
 }
 
+void servo_bootInit() {
+    if (!servoSerial) servo_init_uart();  // initNVS() starts it when pins are stored
+    servo_initialize();
+    markBootPhase(BOOT_SERVO_BUS);
+}
+
 // ===== Dynamic CLI function =====
 bool configureServoPins(int rx, int tx) {
     // Sanity check for valid GPIOs
@@ -69,6 +136,9 @@ bool configureServoPins(int rx, int tx) {
         return false;
     }
 
+    // Keep the telemetry poller off the bus while the UART is swapped
+    servoBusLock(portMAX_DELAY);
+
     // Stop current UART only if active
     if (servoSerial) {
         servoSerial.flush();  // Finish any pending tx
@@ -83,10 +153,11 @@ bool configureServoPins(int rx, int tx) {
 
     // Re-initialize UART
     servoSerial.begin(1000000, SERIAL_8N1, SERVO_RX, SERVO_TX);
-    st.pSerial = &servoSerial;
+    stsBus.begin(UART_NUM_1);
 
-    // Optional: Try a no-op read to ensure communication doesn’t crash the system
-    short dummy = st.ReadPos(SERVO_ID);
+    // Probe the bus; this also learns whether TX is echoed back on RX
+    stsBus.detectEcho(getActuatorId(0));
+    servoBusUnlock();
 
     // Avoid calling generateServoPositions here to prevent overwriting custom values
     // You can do it manually via CLI if needed
@@ -101,6 +172,9 @@ void setServoAngle(int degrees) {
         Serial.println("⚠️ maxServoDegrees not initialized!");
     }
     int pos = int(4096 * (degrees / 360.0));
+    if (servoLimitsCalibrated()) {
+        pos = constrain(pos, getServoMinUsable(), getServoMaxUsable());  // Stay off the end stops
+    }
 
     // Signal movement ON if angle > 0, OFF otherwise
     if (degrees > 0) {
@@ -109,14 +183,18 @@ void setServoAngle(int degrees) {
         setMovementLow();
     }
 
-    st.WritePosEx(SERVO_ID, pos, 0, 50);
+    servoWritePosEx(pos, 0, 50);
     lastServoPos = pos;
+    lastServoMode = -1;
     // Serial.printf("Set Servo Angle: %d° (pos: %d)\n", degrees, pos);
 }
 
 // Get current angle (converted from pos)
+// Served from the telemetry snapshot when it is fresh, otherwise read directly
 int getServoAngle() {
-    short pos = st.ReadPos(SERVO_ID);
+    ServoTelemetry t;
+    getServoTelemetry(t);
+    short pos = (t.valid && getServoTelemetryAge() < 250) ? t.position : servoReadPos();
     return int((pos / 4096.0) * 360.0);
 }
 
@@ -164,7 +242,8 @@ void updateServoIfFollowing() {
 
     float currentRPM = getRPMUnified();
     int modeNow = determineMode(currentRPM);
-    int targetPos = modeServoPositions[modeNow - 1];
+    if (modeNow < 1) return;  // Out of all ranges, hold position
+    int targetPos = getActuatorModePosition(0, modeNow);
 
     // Signal movement ON if angle > 0, OFF otherwise
     if (targetPos > 0) {
@@ -174,13 +253,55 @@ void updateServoIfFollowing() {
     }
 
     if (targetPos != lastServoPos) {
-        st.WritePosEx(SERVO_ID, targetPos, 0, 50);
-        lastServoPos = targetPos;
+        servoMoveToMode(modeNow);
+    } else {
+        lastServoMode = modeNow;  // Modes sharing a position need no move
     }
+    markBootPhase(BOOT_FIRST_FOLLOW);
+}
+
+void servoMoveToMode(int mode) {
+    if (mode < 1 || mode > numRanges) return;
+    MotionProfile profile = getMotionProfile(lastServoMode, mode);
+    servoMoveToMode(mode, profile.speed, profile.acc);
+}
+
+void servoMoveToMode(int mode, uint16_t speed, uint8_t acc) {
+    if (mode < 1 || mode > numRanges) return;
+
+    int targetPos = getActuatorModePosition(0, mode);
+
+    ServoTelemetry t;
+    getServoTelemetry(t);
+
+    traceEvent(TRACE_MODE, TRACE_INSTANT, mode);
+    TRACE_SCOPE(TRACE_SERVO_CMD, targetPos);
+
+    // With more than one stack the whole group goes out in one SYNC_WRITE;
+    // actuator 0 is still the one whose arrival is tracked
+    bool sent = (getActuatorCount() > 1)
+        ? moveActuatorGroup(mode, speed, acc)
+        : servoWritePosEx(targetPos, speed, acc) == StsStatus::OK;
+    if (sent) {
+        beginMoveTracking(lastServoMode, mode, t.position, targetPos);
+    }
+    lastServoPos = targetPos;
+    lastServoMode = mode;
 }
 
 void generateServoPositions(int steps) {
     if (steps < 2 || steps > MAX_RANGES) return;
+
+    // Measured travel wins over the rack/pinion estimate
+    if (servoLimitsCalibrated()) {
+        int first = getServoMinUsable();
+        int span = getServoMaxUsable() - first;
+        for (int i = 0; i < steps; ++i) {
+            modeServoPositions[i] = first + (i * span) / (steps - 1);
+        }
+        storeServoPositions();
+        return;
+    }
   
     for (int i = 0; i < steps; ++i) {
         float degrees = (i * maxServoDegrees) / (steps - 1);
@@ -213,11 +334,14 @@ void servoStatus() {
     // 1. Connection Details
     Serial.print(F("📌 Servo RX Pin: ")); Serial.println(SERVO_RX);
     Serial.print(F("📌 Servo TX Pin: ")); Serial.println(SERVO_TX);
-    Serial.print(F("🔗 Servo ID: ")); Serial.println(SERVO_ID);
+    Serial.print(F("🔗 Servo ID: ")); Serial.println(getActuatorId(0));
+    if (getActuatorCount() > 1) {
+      Serial.printf("🦾 Actuator group: %d stacks (see 'actuator list')\n", getActuatorCount());
+    }
   
     // 2. Attachment and Communication Status
     Serial.print(F("🔧 Servo UART active: "));
-    Serial.println(st.pSerial != nullptr ? "✅ YES" : "❌ NO");
+    Serial.println(stsBus.isReady() ? "✅ YES" : "❌ NO");
   
     // 3. RPM Follow Status
     Serial.print(F("🔁 Servo follows RPM? "));
@@ -241,6 +365,7 @@ void servoStatus() {
     Serial.printf("Rack Length: %f\n", rackLength);
     Serial.printf("Maximum angle of the mechanism: %f\n", maxServoDegrees);
     Serial.printf("Maximum travel of the mechanism: %f\n", maxServoDegrees*pinionRadius);
+    printServoLimits();
   
     // 6. Current Mode and Position
     Serial.print(F("\n📡 Current Mode: "));
@@ -252,8 +377,14 @@ void servoStatus() {
       Serial.printf("❌ Out of range (RPM = %.1f)\n", currentRPM);
   
     Serial.print(F("📍 Current Servo Position: "));
-    int currentPos = st.ReadPos(SERVO_ID);
+    ServoTelemetry t;
+    getServoTelemetry(t);
+    int currentPos = (t.valid && getServoTelemetryAge() < 250) ? t.position : servoReadPos();
     Serial.printf("%d (%.1f°)\n", currentPos, 360.0 * currentPos / 4095.0);
+
+    // 7. Live Feedback
+    Serial.println();
+    printServoTelemetry();
   
     Serial.println(F("\n=============================================\n"));
   }
@@ -268,12 +399,55 @@ float getRackLength() {
 
 void setPinionRadius(float newRadius) {
     pinionRadius = newRadius;
-    storeMechanicalParams();
     calculateMaxServoDegrees();
 }
 
 void setRackLength(float newLength) {
     rackLength = newLength;
-    storeMechanicalParams();
     calculateMaxServoDegrees();
+}
+
+void printServoBusStats() {
+    Serial.println(F("🚌 Servo bus"));
+    Serial.printf("  Ready: %s, echo on RX: %s, timeout: %lu ms\n",
+                  stsBus.isReady() ? "yes" : "no",
+                  stsBus.hasEcho() ? "yes" : "no",
+                  (unsigned long)stsBus.timeoutMs());
+    for (int i = 0; i < (int)StsStatus::COUNT; ++i) {
+        uint32_t n = stsBus.statusCount((StsStatus)i);
+        if (n > 0) Serial.printf("  %-13s %lu\n", stsStatusName((StsStatus)i), (unsigned long)n);
+    }
+}
+
+void servoBenchmark(int iterations) {
+    StsFeedback fb = {};
+    int readOk = 0, writeOk = 0;
+
+    // Hold the bus for the whole run so the poller does not skew the numbers
+    servoBusLock(portMAX_DELAY);
+
+    uint32_t start = micros();
+    for (int i = 0; i < iterations; ++i) {
+        if (stsBus.readFeedback(getActuatorId(0), fb) == StsStatus::OK) readOk++;
+    }
+    uint32_t readUs = micros() - start;
+
+    // Re-command the current position so the servo does not move
+    start = micros();
+    for (int i = 0; i < iterations && readOk > 0; ++i) {
+        if (stsBus.writePosEx(getActuatorId(0), fb.position, 0, 0) == StsStatus::OK) writeOk++;
+    }
+    uint32_t writeUs = micros() - start;
+
+    servoBusUnlock();
+
+    Serial.printf("🏁 Servo bus benchmark (%d iterations, 1 Mbaud)\n", iterations);
+    Serial.printf("  Feedback reads: %d ok, %.1f µs each, %.0f cmd/s\n",
+                  readOk, (float)readUs / iterations, iterations * 1e6f / readUs);
+    if (readOk > 0) {
+        Serial.printf("  Position writes: %d ok, %.1f µs each, %.0f cmd/s\n",
+                      writeOk, (float)writeUs / iterations, iterations * 1e6f / writeUs);
+    } else {
+        Serial.println("  Position writes skipped: no feedback from servo");
+    }
 }
\ No newline at end of file
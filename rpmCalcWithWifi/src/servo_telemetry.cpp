@@ -0,0 +1,143 @@
+#include <Arduino.h>
+#include "../include/servo_telemetry.h"
+#include "../include/servo.h"
+#include "../include/nvs_utils.h"
+#include "../include/move_tracker.h"
+#include "../include/actuators.h"
+#include "../include/perf.h"
+
+// === Snapshot ===
+// The poller is the only writer. Publishing and reading copy one small
+// struct under a spinlock, so a reader above the poller's priority (the
+// control task) can never catch a half-written snapshot and wait on a
+// writer it has itself preempted. One slot per actuator.
+static portMUX_TYPE telemetryMux = portMUX_INITIALIZER_UNLOCKED;
+static ServoTelemetry telemetry[MAX_ACTUATORS] = {};
+
+static volatile int pollRateHz = SERVO_POLL_DEFAULT_HZ;
+static TaskHandle_t pollTaskHandle = nullptr;
+
+static void publishTelemetry(int index, const ServoTelemetry& t) {
+    portENTER_CRITICAL(&telemetryMux);
+    telemetry[index] = t;
+    portEXIT_CRITICAL(&telemetryMux);
+}
+
+bool getActuatorTelemetry(int index, ServoTelemetry& out) {
+    if (index < 0 || index >= MAX_ACTUATORS) return false;
+
+    portENTER_CRITICAL(&telemetryMux);
+    out = telemetry[index];
+    portEXIT_CRITICAL(&telemetryMux);
+    return true;
+}
+
+void getServoTelemetry(ServoTelemetry& out) {
+    getActuatorTelemetry(0, out);
+}
+
+uint32_t getServoTelemetryAge() {
+    ServoTelemetry t;
+    getServoTelemetry(t);
+    if (!t.valid) return UINT32_MAX;
+    return millis() - t.timestampMs;
+}
+
+// === Poller ===
+
+// One read transaction covers the whole block from PRESENT_POSITION_L
+// to PRESENT_CURRENT_H.
+static void pollServoOnce(uint8_t id, ServoTelemetry& t) {
+    if (!servoBusLock()) {
+        t.errorCount++;
+        return;
+    }
+
+    StsFeedback fb;
+    StsStatus status = stsBus.readFeedback(id, fb);
+    servoBusUnlock();
+
+    if (status != StsStatus::OK && status != StsStatus::SERVO_ERROR) {
+        t.errorCount++;
+        return;
+    }
+
+    t.position = fb.position;
+    t.speed = fb.speed;
+    t.load = fb.load;
+    t.voltage = fb.voltage;
+    t.temperature = fb.temperature;
+    t.moving = fb.moving;
+    t.current = fb.current;
+
+    t.timestampMs = millis();
+    t.timestampUs = micros();
+    t.sampleCount++;
+    t.valid = true;
+}
+
+static void servoPollTask(void* arg) {
+    ServoTelemetry local[MAX_ACTUATORS] = {};
+    TickType_t lastWake = xTaskGetTickCount();
+
+    for (;;) {
+        int hz = pollRateHz;
+        if (hz <= 0) {
+            vTaskDelay(pdMS_TO_TICKS(100));
+            lastWake = xTaskGetTickCount();
+            continue;
+        }
+
+        PERF_SCOPE(PERF_SERVO_POLL);
+        int count = getActuatorCount();
+        for (int i = 0; i < count; ++i) {
+            ServoTelemetry& t = local[i];
+            uint32_t samplesBefore = t.sampleCount;
+            pollServoOnce(getActuatorId(i), t);
+            publishTelemetry(i, t);
+            if (t.sampleCount == samplesBefore) continue;
+
+            if (i == 0) updateMoveTracking(t);
+            if (count > 1) updateGroupSkew(i, t.position, t.moving, t.timestampUs);
+        }
+
+        if (isMoveInProgress()) hz = SERVO_POLL_MAX_HZ;
+        TickType_t period = pdMS_TO_TICKS(1000 / hz);
+        vTaskDelayUntil(&lastWake, period > 0 ? period : 1);
+    }
+}
+
+void initServoTelemetry() {
+    if (pollTaskHandle != nullptr) return;
+    loadServoPollRate();
+    xTaskCreate(servoPollTask, "servoPoll", 3072, nullptr, 2, &pollTaskHandle);
+}
+
+void setServoPollRate(int hz) {
+    pollRateHz = constrain(hz, 0, SERVO_POLL_MAX_HZ);
+}
+
+int getServoPollRate() {
+    return pollRateHz;
+}
+
+void printServoTelemetry() {
+    ServoTelemetry t;
+    getServoTelemetry(t);
+
+    Serial.printf("📡 Servo telemetry (poll %d Hz)\n", getServoPollRate());
+    if (!t.valid) {
+        Serial.printf("  ❌ No feedback received yet (%lu errors)\n", (unsigned long)t.errorCount);
+        return;
+    }
+    Serial.printf("  Position:    %d (%.1f°)\n", t.position, 360.0 * t.position / 4095.0);
+    Serial.printf("  Speed:       %d steps/s\n", t.speed);
+    Serial.printf("  Load:        %.1f%%\n", t.load / 10.0);
+    Serial.printf("  Voltage:     %.1f V\n", t.voltage / 10.0);
+    Serial.printf("  Temperature: %d °C\n", t.temperature);
+    Serial.printf("  Current:     %d\n", t.current);
+    Serial.printf("  Moving:      %s\n", t.moving ? "yes" : "no");
+    Serial.printf("  Age:         %lu ms (%lu samples, %lu errors)\n",
+                  (unsigned long)(millis() - t.timestampMs),
+                  (unsigned long)t.sampleCount, (unsigned long)t.errorCount);
+}
@@ -0,0 +1,310 @@
+#include <Arduino.h>
+#include <WiFi.h>
+#include <lwip/sockets.h>
+#include "../include/sse_server.h"
+#include "../include/rpm.h"
+#include "../include/servo.h"
+#include "../include/servo_telemetry.h"
+#include "../include/state.h"
+
+#define SSE_REQUEST_MAX 256
+#define SSE_EVENT_MAX 1024
+
+struct SseSample {
+    uint32_t ms;
+    float rpm;
+    int16_t mode;
+    int16_t target;
+    int16_t actual;
+};
+
+enum SseSlotState : uint8_t {
+    SLOT_FREE,
+    SLOT_HANDSHAKE,   // Waiting for the request headers
+    SLOT_STREAMING
+};
+
+struct SseSlot {
+    WiFiClient client;
+    SseSlotState state;
+    uint32_t sinceMs;          // Accept time, then stream start
+    char request[SSE_REQUEST_MAX];
+    uint16_t requestLen;
+
+    uint16_t hz;
+    uint8_t batch;
+    uint32_t nextSampleMs;
+    SseSample samples[SSE_MAX_BATCH];
+    uint8_t sampleCount;
+
+    // Event being written; new events are dropped until it is out
+    char out[SSE_EVENT_MAX];
+    uint16_t outLen;
+    uint16_t outSent;
+
+    uint32_t eventsSent;
+    uint32_t eventsDropped;
+};
+
+static WiFiServer sseServer(SSE_PORT);
+static SseSlot slots[SSE_MAX_CLIENTS];
+static portMUX_TYPE sseMux = portMUX_INITIALIZER_UNLOCKED;  // Guards slot state/counters for readers
+static TaskHandle_t sseTaskHandle = nullptr;
+static volatile bool sseServing = false;
+
+static void freeSlot(SseSlot& s) {
+    s.client.stop();
+    portENTER_CRITICAL(&sseMux);
+    s.state = SLOT_FREE;
+    portEXIT_CRITICAL(&sseMux);
+}
+
+// Writes as much of the pending event as the socket takes right now.
+// False if the connection failed.
+static bool flushSlot(SseSlot& s) {
+    while (s.outSent < s.outLen) {
+        int n = send(s.client.fd(), s.out + s.outSent, s.outLen - s.outSent, MSG_DONTWAIT);
+        if (n > 0) {
+            s.outSent += n;
+        } else if (n < 0 && (errno == EWOULDBLOCK || errno == EAGAIN)) {
+            return true;  // Socket buffer full; the rest goes out next tick
+        } else {
+            return false;
+        }
+    }
+    s.outLen = 0;
+    s.outSent = 0;
+    return true;
+}
+
+// Formats into the slot's buffer, or drops the event if one is still pending
+static bool queueEvent(SseSlot& s, const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+static bool queueEvent(SseSlot& s, const char* fmt, ...) {
+    if (s.outLen != 0) {
+        s.eventsDropped++;
+        return false;
+    }
+    va_list args;
+    va_start(args, fmt);
+    int len = vsnprintf(s.out, sizeof(s.out), fmt, args);
+    va_end(args);
+    s.outLen = min(len, (int)sizeof(s.out) - 1);
+    s.outSent = 0;
+    return true;
+}
+
+static void takeSample(SseSample& sample) {
+    ServoTelemetry t;
+    getServoTelemetry(t);
+    sample.ms = millis();
+    sample.rpm = getRPMUnified();
+    sample.mode = lastServoMode;
+    sample.target = lastServoPos;
+    sample.actual = t.position;
+}
+
+// One event per full batch:
+//   data: {"state":"race","s":[[t_ms,rpm,mode,target,actual],...]}
+static void queueBatch(SseSlot& s) {
+    char* p = s.out;
+    char* end = s.out + sizeof(s.out);
+    if (s.outLen != 0) {
+        s.eventsDropped++;
+        s.sampleCount = 0;
+        return;
+    }
+
+    p += snprintf(p, end - p, "data: {\"state\":\"%s\",\"s\":[", getCurrentStateName());
+    for (uint8_t i = 0; i < s.sampleCount && p < end; ++i) {
+        const SseSample& x = s.samples[i];
+        p += snprintf(p, end - p, "%s[%lu,%.1f,%d,%d,%d]", i ? "," : "",
+                      (unsigned long)x.ms, x.rpm, x.mode, x.target, x.actual);
+    }
+    if (p < end) p += snprintf(p, end - p, "]}\n\n");
+
+    s.outLen = min((int)(p - s.out), (int)sizeof(s.out) - 1);
+    s.outSent = 0;
+    s.sampleCount = 0;
+    s.eventsSent++;
+}
+
+static long queryParam(const char* request, const char* name, long fallback) {
+    const char* lineEnd = strstr(request, "\r\n");
+    const char* p = strstr(request, name);
+    if (!p || (lineEnd && p > lineEnd)) return fallback;
+    return atol(p + strlen(name));
+}
+
+// Parses the request once the headers are complete and starts streaming
+static void handleHandshake(SseSlot& s, uint32_t now) {
+    while (s.client.available() && s.requestLen < SSE_REQUEST_MAX - 1) {
+        s.request[s.requestLen++] = s.client.read();
+    }
+    s.request[s.requestLen] = '\0';
+
+    if (!strstr(s.request, "\r\n\r\n")) {
+        if (s.requestLen >= SSE_REQUEST_MAX - 1 || now - s.sinceMs > SSE_HANDSHAKE_MS) freeSlot(s);
+        return;
+    }
+
+    if (strncmp(s.request, "GET /events", 11) != 0) {
+        s.client.print("HTTP/1.1 404 Not Found\r\nConnection: close\r\nContent-Length: 0\r\n\r\n");
+        freeSlot(s);
+        return;
+    }
+
+    s.hz = constrain(queryParam(s.request, "hz=", SSE_DEFAULT_HZ), 1, SSE_MAX_HZ);
+    s.batch = constrain(queryParam(s.request, "batch=", 1), 1, SSE_MAX_BATCH);
+    s.sampleCount = 0;
+    s.nextSampleMs = now;
+    s.eventsSent = 0;
+    s.eventsDropped = 0;
+    s.outLen = 0;
+
+    queueEvent(s, "HTTP/1.1 200 OK\r\n"
+                  "Content-Type: text/event-stream\r\n"
+                  "Cache-Control: no-cache\r\n"
+                  "Connection: keep-alive\r\n"
+                  "Access-Control-Allow-Origin: *\r\n\r\n"
+                  "event: meta\n"
+                  "data: {\"fields\":[\"t_ms\",\"rpm\",\"mode\",\"target\",\"actual\"],\"hz\":%u,\"batch\":%u}\n\n",
+               s.hz, s.batch);
+
+    portENTER_CRITICAL(&sseMux);
+    s.state = SLOT_STREAMING;
+    s.sinceMs = now;
+    portEXIT_CRITICAL(&sseMux);
+}
+
+static void acceptClients(uint32_t now) {
+    WiFiClient client = sseServer.available();
+    if (!client) return;
+
+    for (SseSlot& s : slots) {
+        if (s.state != SLOT_FREE) continue;
+        s.client = client;
+        s.client.setNoDelay(true);
+        s.requestLen = 0;
+        s.outLen = 0;
+        s.sinceMs = now;
+        portENTER_CRITICAL(&sseMux);
+        s.state = SLOT_HANDSHAKE;
+        portEXIT_CRITICAL(&sseMux);
+        return;
+    }
+
+    client.print("HTTP/1.1 503 Service Unavailable\r\nConnection: close\r\nContent-Length: 0\r\n\r\n");
+    client.stop();
+}
+
+static void serviceSlots(uint32_t now) {
+    SseSample sample;
+    bool sampled = false;  // One sample per tick, shared by every client due
+
+    for (SseSlot& s : slots) {
+        if (s.state == SLOT_FREE) continue;
+        if (!s.client.connected()) {
+            freeSlot(s);
+            continue;
+        }
+        if (s.state == SLOT_HANDSHAKE) {
+            handleHandshake(s, now);
+            if (s.state != SLOT_STREAMING) continue;
+        }
+
+        if ((int32_t)(now - s.nextSampleMs) >= 0) {
+            if (!sampled) {
+                takeSample(sample);
+                sampled = true;
+            }
+            s.samples[s.sampleCount++] = sample;
+
+            // Fall behind by more than a period and the schedule restarts
+            uint32_t periodMs = 1000 / s.hz;
+            s.nextSampleMs += periodMs;
+            if ((int32_t)(now - s.nextSampleMs) >= (int32_t)periodMs) s.nextSampleMs = now + periodMs;
+
+            if (s.sampleCount >= s.batch) queueBatch(s);
+        }
+
+        if (!flushSlot(s)) freeSlot(s);
+    }
+}
+
+static void sseTask(void* arg) {
+    bool running = false;
+
+    for (;;) {
+        if (!sseServing) {
+            if (running) {
+                for (SseSlot& s : slots) {
+                    if (s.state != SLOT_FREE) freeSlot(s);
+                }
+                sseServer.end();
+                running = false;
+            }
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            continue;
+        }
+
+        if (!running) {
+            sseServer.begin();
+            sseServer.setNoDelay(true);
+            running = true;
+        }
+
+        uint32_t now = millis();
+        acceptClients(now);
+        serviceSlots(now);
+        vTaskDelay(pdMS_TO_TICKS(SSE_TICK_MS));
+    }
+}
+
+void startSseServer() {
+    if (sseTaskHandle == nullptr) {
+        xTaskCreate(sseTask, "sse", 4096, nullptr, SSE_TASK_PRIORITY, &sseTaskHandle);
+    }
+    sseServing = true;
+    xTaskNotifyGive(sseTaskHandle);
+}
+
+void stopSseServer() {
+    sseServing = false;
+    if (sseTaskHandle != nullptr) xTaskNotifyGive(sseTaskHandle);
+}
+
+int getSseClients(SseClientInfo* out, int max) {
+    int n = 0;
+    uint32_t now = millis();
+    portENTER_CRITICAL(&sseMux);
+    for (const SseSlot& s : slots) {
+        if (s.state != SLOT_STREAMING || n >= max) continue;
+        out[n].hz = s.hz;
+        out[n].batch = s.batch;
+        out[n].connectedMs = now - s.sinceMs;
+        out[n].eventsSent = s.eventsSent;
+        out[n].eventsDropped = s.eventsDropped;
+        n++;
+    }
+    portEXIT_CRITICAL(&sseMux);
+
+    // remoteIP() asks the socket, so it stays outside the critical section
+    int i = 0;
+    for (SseSlot& s : slots) {
+        if (s.state == SLOT_STREAMING && i < n) out[i++].ip = s.client.remoteIP();
+    }
+    return n;
+}
+
+void printSseClients() {
+    SseClientInfo clients[SSE_MAX_CLIENTS];
+    int n = getSseClients(clients, SSE_MAX_CLIENTS);
+    Serial.printf("📡 Event stream on port %d: %s, %d/%d client(s)\n", SSE_PORT,
+                  sseServing ? "listening" : "stopped", n, SSE_MAX_CLIENTS);
+    for (int i = 0; i < n; ++i) {
+        const SseClientInfo& c = clients[i];
+        Serial.printf("  → %s  %u Hz × %u per event, %lu s, %lu sent, %lu dropped\n",
+                      c.ip.toString().c_str(), c.hz, c.batch, (unsigned long)(c.connectedMs / 1000),
+                      (unsigned long)c.eventsSent, (unsigned long)c.eventsDropped);
+    }
+}
@@ -3,6 +3,8 @@
 #include "../include/rpm.h"
 #include "../include/wifi_utils.h"
 #include "../include/nvs_utils.h"
+#include "../include/trace.h"
+#include "../include/boot.h"
 
 // Internal current state variable
 static SystemState currentState = SystemState::UNKNOWN;
@@ -16,11 +18,76 @@ bool singlePressPending = false;
 
 int MODE_SWITCH_PIN = 1;
 
-// Forward declarations
-void raceMode();
-void diagnosticsMode();
-void offMode();
-bool isSafeCommand(const String& input);
+// === Entry / exit hooks ===
+// Servo follow, RPM source and Wi-Fi are applied from the capability
+// flags; hooks only hold what is particular to one state.
+static uint32_t raceStartMs = 0;
+
+static void enterRace() {
+    raceStartMs = millis();
+    Serial.println("🏁 Race mode activated: live RPM, servo follow, Wi-Fi turning off");
+}
+
+static void exitRace() {
+    Serial.printf("🏁 Race mode ended after %lu s\n", (unsigned long)((millis() - raceStartMs) / 1000));
+}
+
+static void enterDiagnostics() {
+    Serial.println("🧪 Diagnostics mode: manual RPM, Wi-Fi turning on, manual servo");
+}
+
+static void enterConfig() {
+    Serial.println("🔧 Config mode: full CLI, servo follow off, Wi-Fi off");
+}
+
+static void enterOff() {
+    Serial.println("🛑 OFF mode: all systems disabled");
+}
+
+// === State table ===
+#define STATE_TO(s) (1 << static_cast<int>(SystemState::s))
+
+struct StateInfo {
+    const char* name;
+    uint8_t capabilities;  // StateCapability bits
+    uint8_t allowedNext;   // STATE_TO() bits
+    void (*onExit)();
+    void (*onEnter)();
+};
+
+// Indexed by SystemState. Race cannot go straight to config: the full
+// CLI opens only after passing through diagnostics or off.
+static const StateInfo STATE_TABLE[] = {
+    /* RACE */        { "race", STATE_CAP_FOLLOW | STATE_CAP_SENSOR_RPM,
+                        STATE_TO(DIAGNOSTICS) | STATE_TO(OFF), exitRace, enterRace },
+    /* DIAGNOSTICS */ { "diagnostics", STATE_CAP_WIFI,
+                        STATE_TO(RACE) | STATE_TO(CONFIG) | STATE_TO(OFF), nullptr, enterDiagnostics },
+    /* CONFIG */      { "config", STATE_CAP_CLI,
+                        STATE_TO(RACE) | STATE_TO(DIAGNOSTICS) | STATE_TO(OFF), nullptr, enterConfig },
+    /* OFF */         { "off", 0,
+                        STATE_TO(RACE) | STATE_TO(DIAGNOSTICS) | STATE_TO(CONFIG), nullptr, enterOff },
+    /* UNKNOWN */     { "unknown", 0, STATE_TO(RACE), nullptr, nullptr },  // Boot only
+};
+static_assert(sizeof(STATE_TABLE) / sizeof(STATE_TABLE[0]) == static_cast<int>(SystemState::UNKNOWN) + 1,
+              "One row per SystemState");
+
+static const StateInfo& stateInfo(SystemState state) {
+    return STATE_TABLE[static_cast<int>(state)];
+}
+
+// === Transition history ===
+// Written by the loop task only, read from the HTTP task
+static portMUX_TYPE historyMux = portMUX_INITIALIZER_UNLOCKED;
+static StateTransition history[STATE_HISTORY_SIZE];
+static uint32_t transitionCount = 0;  // Also the next history slot
+static uint32_t rejectedCount = 0;
+
+static void recordTransition(const StateTransition& t) {
+    portENTER_CRITICAL(&historyMux);
+    history[transitionCount % STATE_HISTORY_SIZE] = t;
+    transitionCount++;
+    portEXIT_CRITICAL(&historyMux);
+}
 
 int getModeSwitchButtonPin() {
     return MODE_SWITCH_PIN;
@@ -30,10 +97,11 @@ void setModeSwitchButtonPin(int pin) {
     MODE_SWITCH_PIN = pin;
 }
 
-// Called once at boot
+// Called once at boot, once the control task runs: goes straight to
+// RACE through the state table so follow is armed without a button
+// press. "state set diagnostics" or a double press leaves it.
 void initState() {
-    currentState = SystemState::CONFIG;  // default mode
-    Serial.println(F("🔧 System state initialized to CONFIG"));
+    setState(SystemState::RACE);  // default mode
 }
 
 void initModeButtonInterrupt() {
@@ -47,48 +115,105 @@ SystemState getCurrentState() {
 }
 
 const char* getCurrentStateName() {
-    switch (currentState) {
-        case SystemState::RACE: return "race";
-        case SystemState::DIAGNOSTICS: return "diagnostics";
-        case SystemState::CONFIG: return "config";
-        case SystemState::OFF: return "off";
-        default: return "unknown";
+    return getStateName(currentState);
+}
+
+const char* getStateName(SystemState state) {
+    return stateInfo(state).name;
+}
+
+bool parseStateName(const char* name, SystemState& out) {
+    for (int i = 0; i < static_cast<int>(SystemState::UNKNOWN); ++i) {
+        if (strcmp(name, STATE_TABLE[i].name) == 0) {
+            out = static_cast<SystemState>(i);
+            return true;
+        }
     }
+    return false;
+}
+
+bool stateHasCapability(SystemState state, StateCapability cap) {
+    return stateInfo(state).capabilities & cap;
+}
+
+bool isTransitionAllowed(SystemState from, SystemState to) {
+    return stateInfo(from).allowedNext & (1 << static_cast<int>(to));
 }
 
 bool setState(SystemState newState) {
     if (newState == currentState) return false;
 
-    // Optional: exit logic for old state
-    Serial.printf("🚦 Switching state: %s → %s\n", getCurrentStateName(),
-                  (newState == SystemState::RACE) ? "race" :
-                  (newState == SystemState::DIAGNOSTICS) ? "diagnostics" :
-                  (newState == SystemState::CONFIG) ? "config" : 
-                  (newState == SystemState::OFF) ? "off" : "unknown");
+    SystemState oldState = currentState;
+    if (!isTransitionAllowed(oldState, newState)) {
+        rejectedCount++;
+        Serial.printf("⛔ %s → %s is not allowed\n", getStateName(oldState), getStateName(newState));
+        return false;
+    }
+
+    Serial.printf("🚦 Switching state: %s → %s\n", getStateName(oldState), getStateName(newState));
+
+    uint32_t startMs = millis();
+    uint32_t startUs = micros();
+    const StateInfo& from = stateInfo(oldState);
+    const StateInfo& to = stateInfo(newState);
+
+    if (from.onExit) from.onExit();
 
     currentState = newState;
-    if (newState == SystemState::RACE) {
-        raceMode();
-    } else if (newState == SystemState::DIAGNOSTICS) {
-        diagnosticsMode();
-    } else if (newState == SystemState::CONFIG) {
-        offMode();
-    } else if (newState == SystemState::OFF) {
-        offMode();
+    traceEvent(TRACE_STATE, TRACE_INSTANT, (uint32_t)newState);
+
+    // Servo and RPM source before the radio: the Wi-Fi change is only
+    // queued (see wifi_utils.h), so follow is live before it starts
+    setRPMSource((to.capabilities & STATE_CAP_SENSOR_RPM) ? SENSOR : MANUAL);
+    if (to.capabilities & STATE_CAP_FOLLOW) {
+        enableServoFollow();
+        markBootPhase(BOOT_FOLLOW_ARMED);
+    } else {
+        disableServoFollow();
     }
+    if (to.capabilities & STATE_CAP_WIFI) enableWiFi();
+    else disableWiFi();
 
-    // Optional: enter logic for new state
-    // e.g., resetServo(), stopWiFi(), enableDiagnostics()
+    if (to.onEnter) to.onEnter();
 
+    recordTransition({ oldState, newState, startMs, (uint32_t)(micros() - startUs) });
     return true;
 }
 
 bool setStateByName(const String& name) {
-    if (name == "race") return setState(SystemState::RACE);
-    if (name == "diagnostics") return setState(SystemState::DIAGNOSTICS);
-    if (name == "config") return setState(SystemState::CONFIG);
-    if (name == "off") return setState(SystemState::OFF);
-    return false;
+    SystemState state;
+    return parseStateName(name.c_str(), state) && setState(state);
+}
+
+int getStateHistory(StateTransition* out, int max) {
+    portENTER_CRITICAL(&historyMux);
+    uint32_t total = transitionCount;
+    int n = min<uint32_t>(min<uint32_t>(total, STATE_HISTORY_SIZE), max);
+    for (int i = 0; i < n; ++i) {
+        out[i] = history[(total - n + i) % STATE_HISTORY_SIZE];
+    }
+    portEXIT_CRITICAL(&historyMux);
+    return n;
+}
+
+uint32_t getStateTransitionCount() {
+    return transitionCount;
+}
+
+uint32_t getRejectedTransitionCount() {
+    return rejectedCount;
+}
+
+void printStateHistory() {
+    StateTransition t[STATE_HISTORY_SIZE];
+    int n = getStateHistory(t, STATE_HISTORY_SIZE);
+    Serial.printf("🚦 State: %s, %lu transitions, %lu rejected\n", getCurrentStateName(),
+                  (unsigned long)transitionCount, (unsigned long)rejectedCount);
+    Serial.println("       at s  from         to            latency µs");
+    for (int i = 0; i < n; ++i) {
+        Serial.printf("  %9.1f  %-12s %-12s %10lu\n", t[i].atMs / 1000.0, getStateName(t[i].from),
+                      getStateName(t[i].to), (unsigned long)t[i].latencyUs);
+    }
 }
 
 void IRAM_ATTR modeSwitchISR() {
@@ -116,11 +241,9 @@ void changeStatus(){
         waitingForSecondPress = false;
 
         if (currentState == SystemState::DIAGNOSTICS) {
-            setState(SystemState::RACE);
-            Serial.println("Switched to RACE mode");
+            if (setState(SystemState::RACE)) Serial.println("Switched to RACE mode");
         } else {
-            setState(SystemState::DIAGNOSTICS);
-            Serial.println("Switched to DIAGNOSTICS mode");
+            if (setState(SystemState::DIAGNOSTICS)) Serial.println("Switched to DIAGNOSTICS mode");
         }
 
         return;  // Done this loop
@@ -132,32 +255,9 @@ void changeStatus(){
         waitingForSecondPress = false;
 
         if (currentState == SystemState::OFF) {
-            setState(SystemState::DIAGNOSTICS);
-            Serial.println("Turned ON: DIAGNOSTICS mode");
+            if (setState(SystemState::DIAGNOSTICS)) Serial.println("Turned ON: DIAGNOSTICS mode");
         } else {
-            setState(SystemState::OFF);
-            Serial.printf("Turned OFF\n");
+            if (setState(SystemState::OFF)) Serial.printf("Turned OFF\n");
         }
     }
 }
-
-void raceMode() {
-    enableServoFollow();         // Servo follows live RPM
-    setRPMSource(SENSOR);        // Real RPM input
-    disableWiFi();               // No config access during race
-    Serial.println("🏁 Race mode activated: live RPM, servo follow, Wi-Fi disabled");
-}
-
-void diagnosticsMode() {
-    disableServoFollow();       // Manual servo control
-    setRPMSource(MANUAL);       // Use test values
-    enableWiFi();               // Allow access via Wi-Fi
-    Serial.println("🧪 Diagnostics mode: manual RPM, Wi-Fi enabled, manual servo");
-}
-
-void offMode() {
-    disableServoFollow();       // Turn off any movement
-    setRPMSource(MANUAL);       // Safe fallback
-    disableWiFi();              // Shut off comms
-    Serial.println("🛑 OFF mode: all systems disabled");
-}
@@ -0,0 +1,216 @@
+#include <Arduino.h>
+#include "../include/sts_bus.h"
+#include "../include/perf.h"
+#include "../include/trace.h"
+
+// STS registers are little-endian; signed values use a sign bit rather
+// than two's complement
+static void putWord(uint8_t* p, uint16_t value) {
+    p[0] = value & 0xFF;
+    p[1] = value >> 8;
+}
+
+static uint16_t getWord(const uint8_t* p) {
+    return p[0] | (p[1] << 8);
+}
+
+static int16_t fromSignMagnitude(uint16_t raw, int signBit) {
+    uint16_t sign = 1u << signBit;
+    return (raw & sign) ? -(int16_t)(raw & ~sign) : (int16_t)raw;
+}
+
+const char* stsStatusName(StsStatus s) {
+    switch (s) {
+        case StsStatus::OK:           return "ok";
+        case StsStatus::TIMEOUT:      return "timeout";
+        case StsStatus::BAD_HEADER:   return "bad header";
+        case StsStatus::BAD_CHECKSUM: return "bad checksum";
+        case StsStatus::BAD_LENGTH:   return "bad length";
+        case StsStatus::WRONG_ID:     return "wrong id";
+        case StsStatus::SERVO_ERROR:  return "servo error";
+        case StsStatus::TX_FAILED:    return "tx failed";
+        case StsStatus::BUS_BUSY:     return "bus busy";
+        case StsStatus::NOT_READY:    return "not ready";
+        default:                      return "unknown";
+    }
+}
+
+void StsBus::begin(uart_port_t port, uint32_t timeoutMs) {
+    uart = port;
+    rxTimeoutMs = timeoutMs;
+    ready = true;
+}
+
+StsStatus StsBus::finish(StsStatus s) {
+    counters[(int)s]++;
+    return s;
+}
+
+StsStatus StsBus::send(const uint8_t* tx, size_t txLen) {
+    uart_flush_input(uart);  // Drop leftovers from an earlier timed-out reply
+    if (uart_write_bytes(uart, (const char*)tx, txLen) != (int)txLen) {
+        return StsStatus::TX_FAILED;
+    }
+    if (uart_wait_tx_done(uart, pdMS_TO_TICKS(rxTimeoutMs)) != ESP_OK) {
+        return StsStatus::TX_FAILED;
+    }
+    return StsStatus::OK;
+}
+
+// Blocks on the UART driver's RX ring buffer until len bytes arrive or
+// the deadline passes
+bool StsBus::readExact(uint8_t* buf, size_t len, TickType_t deadline) {
+    TickType_t now = xTaskGetTickCount();
+    TickType_t wait = (int32_t)(deadline - now) > 0 ? deadline - now : 0;
+    return uart_read_bytes(uart, buf, len, wait) == (int)len;
+}
+
+StsStatus StsBus::transact(const uint8_t* tx, size_t txLen, uint8_t id,
+                           uint8_t* params, size_t paramLen) {
+    if (!ready) return finish(StsStatus::NOT_READY);
+    PERF_SCOPE(PERF_SERVO_BUS);
+    TRACE_SCOPE(TRACE_SERVO_BUS);
+
+    StsStatus s = send(tx, txLen);
+    if (s != StsStatus::OK) return finish(s);
+    if (id == STS_BROADCAST_ID) return finish(StsStatus::OK);  // Broadcasts are never answered
+
+    // One extra tick so a timeout never rounds down to zero
+    TickType_t deadline = xTaskGetTickCount() + pdMS_TO_TICKS(rxTimeoutMs) + 1;
+
+    // On single-wire wiring our own frame comes back first
+    if (echo && txLen <= sizeof(rxBuf)) {
+        if (!readExact(rxBuf, txLen, deadline)) return finish(StsStatus::TIMEOUT);
+        if (memcmp(rxBuf, tx, txLen) != 0) return finish(StsStatus::BAD_HEADER);
+    }
+
+    size_t respLen = paramLen + 6;
+    if (!readExact(rxBuf, respLen, deadline)) return finish(StsStatus::TIMEOUT);
+    if (rxBuf[0] != 0xFF || rxBuf[1] != 0xFF) return finish(StsStatus::BAD_HEADER);
+    if (rxBuf[2] != id) return finish(StsStatus::WRONG_ID);
+    if (rxBuf[3] != paramLen + 2) return finish(StsStatus::BAD_LENGTH);
+
+    uint8_t sum = 0;
+    for (size_t i = 2; i < respLen - 1; ++i) sum += rxBuf[i];
+    if ((uint8_t)~sum != rxBuf[respLen - 1]) return finish(StsStatus::BAD_CHECKSUM);
+
+    if (params != nullptr) memcpy(params, rxBuf + 5, paramLen);
+
+    // Data is still valid when the servo reports an error condition
+    return finish(rxBuf[4] != 0 ? StsStatus::SERVO_ERROR : StsStatus::OK);
+}
+
+void StsBus::detectEcho(uint8_t id) {
+    echo = false;
+    if (!ready) return;
+
+    // A read request and its reply have the same length, but the reply
+    // carries the error byte and data where the request has the
+    // instruction and address, so an exact match can only be the echo
+    uint8_t* p = readPacket.params();
+    p[0] = STS_REG_PRESENT_POSITION;
+    p[1] = 2;
+    const uint8_t* tx = readPacket.seal(id);
+    if (send(tx, readPacket.kSize) != StsStatus::OK) return;
+
+    TickType_t deadline = xTaskGetTickCount() + pdMS_TO_TICKS(rxTimeoutMs) + 1;
+    echo = readExact(rxBuf, readPacket.kSize, deadline) &&
+           memcmp(rxBuf, tx, readPacket.kSize) == 0;
+}
+
+StsStatus StsBus::ping(uint8_t id) {
+    const uint8_t* tx = pingPacket.seal(id);
+    return transact(tx, pingPacket.kSize, id, nullptr, 0);
+}
+
+StsStatus StsBus::writePosEx(uint8_t id, int16_t position, uint16_t speed, uint8_t acc) {
+    uint16_t rawPos = position < 0 ? ((uint16_t)(-position) | 0x8000) : position;
+
+    uint8_t* p = writePosPacket.params();
+    p[0] = STS_REG_ACC;
+    p[1] = acc;
+    putWord(p + 2, rawPos);
+    putWord(p + 4, 0);  // Goal time, unused
+    putWord(p + 6, speed);
+
+    const uint8_t* tx = writePosPacket.seal(id);
+    return transact(tx, writePosPacket.kSize, id, nullptr, 0);
+}
+
+StsStatus StsBus::syncWritePosEx(const uint8_t* ids, uint8_t count, const int16_t* positions,
+                                 const uint16_t* speeds, const uint8_t* accs) {
+    if (count == 0 || count > STS_MAX_SYNC_SERVOS) return finish(StsStatus::BAD_LENGTH);
+
+    const uint8_t dataLen = 7;  // ACC, POS_L/H, TIME_L/H, SPEED_L/H
+    size_t size = 8 + count * (dataLen + 1);
+
+    syncBuf[0] = 0xFF;
+    syncBuf[1] = 0xFF;
+    syncBuf[2] = STS_BROADCAST_ID;
+    syncBuf[3] = size - 4;
+    syncBuf[4] = STS_INST_SYNC_WRITE;
+    syncBuf[5] = STS_REG_ACC;
+    syncBuf[6] = dataLen;
+
+    uint8_t* p = syncBuf + 7;
+    for (uint8_t i = 0; i < count; ++i) {
+        int16_t pos = positions[i];
+        uint16_t rawPos = pos < 0 ? ((uint16_t)(-pos) | 0x8000) : pos;
+        p[0] = ids[i];
+        p[1] = accs[i];
+        putWord(p + 2, rawPos);
+        putWord(p + 4, 0);
+        putWord(p + 6, speeds[i]);
+        p += dataLen + 1;
+    }
+
+    uint8_t sum = 0;
+    for (size_t i = 2; i < size - 1; ++i) sum += syncBuf[i];
+    syncBuf[size - 1] = ~sum;
+
+    return transact(syncBuf, size, STS_BROADCAST_ID, nullptr, 0);
+}
+
+StsStatus StsBus::writeByte(uint8_t id, uint8_t reg, uint8_t value) {
+    uint8_t* p = writeBytePacket.params();
+    p[0] = reg;
+    p[1] = value;
+
+    const uint8_t* tx = writeBytePacket.seal(id);
+    return transact(tx, writeBytePacket.kSize, id, nullptr, 0);
+}
+
+StsStatus StsBus::readFeedback(uint8_t id, StsFeedback& out) {
+    uint8_t* p = readPacket.params();
+    p[0] = STS_REG_PRESENT_POSITION;
+    p[1] = STS_FEEDBACK_LEN;
+
+    uint8_t data[STS_FEEDBACK_LEN];
+    const uint8_t* tx = readPacket.seal(id);
+    StsStatus s = transact(tx, readPacket.kSize, id, data, sizeof(data));
+    if (s != StsStatus::OK && s != StsStatus::SERVO_ERROR) return s;
+
+    // Offsets relative to PRESENT_POSITION_L (56)
+    out.position = fromSignMagnitude(getWord(data + 0), 15);
+    out.speed = fromSignMagnitude(getWord(data + 2), 15);
+    out.load = fromSignMagnitude(getWord(data + 4), 10);
+    out.voltage = data[6];
+    out.temperature = data[7];
+    out.moving = data[10] != 0;
+    out.current = fromSignMagnitude(getWord(data + 13), 15);
+    return s;
+}
+
+StsStatus StsBus::readPos(uint8_t id, int16_t& position) {
+    uint8_t* p = readPacket.params();
+    p[0] = STS_REG_PRESENT_POSITION;
+    p[1] = 2;
+
+    uint8_t data[2];
+    const uint8_t* tx = readPacket.seal(id);
+    StsStatus s = transact(tx, readPacket.kSize, id, data, sizeof(data));
+    if (s == StsStatus::OK || s == StsStatus::SERVO_ERROR) {
+        position = fromSignMagnitude(getWord(data), 15);
+    }
+    return s;
+}
@@ -0,0 +1,95 @@
+#include <Arduino.h>
+#include "../include/telemetry_frame.h"
+
+// Longest raw frame: type, seq, six 5-byte varints, flags, CRC
+#define TELEMETRY_MAX_RAW (2 + 6 * 5 + 1 + 2)
+
+uint16_t telemetryCrc16(const uint8_t* data, size_t len) {
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < len; ++i) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (int b = 0; b < 8; ++b) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+static size_t putVarint(uint8_t* p, uint32_t v) {
+    size_t n = 0;
+    while (v >= 0x80) {
+        p[n++] = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    p[n++] = (uint8_t)v;
+    return n;
+}
+
+// Small negative deltas stay small: 0, -1, 1, -2 … → 0, 1, 2, 3 …
+static size_t putSigned(uint8_t* p, int32_t v) {
+    return putVarint(p, ((uint32_t)v << 1) ^ (uint32_t)(v >> 31));
+}
+
+// Consistent Overhead Byte Stuffing plus the 0x00 delimiter
+static size_t cobsEncode(const uint8_t* in, size_t len, uint8_t* out) {
+    size_t codeIndex = 0;
+    size_t o = 1;
+    uint8_t code = 1;
+
+    for (size_t i = 0; i < len; ++i) {
+        if (in[i] == 0) {
+            out[codeIndex] = code;
+            codeIndex = o++;
+            code = 1;
+        } else {
+            out[o++] = in[i];
+            if (++code == 0xFF) {
+                out[codeIndex] = code;
+                codeIndex = o++;
+                code = 1;
+            }
+        }
+    }
+    out[codeIndex] = code;
+    out[o++] = 0x00;
+    return o;
+}
+
+size_t TelemetryEncoder::encode(const TelemetrySample& s, uint8_t* out) {
+    bool key = !haveBase || sinceKey >= TELEMETRY_KEYFRAME_INTERVAL;
+    const TelemetrySample zero = {};
+    const TelemetrySample& ref = key ? zero : base;
+
+    uint8_t raw[TELEMETRY_MAX_RAW];
+    size_t n = 0;
+    raw[n++] = key ? TELEMETRY_FRAME_KEY : TELEMETRY_FRAME_DELTA;
+    raw[n++] = seq;
+    n += putVarint(raw + n, s.timestampUs - ref.timestampUs);
+    n += putSigned(raw + n, s.rpmX10 - ref.rpmX10);
+    n += putSigned(raw + n, s.rpmRate - ref.rpmRate);
+    n += putSigned(raw + n, s.mode - ref.mode);
+    n += putSigned(raw + n, s.servoTarget - ref.servoTarget);
+    n += putSigned(raw + n, s.servoActual - ref.servoActual);
+    raw[n++] = s.flags;
+
+    uint16_t crc = telemetryCrc16(raw, n);
+    raw[n++] = crc & 0xFF;
+    raw[n++] = crc >> 8;
+
+    pending = s;
+    pendingKey = key;
+    return cobsEncode(raw, n, out);
+}
+
+void TelemetryEncoder::commit() {
+    base = pending;
+    haveBase = true;
+    sinceKey = pendingKey ? 0 : sinceKey + 1;
+    seq++;
+}
+
+void TelemetryEncoder::reset() {
+    haveBase = false;
+    sinceKey = 0;
+    seq = 0;
+}
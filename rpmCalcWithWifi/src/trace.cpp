@@ -0,0 +1,137 @@
+#include <Arduino.h>
+#include "../include/trace.h"
+
+volatile bool traceEnabled = true;
+static volatile bool traceIsrEnabled = true;
+
+static portMUX_TYPE traceMux = portMUX_INITIALIZER_UNLOCKED;
+static TraceEvent traceRing[TRACE_CAPACITY];
+static uint32_t traceHead = 0;    // Next slot to write
+static uint32_t traceCount = 0;
+
+// Slot 0 stands for interrupt context
+static TaskHandle_t traceTasks[TRACE_MAX_TASKS] = {};
+static uint8_t traceTaskCount = 1;
+
+static const char* const TRACE_TYPE_NAMES[TRACE_TYPE_COUNT] = {
+    "rpm_edge",
+    "mode_crossing",
+    "mode",
+    "servo_cmd",
+    "servo_bus",
+    "control",
+    "state",
+    "http",
+    "cli",
+    "mark",
+    "radio",
+};
+
+// Called inside the critical section
+static uint8_t IRAM_ATTR traceTaskIndex() {
+    if (xPortInIsrContext()) return 0;
+
+    TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    for (uint8_t i = 1; i < traceTaskCount; ++i) {
+        if (traceTasks[i] == self) return i;
+    }
+    if (traceTaskCount < TRACE_MAX_TASKS) {
+        traceTasks[traceTaskCount] = self;
+        return traceTaskCount++;
+    }
+    return TRACE_MAX_TASKS - 1;  // Shared overflow slot
+}
+
+void IRAM_ATTR traceEvent(TraceType type, TracePhase phase, uint32_t value) {
+    if (!traceEnabled) return;
+    if (type == TRACE_RPM_EDGE && !traceIsrEnabled) return;
+
+    uint32_t now = micros();
+    portENTER_CRITICAL_SAFE(&traceMux);
+    TraceEvent& e = traceRing[traceHead];
+    e.timestampUs = now;
+    e.type = type;
+    e.phaseTask = (phase << 6) | (traceTaskIndex() & 0x3F);
+    e.value = value > 0xFFFF ? 0xFFFF : value;
+    traceHead = (traceHead + 1) % TRACE_CAPACITY;
+    if (traceCount < TRACE_CAPACITY) traceCount++;
+    portEXIT_CRITICAL_SAFE(&traceMux);
+}
+
+void setTraceEnabled(bool enabled) {
+    traceEnabled = enabled;
+}
+
+void setTraceIsrEnabled(bool enabled) {
+    traceIsrEnabled = enabled;
+}
+
+bool isTraceIsrEnabled() {
+    return traceIsrEnabled;
+}
+
+void clearTrace() {
+    portENTER_CRITICAL(&traceMux);
+    traceHead = 0;
+    traceCount = 0;
+    portEXIT_CRITICAL(&traceMux);
+}
+
+uint32_t getTraceCount() {
+    return traceCount;
+}
+
+// Dump in progress: ring slots still to print, oldest first
+static bool dumpActive = false;
+static bool dumpWasEnabled = false;
+static uint32_t dumpFirst = 0;
+static uint32_t dumpNext = 0;
+static uint32_t dumpCount = 0;
+
+void dumpTrace() {
+    if (dumpActive) return;
+    dumpWasEnabled = traceEnabled;
+    traceEnabled = false;
+
+    portENTER_CRITICAL(&traceMux);
+    dumpCount = traceCount;
+    dumpFirst = (traceHead + TRACE_CAPACITY - dumpCount) % TRACE_CAPACITY;
+    portEXIT_CRITICAL(&traceMux);
+    dumpNext = 0;
+    dumpActive = true;
+
+    // Header: everything the converter needs to name tasks and events
+    Serial.println("=== TRACE BEGIN ===");
+    Serial.printf("# version 1\n# events %lu\n# now_us %lu\n",
+                  (unsigned long)dumpCount, (unsigned long)micros());
+    Serial.println("# task 0 ISR");
+    for (uint8_t i = 1; i < traceTaskCount; ++i) {
+        Serial.printf("# task %u %s\n", i, pcTaskGetName(traceTasks[i]));
+    }
+    for (int t = 0; t < TRACE_TYPE_COUNT; ++t) {
+        Serial.printf("# type %d %s\n", t, TRACE_TYPE_NAMES[t]);
+    }
+}
+
+bool isTraceDumpActive() {
+    return dumpActive;
+}
+
+void serviceTraceDump() {
+    if (!dumpActive) return;
+
+    // One record per line: timestamp, type, phase|task, value. Only as
+    // many as fit in the TX buffer, so the caller never blocks on Serial.
+    for (int n = 0; n < TRACE_DUMP_LINES_PER_CALL && dumpNext < dumpCount; ++n) {
+        if (Serial.availableForWrite() < TRACE_DUMP_LINE_BYTES) return;
+        const TraceEvent& e = traceRing[(dumpFirst + dumpNext) % TRACE_CAPACITY];
+        Serial.printf("%08lx %02x %02x %04x\n",
+                      (unsigned long)e.timestampUs, e.type, e.phaseTask, e.value);
+        dumpNext++;
+    }
+    if (dumpNext < dumpCount) return;
+
+    Serial.println("=== TRACE END ===");
+    dumpActive = false;
+    traceEnabled = dumpWasEnabled;
+}
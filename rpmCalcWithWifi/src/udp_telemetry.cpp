@@ -0,0 +1,136 @@
+#include <Arduino.h>
+#include <WiFi.h>
+#include <WiFiUdp.h>
+#include "../include/udp_telemetry.h"
+#include "../include/nvs_utils.h"
+#include "../include/rpm.h"
+#include "../include/servo.h"
+#include "../include/servo_telemetry.h"
+#include "../include/pin_utils.h"
+#include "../include/state.h"
+#include "../include/telemetry_frame.h"
+
+static WiFiUDP udp;
+static TaskHandle_t udpTaskHandle = nullptr;
+static volatile bool udpEnabled = false;
+static volatile int udpHz = UDP_DEFAULT_HZ;
+static volatile bool udpMulticast = false;
+
+static bool socketOpen = false;
+static uint32_t seq = 0;
+static uint32_t packetsSent = 0;
+static uint32_t sendErrors = 0;
+
+static void putLE(uint8_t* p, uint32_t v, int bytes) {
+    for (int i = 0; i < bytes; ++i) p[i] = v >> (8 * i);
+}
+
+static void encodePacket(uint8_t* p) {
+    ServoTelemetry t;
+    getServoTelemetry(t);
+    uint8_t flags = (servoFollowingEnabled ? TELEMETRY_FOLLOWING : 0) |
+                    (getMovementPinState() ? TELEMETRY_MOVEMENT_PIN : 0) |
+                    (t.moving ? TELEMETRY_SERVO_MOVING : 0) |
+                    (isRPMFromSensor() ? TELEMETRY_RPM_SENSOR : 0) |
+                    (t.valid ? TELEMETRY_SERVO_VALID : 0);
+
+    p[0] = 'R';
+    p[1] = 'T';
+    p[2] = UDP_PACKET_VERSION;
+    p[3] = (uint8_t)getCurrentState();
+    putLE(p + 4, seq, 4);
+    putLE(p + 8, millis(), 4);
+    putLE(p + 12, (uint32_t)lroundf(getRPMUnified() * 10), 4);
+    putLE(p + 16, (uint16_t)lastServoPos, 2);
+    putLE(p + 18, (uint16_t)t.position, 2);
+    p[20] = (int8_t)lastServoMode;
+    p[21] = flags;
+    putLE(p + 22, udpHz, 2);
+}
+
+static bool streamAllowed() {
+    return udpEnabled && getCurrentState() == SystemState::DIAGNOSTICS;
+}
+
+static void udpTask(void* arg) {
+    TickType_t lastWake = xTaskGetTickCount();
+
+    for (;;) {
+        if (!streamAllowed()) {
+            if (socketOpen) {
+                udp.stop();
+                socketOpen = false;
+            }
+            // State changes are not signalled, so look again now and then
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(UDP_IDLE_CHECK_MS));
+            lastWake = xTaskGetTickCount();
+            continue;
+        }
+
+        if (!socketOpen) {
+            udp.begin(UDP_TELEMETRY_PORT);
+            socketOpen = true;
+        }
+
+        uint8_t packet[UDP_PACKET_SIZE];
+        encodePacket(packet);
+        seq++;  // Also on failure, so listeners see device-side drops as gaps
+
+        IPAddress dest = udpMulticast ? UDP_MULTICAST_GROUP : WiFi.softAPBroadcastIP();
+        if (udp.beginPacket(dest, UDP_TELEMETRY_PORT) &&
+            udp.write(packet, sizeof(packet)) == sizeof(packet) &&
+            udp.endPacket()) {
+            packetsSent++;
+        } else {
+            sendErrors++;
+        }
+
+        TickType_t period = max<TickType_t>(pdMS_TO_TICKS(1000 / udpHz), 1);
+        vTaskDelayUntil(&lastWake, period);
+    }
+}
+
+void initUdpTelemetry() {
+    loadUdpTelemetry();
+    if (udpTaskHandle == nullptr) {
+        xTaskCreate(udpTask, "udp", 3072, nullptr, UDP_TASK_PRIORITY, &udpTaskHandle);
+    }
+}
+
+bool isUdpTelemetryEnabled() {
+    return udpEnabled;
+}
+
+int getUdpTelemetryRate() {
+    return udpHz;
+}
+
+bool isUdpTelemetryMulticast() {
+    return udpMulticast;
+}
+
+void setUdpTelemetry(bool enabled, int hz, bool multicast) {
+    udpHz = constrain(hz, UDP_MIN_HZ, UDP_MAX_HZ);
+    udpMulticast = multicast;
+    udpEnabled = enabled;
+    if (udpTaskHandle != nullptr) xTaskNotifyGive(udpTaskHandle);
+}
+
+void enableUdpTelemetry(int hz, bool multicast) {
+    setUdpTelemetry(true, hz, multicast);
+    storeUdpTelemetry();
+}
+
+void disableUdpTelemetry() {
+    setUdpTelemetry(false, udpHz, udpMulticast);
+    storeUdpTelemetry();
+}
+
+void printUdpTelemetryStatus() {
+    IPAddress dest = udpMulticast ? UDP_MULTICAST_GROUP : WiFi.softAPBroadcastIP();
+    Serial.printf("📡 UDP telemetry: %s, %d Hz, %s %s:%d\n",
+                  !udpEnabled ? "off" : streamAllowed() ? "sending" : "waiting for diagnostics mode",
+                  udpHz, udpMulticast ? "multicast" : "broadcast", dest.toString().c_str(), UDP_TELEMETRY_PORT);
+    Serial.printf("  %d-byte packets, seq %lu, %lu sent, %lu send errors\n", UDP_PACKET_SIZE,
+                  (unsigned long)seq, (unsigned long)packetsSent, (unsigned long)sendErrors);
+}
@@ -7,6 +7,19 @@
 #include "../include/servo.h"
 #include "../include/nvs_utils.h"
 #include "../include/rpm.h"
+#include "../include/servo_telemetry.h"
+#include "../include/move_tracker.h"
+#include "../include/actuators.h"
+#include "../include/perf.h"
+#include "../include/trace.h"
+#include "../include/sse_server.h"
+#include "../include/json_writer.h"
+#include "../include/history.h"
+#include "../include/calibration.h"
+#include "../include/web_assets.h"
+#include "../include/config_api.h"
+#include "../include/state.h"
+#include "../include/boot.h"
 #include "esp_wifi.h"
 #include "esp_event.h"
 #include "esp_netif.h"
@@ -16,13 +29,75 @@ const char* ssid = "ESP8266_AP";
 const char* password = "12345678";
 
 WebServer server(80);
+
+// === HTTP task ===
+static TaskHandle_t httpTaskHandle = nullptr;
+static volatile bool httpServing = false;
+static uint32_t requestDeadlineMs = 0;  // Set before each handler runs
+
+// === Radio task ===
+struct RadioRequest {
+  bool on;
+  uint32_t requestedUs;
+};
+
+static QueueHandle_t radioQueue = nullptr;
+static TaskHandle_t radioTaskHandle = nullptr;
+static volatile bool radioIsOn = false;
+static bool apConfigured = false;
+static portMUX_TYPE radioStatsMux = portMUX_INITIALIZER_UNLOCKED;
+static RadioTransitionStats radioStats[2];  // [0] off, [1] on
+
+// === Per-route latency ===
+struct RouteStats {
+  const char* path;
+  uint32_t count;
+  uint32_t timeouts;
+  uint32_t lastUs;
+  uint32_t maxUs;
+  uint64_t sumUs;
+};
+
+static portMUX_TYPE httpStatsMux = portMUX_INITIALIZER_UNLOCKED;
+static RouteStats routeStats[HTTP_MAX_ROUTES];
+static int routeCount = 0;
+
 IPAddress espAPIP;
 
 bool testCheck = false;  
 bool syncStatus = false; 
 
+// Serialization is timed on its own as well as inside the handler
+static void serializeJsonTimed(const JsonDocument& doc, String& out) {
+  PERF_SCOPE(PERF_JSON);
+  serializeJson(doc, out);
+}
+
+// Sends what a JsonWriter wrote; the body goes out straight from its buffer
+static void sendJsonBuffer(const JsonWriter& json) {
+  if (!json.ok()) {
+    server.send(500, "text/plain", "Response too large");
+    return;
+  }
+  server.send_P(200, "application/json", json.c_str(), json.length());
+}
+
+// Routes that rewrite the stored setup (/save_ranges, /positions,
+// PUT /config) work wherever HTTP is up, i.e. in diagnostics, or in
+// config after "wifi enable", but never while the servo follows RPM.
+#define CONFIG_LOCKED_MESSAGE "Servo is following RPM; switch to diagnostics first"
+static bool configWritable() {
+  return !stateHasCapability(getCurrentState(), STATE_CAP_FOLLOW);
+}
+
 void handleRanges() {
+  PERF_SCOPE(PERF_HTTP);
+  TRACE_SCOPE(TRACE_HTTP);
   if (server.method() == HTTP_POST) {
+    if (!configWritable()) {
+      server.send(409, "text/plain", CONFIG_LOCKED_MESSAGE);
+      return;
+    }
     String jsonData = server.arg("plain");
     DynamicJsonDocument doc(512);
     DeserializationError error = deserializeJson(doc, jsonData);
@@ -49,7 +124,7 @@ void handleRanges() {
         modeRanges[i][0] = boundaries[i].as<int>();
         modeRanges[i][1] = boundaries[i + 1].as<int>();
       }
-      generateServoPositions(newNumRanges);
+      generateAllActuatorPositions(newNumRanges);
       numRanges = newNumRanges;
       storeRanges();
       server.send(200, "text/plain", "Ranges updated successfully");
@@ -58,39 +133,248 @@ void handleRanges() {
 }
 
 void handleSendRanges() {
+  PERF_SCOPE(PERF_HTTP);
+  TRACE_SCOPE(TRACE_HTTP);
   if (server.method() == HTTP_GET) {
-    DynamicJsonDocument doc(256);
-    JsonArray ranges = doc.createNestedArray("ranges");
-
-    // Loop through the valid ranges
-    for (int i = 0; i < numRanges; i++) {
-      JsonArray range = ranges.createNestedArray();
-      range.add(modeRanges[i][0]);
-      range.add(modeRanges[i][1]);
+    char buf[32 + MOTION_MAX_MODES * 26];  // Fits every range at full int32 width
+    JsonWriter json(buf);
+    {
+      PERF_SCOPE(PERF_JSON);
+      json.beginObject().key("ranges").beginArray();
+      for (int i = 0; i < numRanges; i++) {
+        json.beginArray().value(modeRanges[i][0]).value(modeRanges[i][1]).endArray();
+      }
+      json.endArray().endObject();
     }
-    String jsonData;
-    serializeJson(doc, jsonData);
-    server.send(200, "application/json", jsonData);
+    sendJsonBuffer(json);
   }
 }
 
 void handleRPMData() {
-  DynamicJsonDocument doc(256);
-  doc["rpm"] = getRPMUnified();
+  PERF_SCOPE(PERF_HTTP);
+  TRACE_SCOPE(TRACE_HTTP);
+  char buf[32];
+  JsonWriter json(buf);
+  {
+    PERF_SCOPE(PERF_JSON);
+    json.beginObject().field("rpm", getRPMUnified()).endObject();
+  }
+  sendJsonBuffer(json);
+}
+
+void sendCurrentMode() {
+  PERF_SCOPE(PERF_HTTP);
+  TRACE_SCOPE(TRACE_HTTP);
+  char buf[32];
+  JsonWriter json(buf);
+  {
+    PERF_SCOPE(PERF_JSON);
+    json.beginObject().field("current_position", determineMode(getRPMUnified())).endObject();
+  }
+  sendJsonBuffer(json);
+}
+
+void handleServoTelemetry() {
+  PERF_SCOPE(PERF_HTTP);
+  TRACE_SCOPE(TRACE_HTTP);
+  ServoTelemetry t;
+  getServoTelemetry(t);
+
+  DynamicJsonDocument doc(384);
+  doc["valid"] = t.valid;
+  doc["age_ms"] = getServoTelemetryAge();
+  doc["position"] = t.position;
+  doc["speed"] = t.speed;
+  doc["load"] = t.load;
+  doc["voltage"] = t.voltage / 10.0;
+  doc["temperature"] = t.temperature;
+  doc["current"] = t.current;
+  doc["moving"] = t.moving;
+  doc["samples"] = t.sampleCount;
+  doc["errors"] = t.errorCount;
   String jsonData;
-  serializeJson(doc, jsonData);
+  serializeJsonTimed(doc, jsonData);
   server.send(200, "application/json", jsonData);
 }
 
-void sendCurrentMode() {
-  StaticJsonDocument<200> doc;
-  doc["current_position"] = determineMode(getRPMUnified());
+void handleActuators() {
+  PERF_SCOPE(PERF_HTTP);
+  TRACE_SCOPE(TRACE_HTTP);
+  DynamicJsonDocument doc(2048);
+  JsonArray list = doc.createNestedArray("actuators");
+
+  for (int i = 0; i < getActuatorCount(); ++i) {
+    JsonObject a = list.createNestedObject();
+    a["id"] = getActuatorId(i);
+    a["offset"] = actuators[i].offset;
+    JsonArray positions = a.createNestedArray("positions");
+    for (int m = 1; m <= numRanges; ++m) positions.add(getActuatorModePosition(i, m));
+
+    ServoTelemetry t;
+    getActuatorTelemetry(i, t);
+    a["valid"] = t.valid;
+    a["position"] = t.position;
+    a["load"] = t.load;
+    a["moving"] = t.moving;
+  }
+
+  SkewSummary s;
+  getActuatorSkew(s);
+  JsonObject skew = doc.createNestedObject("skew");
+  skew["count"] = s.count;
+  skew["timeouts"] = s.timeouts;
+  skew["last_ms"] = s.lastMs;
+  skew["min_ms"] = s.minMs;
+  skew["avg_ms"] = s.avgMs;
+  skew["max_ms"] = s.maxMs;
+
   String jsonData;
-  serializeJson(doc, jsonData);
+  serializeJsonTimed(doc, jsonData);
   server.send(200, "application/json", jsonData);
 }
 
+// Reported in µs; histogram buckets are cycle-based (see perf.h)
+void handlePerf() {
+  PERF_SCOPE(PERF_HTTP);
+  TRACE_SCOPE(TRACE_HTTP);
+  DynamicJsonDocument doc(4096);
+  doc["enabled"] = (bool)perfEnabled;
+  doc["cpu_mhz"] = ESP.getCpuFreqMHz();
+  doc["hist_shift"] = PERF_HIST_SHIFT;
+  JsonObject boot = doc.createNestedObject("boot");
+  for (int p = 0; p < BOOT_PHASE_COUNT; ++p) {
+    uint32_t us = getBootPhaseUs((BootPhase)p);
+    if (us) boot[getBootPhaseName((BootPhase)p)] = us / 1000.0;  // ms since reset
+  }
+  JsonObject probes = doc.createNestedObject("probes");
+
+  for (int p = 0; p < PERF_PROBE_COUNT; ++p) {
+    PerfStats s;
+    getPerfStats((PerfProbe)p, s);
+    JsonObject probe = probes.createNestedObject(getPerfProbeName((PerfProbe)p));
+    probe["count"] = s.count;
+    probe["min_us"] = perfCyclesToUs(s.minCycles);
+    probe["avg_us"] = s.count ? (float)s.sumCycles / s.count / ESP.getCpuFreqMHz() : 0;
+    probe["max_us"] = perfCyclesToUs(s.maxCycles);
+    JsonArray hist = probe.createNestedArray("hist");
+    for (int b = 0; b < PERF_HIST_BUCKETS; ++b) hist.add((int)s.histogram[b]);
+  }
+
+  String jsonData;
+  serializeJsonTimed(doc, jsonData);
+  server.send(200, "application/json", jsonData);
+}
+
+// The full table is up to 12 × 11 transitions, too much for one
+// document, so rows are written one at a time and sent in chunks
+#define LATENCY_CHUNK 1024
+#define LATENCY_ROW_MAX 192
+
+// Sends what is buffered if 'need' more bytes would not fit
+static void reserveLatencyChunk(char* chunk, size_t& len, size_t need) {
+  if (len + need > LATENCY_CHUNK) {
+    server.sendContent(chunk, len);
+    len = 0;
+  }
+}
+
+static void appendLatencyRow(char* chunk, size_t& len, const JsonWriter& row, bool comma) {
+  reserveLatencyChunk(chunk, len, row.length() + 1);
+  if (comma) chunk[len++] = ',';
+  memcpy(chunk + len, row.c_str(), row.length());
+  len += row.length();
+}
+
+void handleServoLatency() {
+  PERF_SCOPE(PERF_HTTP);
+  TRACE_SCOPE(TRACE_HTTP);
+  char chunk[LATENCY_CHUNK];
+  char buf[LATENCY_ROW_MAX];
+  size_t len = 0;
+  bool first = true;
+
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+  server.send(200, "application/json", "");
+
+  const char* head = "{\"transitions\":[";
+  len = strlen(head);
+  memcpy(chunk, head, len);
+
+  for (int from = 1; from <= numRanges; ++from) {
+    for (int to = 1; to <= numRanges; ++to) {
+      LatencySummary s;
+      if (from == to || !getTransitionLatency(from, to, s)) continue;
+      if (s.count == 0 && s.timeouts == 0) continue;
+      JsonWriter row(buf);
+      row.beginObject()
+          .field("from", from)
+          .field("to", to)
+          .field("count", s.count)
+          .field("min_ms", s.minMs)
+          .field("avg_ms", s.avgMs)
+          .field("p99_ms", s.p99Ms)
+          .field("dead_ms", s.deadAvgMs)
+          .field("timeouts", s.timeouts)
+          .endObject();
+      appendLatencyRow(chunk, len, row, !first);
+      first = false;
+    }
+  }
+
+  LatencySummary all;
+  getOverallLatency(all);
+  JsonWriter tail(buf);
+  tail.beginObject()
+      .field("count", all.count)
+      .field("min_ms", all.minMs)
+      .field("avg_ms", all.avgMs)
+      .field("p99_ms", all.p99Ms)
+      .field("dead_ms", all.deadAvgMs)
+      .field("timeouts", all.timeouts)
+      .field("superseded", all.superseded)
+      .endObject();
+  reserveLatencyChunk(chunk, len, tail.length() + 48);
+  len += snprintf(chunk + len, LATENCY_CHUNK - len, "],\"overall\":%s,\"in_progress\":%s}",
+                  tail.c_str(), isMoveInProgress() ? "true" : "false");
+  server.sendContent(chunk, len);
+  server.sendContent("", 0);  // Last chunk
+}
+
+// Mode walks pause this long on every mode
+#define MODE_STEP_MS 2000
+// The dashboard walks keep their original gentle ramp (full speed, acc 20)
+// rather than the tuned race profiles
+#define WEB_WALK_SPEED 0
+#define WEB_WALK_ACC 20
+
+// Longest walk: up through every mode and back down again
+#define MODE_WALK_MAX_STEPS (2 * MOTION_MAX_MODES - 1)
+
+// JSON for a walk: "mode_path" with up to MODE_WALK_MAX_STEPS entries
+// and "complete"
+#define MODE_WALK_DOC_SIZE (JSON_OBJECT_SIZE(2) + JSON_ARRAY_SIZE(MODE_WALK_MAX_STEPS))
+
+// A walk of 'steps' modes takes longer than HTTP_REQUEST_TIMEOUT_MS by
+// design, so its deadline is scaled to the walk (at most
+// MODE_WALK_MAX_STEPS, i.e. 12 modes up and down)
+static void extendDeadlineForWalk(int steps) {
+  steps = constrain(steps, 1, MODE_WALK_MAX_STEPS);
+  requestDeadlineMs = millis() + steps * MODE_STEP_MS + HTTP_REQUEST_TIMEOUT_MS;
+}
+
+// Waits between mode steps. False once the request deadline would pass,
+// so a walk that stalls ends with a partial path instead of holding
+// the server.
+static bool waitStep(uint32_t ms) {
+  if ((int32_t)(millis() + ms - requestDeadlineMs) > 0) return false;
+  if (!httpServing) return false;  // Radio going off: end the walk early
+  vTaskDelay(pdMS_TO_TICKS(ms));
+  return true;
+}
+
 void handleTargetPosition() {
+  PERF_SCOPE(PERF_HTTP);
+  TRACE_SCOPE(TRACE_HTTP);
   DynamicJsonDocument doc(256);
   DeserializationError error = deserializeJson(doc, server.arg("plain"));
   if (error || !doc.containsKey("targetPosition")) {
@@ -101,48 +385,56 @@ void handleTargetPosition() {
   int targetMode = doc["targetPosition"];
   targetMode = constrain(targetMode, 1, numRanges);
 
-  DynamicJsonDocument response(256);
+  DynamicJsonDocument response(MODE_WALK_DOC_SIZE);
   JsonArray modePath = response.createNestedArray("mode_path");
+  // RPM outside every range: start where the servo was last sent
   int currentMode = determineMode(getRPMUnified());
+  if (currentMode < 1) currentMode = lastServoMode;
+  currentMode = constrain(currentMode, 1, numRanges);
+  int step = targetMode > currentMode ? 1 : -1;
+  bool complete = true;
+  extendDeadlineForWalk(abs(targetMode - currentMode) + 1);
 
-  if (targetMode > currentMode) {
-    for (int i = currentMode; i <= targetMode; i++) {
-      modePath.add(i);
-      st.WritePosEx(SERVO_ID, modeServoPositions[i - 1], 0, 20);
-      delay(2000);
-    }
-  } else {
-    for (int i = currentMode; i >= targetMode; i--) {
-      modePath.add(i);
-      st.WritePosEx(SERVO_ID, modeServoPositions[i - 1], 0, 20);
-      delay(2000);
-    }
+  for (int i = currentMode; complete; i += step) {
+    modePath.add(i);
+    servoMoveToMode(i, WEB_WALK_SPEED, WEB_WALK_ACC);
+    complete = waitStep(MODE_STEP_MS);
+    if (i == targetMode) break;
   }
+  response["complete"] = complete;
 
   String jsonData;
-  serializeJson(response, jsonData);
-  server.send(200, "application/json", jsonData);
+  serializeJsonTimed(response, jsonData);
+  server.send(complete ? 200 : 504, "application/json", jsonData);
 }
 
 void handleTestResult() {
-  DynamicJsonDocument doc(256);
+  PERF_SCOPE(PERF_HTTP);
+  TRACE_SCOPE(TRACE_HTTP);
+  DynamicJsonDocument doc(MODE_WALK_DOC_SIZE);
   JsonArray modePath = doc.createNestedArray("mode_path");
-  for (int i = 1; i <= numRanges; i++) {
+  bool complete = true;
+  extendDeadlineForWalk(2 * numRanges - 1);
+  for (int i = 1; i <= numRanges && complete; i++) {
     modePath.add(i);
-    st.WritePosEx(SERVO_ID, modeServoPositions[i - 1], 0, 20);
-    delay(2000);
+    servoMoveToMode(i, WEB_WALK_SPEED, WEB_WALK_ACC);
+    complete = waitStep(MODE_STEP_MS);
   }
-  for (int i = numRanges - 1; i >= 1; i--) {
+  for (int i = numRanges - 1; i >= 1 && complete; i--) {
     modePath.add(i);
-    st.WritePosEx(SERVO_ID, modeServoPositions[i - 1], 0, 20);
-    delay(2000);
+    servoMoveToMode(i, WEB_WALK_SPEED, WEB_WALK_ACC);
+    complete = waitStep(MODE_STEP_MS);
   }
+  doc["complete"] = complete;
+
   String jsonData;
-  serializeJson(doc, jsonData);
-  server.send(200, "application/json", jsonData);
+  serializeJsonTimed(doc, jsonData);
+  server.send(complete ? 200 : 504, "application/json", jsonData);
 }
 
 void handleTestCheck() {
+  PERF_SCOPE(PERF_HTTP);
+  TRACE_SCOPE(TRACE_HTTP);
   String jsonData = server.arg("plain");
   DynamicJsonDocument doc(256);
   DeserializationError error = deserializeJson(doc, jsonData);
@@ -155,43 +447,609 @@ void handleTestCheck() {
 }
 
 void handleSync() {
-  DynamicJsonDocument doc(256);
-  doc["sync"] = syncStatus;
+  PERF_SCOPE(PERF_HTTP);
+  TRACE_SCOPE(TRACE_HTTP);
+  char buf[24];
+  JsonWriter json(buf);
+  {
+    PERF_SCOPE(PERF_JSON);
+    json.beginObject().field("sync", syncStatus).endObject();
+  }
+  sendJsonBuffer(json);
+}
+
+// GET /positions: {"positions":[...],"min":m,"max":M}, raw steps per mode
+// POST /positions {"positions":[...]}: one position per mode, within min–max
+void handlePositions() {
+  PERF_SCOPE(PERF_HTTP);
+  TRACE_SCOPE(TRACE_HTTP);
+  int lo = getServoMinUsable();
+  int hi = getServoMaxUsable();
+
+  if (server.method() == HTTP_POST) {
+    if (!configWritable()) {
+      server.send(409, "text/plain", CONFIG_LOCKED_MESSAGE);
+      return;
+    }
+    DynamicJsonDocument doc(512);
+    DeserializationError error = deserializeJson(doc, server.arg("plain"));
+    if (error || !doc["positions"].is<JsonArray>()) {
+      server.send(400, "text/plain", "Invalid JSON");
+      return;
+    }
+    JsonArray positions = doc["positions"].as<JsonArray>();
+    if ((int)positions.size() != numRanges) {
+      server.send(400, "text/plain", "Expected one position per mode");
+      return;
+    }
+
+    int32_t values[MOTION_MAX_MODES];
+    for (int i = 0; i < numRanges; i++) {
+      if (!positions[i].is<int>() || positions[i].as<int>() < lo || positions[i].as<int>() > hi) {
+        server.send(400, "text/plain", "Position out of range");
+        return;
+      }
+      values[i] = positions[i].as<int>();
+    }
+    for (int i = 0; i < numRanges; i++) modeServoPositions[i] = values[i];
+    storeServoPositions();
+    server.send(200, "text/plain", "Positions updated successfully");
+    return;
+  }
+
+  char buf[48 + MOTION_MAX_MODES * 12];
+  JsonWriter json(buf);
+  {
+    PERF_SCOPE(PERF_JSON);
+    json.beginObject().key("positions").beginArray();
+    for (int i = 0; i < numRanges; i++) json.value((long)modeServoPositions[i]);
+    json.endArray().field("min", lo).field("max", hi).endObject();
+  }
+  sendJsonBuffer(json);
+}
+
+static void sendJsonError(int code, const char* message) {
+  char buf[160];
+  JsonWriter json(buf);
+  json.beginObject().field("error", message).endObject();
+  server.send_P(code, "application/json", json.c_str(), json.length());
+}
+
+// GET /config: the whole configuration (see config_api.h) and its ETag
+// PUT /config: validates and applies a document in one step, not while
+//              racing. With If-Match it must still be the current ETag.
+void handleConfig() {
+  PERF_SCOPE(PERF_HTTP);
+  TRACE_SCOPE(TRACE_HTTP);
+  if (server.method() != HTTP_GET && server.method() != HTTP_PUT) {
+    server.send(405, "text/plain", "GET or PUT");
+    return;
+  }
+
+  DynamicJsonDocument doc(CONFIG_DOC_SIZE);
+  if (!buildConfig(doc)) {
+    sendJsonError(500, "Config document too large");
+    return;
+  }
+  String etag = getConfigEtag(doc);
+
+  if (server.method() == HTTP_PUT) {
+    if (!configWritable()) {
+      sendJsonError(409, CONFIG_LOCKED_MESSAGE);
+      return;
+    }
+    String ifMatch = server.header("If-Match");
+    if (ifMatch.length() && ifMatch != "*" && ifMatch != etag) {
+      server.sendHeader("ETag", etag);
+      sendJsonError(412, "Config changed since it was read");
+      return;
+    }
+
+    doc.clear();
+    DeserializationError error = deserializeJson(doc, server.arg("plain"));
+    if (error == DeserializationError::NoMemory) {
+      sendJsonError(413, "Config document too large");
+      return;
+    }
+    if (error) {
+      sendJsonError(400, "Invalid JSON");
+      return;
+    }
+    char message[96];
+    ConfigResult result = applyConfig(doc, message, sizeof(message));
+    if (result != CONFIG_OK) {
+      sendJsonError(result == CONFIG_INVALID ? 400 : 500, message);
+      return;
+    }
+
+    doc.clear();
+    if (!buildConfig(doc)) {
+      sendJsonError(500, "Config document too large");
+      return;
+    }
+    etag = getConfigEtag(doc);
+  } else if (server.header("If-None-Match") == etag) {
+    server.sendHeader("ETag", etag);
+    server.send(304);
+    return;
+  }
+
   String jsonData;
-  serializeJson(doc, jsonData);
+  serializeJsonTimed(doc, jsonData);
+  server.sendHeader("ETag", etag);
+  server.sendHeader("Cache-Control", "no-cache");
   server.send(200, "application/json", jsonData);
 }
 
+// Current state, its capabilities and the recent transitions
+void handleState() {
+  PERF_SCOPE(PERF_HTTP);
+  TRACE_SCOPE(TRACE_HTTP);
+  static const struct { StateCapability cap; const char* name; } CAPS[] = {
+    { STATE_CAP_CLI, "cli" }, { STATE_CAP_WIFI, "wifi" },
+    { STATE_CAP_FOLLOW, "servo_follow" }, { STATE_CAP_SENSOR_RPM, "sensor_rpm" },
+  };
+  StateTransition t[STATE_HISTORY_SIZE];
+  int n = getStateHistory(t, STATE_HISTORY_SIZE);
+  SystemState state = getCurrentState();
+
+  char buf[160 + STATE_HISTORY_SIZE * 96];
+  JsonWriter json(buf);
+  {
+    PERF_SCOPE(PERF_JSON);
+    json.beginObject().field("state", getStateName(state));
+    json.key("capabilities").beginArray();
+    for (const auto& c : CAPS) {
+      if (stateHasCapability(state, c.cap)) json.value(c.name);
+    }
+    json.endArray();
+    json.field("transitions", (unsigned long)getStateTransitionCount())
+        .field("rejected", (unsigned long)getRejectedTransitionCount());
+    json.key("history").beginArray();
+    for (int i = 0; i < n; ++i) {
+      json.beginObject()
+          .field("from", getStateName(t[i].from))
+          .field("to", getStateName(t[i].to))
+          .field("at_ms", (unsigned long)t[i].atMs)
+          .field("latency_us", (unsigned long)t[i].latencyUs)
+          .endObject();
+    }
+    json.endArray().endObject();
+  }
+  sendJsonBuffer(json);
+}
+
+// Serves the embedded dashboard (web_assets.h). Bodies are stored
+// gzipped and sent as they are. Versioned files are cached for good;
+// the page itself is revalidated, which costs one 304 per visit.
+void handleWebAsset() {
+  PERF_SCOPE(PERF_HTTP);
+  TRACE_SCOPE(TRACE_HTTP);
+  const WebAsset* asset = nullptr;
+  for (const WebAsset& a : WEB_ASSETS) {
+    if (server.uri() == a.path) asset = &a;
+  }
+  if (asset == nullptr) {
+    server.send(404, "text/plain", "Not found");
+    return;
+  }
+
+  server.sendHeader("ETag", asset->etag);
+  server.sendHeader("Cache-Control", asset->immutable ? "public, max-age=31536000, immutable" : "no-cache");
+  if (server.header("If-None-Match").indexOf(asset->etag) >= 0) {
+    server.send(304);
+    return;
+  }
+  server.sendHeader("Content-Encoding", "gzip");
+  server.send_P(200, asset->contentType, (const char*)asset->data, asset->length);
+}
+
+// /history goes out in chunks of this size; one row never exceeds HISTORY_ROW_MAX
+#define HISTORY_CHUNK 1024
+#define HISTORY_ROW_MAX 64
+
+// Bytes per field in binary records, in HistoryField bit order
+static const uint8_t HISTORY_FIELD_BYTES[HISTORY_FIELD_COUNT] = { 4, 4, 1, 2, 2, 1 };
+
+static void putLE(uint8_t* p, uint32_t v, int bytes) {
+  for (int i = 0; i < bytes; ++i) p[i] = v >> (8 * i);
+}
+
+static size_t formatHistoryRow(const HistorySample& s, uint8_t fields, char* out, size_t size) {
+  JsonWriter row(out, size);
+  row.beginArray();
+  if (fields & HISTORY_T) row.value((unsigned long)s.ms);
+  if (fields & HISTORY_RPM) row.value(s.rpmX10 / 10.0f, 1);
+  if (fields & HISTORY_MODE) row.value((int)s.mode);
+  if (fields & HISTORY_TARGET) row.value((int)s.target);
+  if (fields & HISTORY_ACTUAL) row.value((int)s.actual);
+  if (fields & HISTORY_FLAGS) row.value((unsigned)s.flags);
+  row.endArray();
+  return row.length();
+}
+
+static size_t packHistoryRow(const HistorySample& s, uint8_t fields, uint8_t* out) {
+  const uint32_t values[HISTORY_FIELD_COUNT] = {
+    s.ms, (uint32_t)s.rpmX10, (uint32_t)s.mode, (uint32_t)s.target, (uint32_t)s.actual, s.flags
+  };
+  size_t len = 0;
+  for (int i = 0; i < HISTORY_FIELD_COUNT; ++i) {
+    if (!(fields & (1 << i))) continue;
+    putLE(out + len, values[i], HISTORY_FIELD_BYTES[i]);
+    len += HISTORY_FIELD_BYTES[i];
+  }
+  return len;
+}
+
+// GET /history?since=<seq>&fields=<list>&format=json|bin&max=<n>
+//
+// JSON: {"hz":50,"first":F,"next":N,"lost":L,"fields":[...],"s":[[...],...]}
+// bin:  16-byte header, then one little-endian record per sample with
+//       the selected fields in bit order (t_ms u32, rpm×10 i32, mode i8,
+//       target i16, actual i16, flags u8). Header: "RH", version 1,
+//       fields u8, hz u16, record size u16, first u32, count u32.
+//
+// 'next' (first + count in bin) is the cursor for the following call.
+void handleHistory() {
+  PERF_SCOPE(PERF_HTTP);
+  TRACE_SCOPE(TRACE_HTTP);
+
+  uint8_t fields = HISTORY_ALL_FIELDS;
+  if (server.hasArg("fields")) {
+    fields = parseHistoryFields(server.arg("fields").c_str());
+    if (!fields) {
+      server.send(400, "text/plain", "Unknown field");
+      return;
+    }
+  }
+  String format = server.hasArg("format") ? server.arg("format") : "json";
+  if (format != "json" && format != "bin") {
+    server.send(400, "text/plain", "format must be json or bin");
+    return;
+  }
+  bool binary = format == "bin";
+
+  uint32_t head = getHistoryHead();
+  uint32_t oldest = getHistoryOldest();
+  uint32_t since = server.hasArg("since") ? strtoul(server.arg("since").c_str(), nullptr, 10) : oldest;
+  if (since > head) since = oldest;  // Cursor from before a reboot
+  uint32_t first = max(since, oldest);
+  uint32_t lost = first - since;
+  uint32_t count = head - first;
+  if (server.hasArg("max")) count = min<uint32_t>(count, strtoul(server.arg("max").c_str(), nullptr, 10));
+
+  char chunk[HISTORY_CHUNK];
+  size_t len = 0;
+
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+  server.send(200, binary ? "application/octet-stream" : "application/json", "");
+
+  if (binary) {
+    uint16_t recordSize = 0;
+    for (int i = 0; i < HISTORY_FIELD_COUNT; ++i) {
+      if (fields & (1 << i)) recordSize += HISTORY_FIELD_BYTES[i];
+    }
+    uint8_t* p = (uint8_t*)chunk;
+    p[0] = 'R';
+    p[1] = 'H';
+    p[2] = 1;
+    p[3] = fields;
+    putLE(p + 4, HISTORY_HZ, 2);
+    putLE(p + 6, recordSize, 2);
+    putLE(p + 8, first, 4);
+    putLE(p + 12, count, 4);
+    len = 16;
+  } else {
+    JsonWriter json(chunk);
+    json.beginObject()
+      .field("hz", HISTORY_HZ)
+      .field("first", (unsigned long)first)
+      .field("next", (unsigned long)(first + count))
+      .field("lost", (unsigned long)lost)
+      .key("fields").beginArray();
+    for (int i = 0; i < HISTORY_FIELD_COUNT; ++i) {
+      if (fields & (1 << i)) json.value(getHistoryFieldName(i));
+    }
+    json.endArray().key("s").beginArray();  // Rows and the closing brackets follow
+    len = json.length();
+  }
+
+  for (uint32_t seq = first; seq < first + count; ++seq) {
+    HistorySample s;
+    if (!getHistorySample(seq, s)) {
+      // Overwritten while we were sending: cut the response short so
+      // the client sees an incomplete transfer and asks again
+      server.client().stop();
+      return;
+    }
+    if (len + HISTORY_ROW_MAX > sizeof(chunk)) {
+      server.sendContent(chunk, len);
+      len = 0;
+    }
+    if (binary) {
+      len += packHistoryRow(s, fields, (uint8_t*)chunk + len);
+    } else {
+      if (seq != first) chunk[len++] = ',';
+      len += formatHistoryRow(s, fields, chunk + len, sizeof(chunk) - len);
+    }
+  }
+
+  if (!binary) {
+    chunk[len++] = ']';
+    chunk[len++] = '}';
+  }
+  server.sendContent(chunk, len);
+  server.sendContent("", 0);  // Last chunk
+}
+
+static void recordRequest(int route, uint32_t us, bool timedOut) {
+  portENTER_CRITICAL(&httpStatsMux);
+  RouteStats& r = routeStats[route];
+  r.count++;
+  r.lastUs = us;
+  r.maxUs = max(r.maxUs, us);
+  r.sumUs += us;
+  if (timedOut) r.timeouts++;
+  portEXIT_CRITICAL(&httpStatsMux);
+}
+
+// Registers a handler and times every request it serves
+static void onRoute(const char* path, HTTPMethod method, void (*handler)()) {
+  if (routeCount >= HTTP_MAX_ROUTES) {
+    Serial.printf("⚠️ Route %s not registered (HTTP_MAX_ROUTES)\n", path);
+    return;
+  }
+  int route = routeCount++;
+  routeStats[route] = {};
+  routeStats[route].path = path;
+
+  server.on(path, method, [route, handler]() {
+    uint32_t start = micros();
+    requestDeadlineMs = millis() + HTTP_REQUEST_TIMEOUT_MS;
+    handler();
+    recordRequest(route, micros() - start, (int32_t)(millis() - requestDeadlineMs) > 0);
+  });
+}
+
 void setupWiFiRoutes() {
-  server.on("/data", HTTP_GET, handleRPMData);
-  server.on("/test_result", HTTP_GET, handleTestResult);
-  server.on("/current_position", HTTP_GET, sendCurrentMode);
-  server.on("/save_test_check", HTTP_POST, handleTestCheck);
-  server.on("/receive_target_position", HTTP_GET, handleTargetPosition);
-  server.on("/save_ranges", HTTP_POST, handleRanges);
-  server.on("/sync", HTTP_POST, handleSync);
-  server.on("/ranges", HTTP_GET, handleSendRanges);
-}
-
-void startWiFi() {
-  WiFi.softAPConfig(IPAddress(192, 168, 4, 6), IPAddress(192, 168, 4, 6), IPAddress(255, 255, 255, 0));
-  WiFi.softAP(ssid, password, 1, false, 1);
+  onRoute("/data", HTTP_GET, handleRPMData);
+  onRoute("/test_result", HTTP_GET, handleTestResult);
+  onRoute("/current_position", HTTP_GET, sendCurrentMode);
+  onRoute("/save_test_check", HTTP_POST, handleTestCheck);
+  onRoute("/receive_target_position", HTTP_GET, handleTargetPosition);
+  onRoute("/save_ranges", HTTP_POST, handleRanges);
+  onRoute("/sync", HTTP_POST, handleSync);
+  onRoute("/ranges", HTTP_GET, handleSendRanges);
+  onRoute("/servo_telemetry", HTTP_GET, handleServoTelemetry);
+  onRoute("/servo_latency", HTTP_GET, handleServoLatency);
+  onRoute("/actuators", HTTP_GET, handleActuators);
+  onRoute("/perf", HTTP_GET, handlePerf);
+  onRoute("/http_stats", HTTP_GET, handleHttpStats);
+  onRoute("/history", HTTP_GET, handleHistory);
+  onRoute("/positions", HTTP_ANY, handlePositions);
+  onRoute("/config", HTTP_ANY, handleConfig);
+  onRoute("/state", HTTP_GET, handleState);
+  for (const WebAsset& a : WEB_ASSETS) onRoute(a.path, HTTP_GET, handleWebAsset);
+}
+
+// Serves one connection at a time; further clients wait in the listen
+// backlog. The server is stopped from here too, so it is never torn
+// down in the middle of a request; radioOff() waits for the
+// acknowledgement before it stops the driver.
+static void httpTask(void* arg) {
+  bool running = false;
+
+  for (;;) {
+    if (!httpServing) {
+      if (running) {
+        server.stop();
+        running = false;
+      }
+      xTaskNotifyGive(radioTaskHandle);  // Acknowledge: not serving
+      ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+      continue;
+    }
+
+    if (!running) {
+      server.begin();
+      running = true;
+    }
+    server.handleClient();
+    vTaskDelay(pdMS_TO_TICKS(HTTP_POLL_MS));
+  }
+}
+
+// Slow part of turning on; runs in the radio task. The first time
+// configures the AP; after that the driver keeps the configuration and
+// only needs restarting.
+static void radioOn() {
+  if (!apConfigured) {
+    WiFi.softAPConfig(IPAddress(192, 168, 4, 6), IPAddress(192, 168, 4, 6), IPAddress(255, 255, 255, 0));
+    WiFi.softAP(ssid, password, 1, false, 1);
+    apConfigured = true;
+  } else {
+    esp_wifi_start();
+  }
   WiFi.setSleep(WIFI_PS_NONE);
-  setupWiFiRoutes();
-  server.begin();
+
+  httpServing = true;
+  xTaskNotifyGive(httpTaskHandle);
+  startSseServer();
+
   espAPIP = WiFi.softAPIP();
-  Serial.println("HTTP server started");
+  Serial.println("📶 Wi-Fi ON – HTTP server started");
+}
+
+static void radioOff() {
+  ulTaskNotifyTake(pdTRUE, 0);  // Drop any stale acknowledgement
+  httpServing = false;
+  xTaskNotifyGive(httpTaskHandle);
+  // The HTTP task finishes its current request first; a walk ends at
+  // its next step, anything else within the request timeout
+  if (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(RADIO_HTTP_STOP_TIMEOUT_MS)) == 0) {
+    Serial.println("⚠️ HTTP task did not stop in time, turning the radio off anyway");
+  }
+  stopSseServer();
+  // Radio off, AP configuration kept for the next radioOn()
+  esp_wifi_stop();
+  Serial.println("📴 Wi-Fi OFF – no client access");
+}
+
+static void radioTask(void* arg) {
+  RadioRequest req;
+
+  for (;;) {
+    xQueueReceive(radioQueue, &req, portMAX_DELAY);
+    if (req.on == radioIsOn) continue;
+
+    uint32_t start = micros();
+    {
+      TRACE_SCOPE(TRACE_RADIO, req.on);
+      if (req.on) radioOn();
+      else radioOff();
+    }
+    uint32_t end = micros();
+    radioIsOn = req.on;
+
+    portENTER_CRITICAL(&radioStatsMux);
+    RadioTransitionStats& s = radioStats[req.on];
+    s.count++;
+    s.lastUs = end - req.requestedUs;
+    s.maxUs = max(s.maxUs, s.lastUs);
+    s.lastWorkUs = end - start;
+    portEXIT_CRITICAL(&radioStatsMux);
+  }
+}
+
+void initWiFi() {
+  if (radioQueue != nullptr) return;
+
+  setupWiFiRoutes();
+  server.enableDelay(false);  // The task paces itself
+  static const char* headers[] = { "If-None-Match", "If-Match" };
+  server.collectHeaders(headers, sizeof(headers) / sizeof(headers[0]));
+
+  radioQueue = xQueueCreate(1, sizeof(RadioRequest));
+  // Radio task first: the HTTP task acknowledges to it from the start
+  xTaskCreate(radioTask, "radio", 4096, nullptr, RADIO_TASK_PRIORITY, &radioTaskHandle);
+  xTaskCreate(httpTask, "http", 6144, nullptr, HTTP_TASK_PRIORITY, &httpTaskHandle);
+}
+
+// Replaces any request the radio task has not picked up yet
+static void requestRadio(bool on) {
+  // Before initWiFi() the radio has never been on: nothing to turn off,
+  // and entering RACE at boot must not start the Wi-Fi tasks early
+  if (!on && radioQueue == nullptr) return;
+  initWiFi();
+  RadioRequest req = { on, (uint32_t)micros() };
+  xQueueOverwrite(radioQueue, &req);
 }
 
 void enableWiFi() {
-  Serial.println("📶 Turning WiFi ON – allowing client connections");
-  startWiFi();
+  requestRadio(true);
 }
 
 void disableWiFi() {
-  Serial.println("📴 Turning WiFi OFF – hiding SSID, no client access");
-  WiFi.softAPdisconnect(true);
-  esp_wifi_stop();
+  requestRadio(false);
+}
+
+bool isWiFiOn() {
+  return radioIsOn;
+}
+
+void getRadioTransitionStats(bool on, RadioTransitionStats& out) {
+  portENTER_CRITICAL(&radioStatsMux);
+  out = radioStats[on];
+  portEXIT_CRITICAL(&radioStatsMux);
+}
+
+void printRadioStats() {
+  Serial.printf("📶 Radio: %s, task priority %d\n", radioIsOn ? "on" : "off", RADIO_TASK_PRIORITY);
+  Serial.println("  transition  count   last ms    max ms  driver ms");
+  for (int on = 1; on >= 0; --on) {
+    RadioTransitionStats s;
+    getRadioTransitionStats(on, s);
+    Serial.printf("  %-10s %6lu %9.2f %9.2f %10.2f\n", on ? "on" : "off", (unsigned long)s.count,
+                  s.lastUs / 1000.0, s.maxUs / 1000.0, s.lastWorkUs / 1000.0);
+  }
+}
+
+bool getHttpRouteStats(int index, HttpRouteStats& out) {
+  if (index < 0 || index >= routeCount) return false;
+  portENTER_CRITICAL(&httpStatsMux);
+  const RouteStats& r = routeStats[index];
+  out.path = r.path;
+  out.count = r.count;
+  out.timeouts = r.timeouts;
+  out.lastUs = r.lastUs;
+  out.maxUs = r.maxUs;
+  out.avgUs = r.count ? (float)r.sumUs / r.count : 0;
+  portEXIT_CRITICAL(&httpStatsMux);
+  return true;
+}
+
+void resetHttpStats() {
+  portENTER_CRITICAL(&httpStatsMux);
+  for (int i = 0; i < routeCount; ++i) {
+    const char* path = routeStats[i].path;
+    routeStats[i] = {};
+    routeStats[i].path = path;
+  }
+  portEXIT_CRITICAL(&httpStatsMux);
+}
+
+void printHttpStats() {
+  Serial.printf("🌐 HTTP server: %s, task priority %d, request timeout %d ms\n",
+                httpServing ? "serving" : "stopped", HTTP_TASK_PRIORITY, HTTP_REQUEST_TIMEOUT_MS);
+  // Largest block well below free heap means the heap is fragmented
+  Serial.printf("  heap: %lu B free, %lu B largest block, %lu B lowest free\n",
+                (unsigned long)ESP.getFreeHeap(), (unsigned long)ESP.getMaxAllocHeap(),
+                (unsigned long)ESP.getMinFreeHeap());
+  Serial.println("  route                      count    avg ms   max ms  last ms  timeouts");
+  for (int i = 0; i < routeCount; ++i) {
+    HttpRouteStats s;
+    getHttpRouteStats(i, s);
+    if (s.count == 0) continue;
+    Serial.printf("  %-25s %6lu %9.2f %8.2f %8.2f %9lu\n", s.path, (unsigned long)s.count,
+                  s.avgUs / 1000.0, s.maxUs / 1000.0, s.lastUs / 1000.0, (unsigned long)s.timeouts);
+  }
+}
+
+void handleHttpStats() {
+  PERF_SCOPE(PERF_HTTP);
+  TRACE_SCOPE(TRACE_HTTP);
+  DynamicJsonDocument doc(2048);
+  doc["timeout_ms"] = HTTP_REQUEST_TIMEOUT_MS;
+  doc["heap_free"] = ESP.getFreeHeap();
+  doc["heap_largest_block"] = ESP.getMaxAllocHeap();
+  doc["heap_min_free"] = ESP.getMinFreeHeap();
+  JsonObject radio = doc.createNestedObject("radio");
+  for (int on = 0; on < 2; ++on) {
+    RadioTransitionStats t;
+    getRadioTransitionStats(on, t);
+    JsonObject r = radio.createNestedObject(on ? "on" : "off");
+    r["count"] = t.count;
+    r["last_ms"] = t.lastUs / 1000.0;
+    r["max_ms"] = t.maxUs / 1000.0;
+    r["driver_ms"] = t.lastWorkUs / 1000.0;
+  }
+  JsonArray routes = doc.createNestedArray("routes");
+
+  for (int i = 0; i < routeCount; ++i) {
+    HttpRouteStats s;
+    getHttpRouteStats(i, s);
+    JsonObject r = routes.createNestedObject();
+    r["path"] = s.path;
+    r["count"] = s.count;
+    r["avg_ms"] = s.avgUs / 1000.0;
+    r["max_ms"] = s.maxUs / 1000.0;
+    r["last_ms"] = s.lastUs / 1000.0;
+    r["timeouts"] = s.timeouts;
+  }
+
+  String jsonData;
+  serializeJsonTimed(doc, jsonData);
+  server.send(200, "application/json", jsonData);
 }
 
 IPAddress getIpAddress() {
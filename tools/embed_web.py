@@ -0,0 +1,159 @@
+#!/usr/bin/env python3
+"""Bundle the web dashboard into a firmware header.
+
+Every file in web/ is gzip-compressed and written to
+rpmCalcWithWifi/include/web_assets.h as a byte array with its content
+type and an ETag (a hash of the compressed bytes). The firmware serves
+them as-is with Content-Encoding: gzip.
+
+index.html is served at "/" and revalidated on every visit; a
+"{{name}}" placeholder in it is replaced with that file's ETag, so
+references like "/app.js?v={{app.js}}" change whenever the file does
+and the files themselves can be cached for good.
+
+Run it after editing anything in web/ and commit the regenerated header:
+
+  python3 tools/embed_web.py
+  python3 tools/embed_web.py --check    # fails if the header is stale
+"""
+
+import argparse
+import gzip
+import hashlib
+import os
+import re
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+DEFAULT_SRC = os.path.join(ROOT, "web")
+DEFAULT_OUT = os.path.join(ROOT, "rpmCalcWithWifi", "include", "web_assets.h")
+
+CONTENT_TYPES = {
+    ".html": "text/html",
+    ".js": "application/javascript",
+    ".css": "text/css",
+    ".svg": "image/svg+xml",
+    ".ico": "image/x-icon",
+    ".png": "image/png",
+    ".json": "application/json",
+}
+
+
+def c_name(filename):
+    return "WEB_" + re.sub(r"[^0-9A-Za-z]", "_", filename).upper()
+
+
+def compress(data):
+    # mtime=0 keeps the output, and so the ETag, identical between runs
+    return gzip.compress(data, compresslevel=9, mtime=0)
+
+
+def load_assets(src):
+    names = sorted(f for f in os.listdir(src) if os.path.isfile(os.path.join(src, f)))
+    for name in names:
+        if os.path.splitext(name)[1] not in CONTENT_TYPES:
+            sys.exit(f"{name}: unknown content type, add it to CONTENT_TYPES")
+
+    # Pages last, so they can refer to the ETags of everything else
+    names.sort(key=lambda n: n.endswith(".html"))
+    assets, etags = [], {}
+    for name in names:
+        with open(os.path.join(src, name), "rb") as f:
+            data = f.read()
+        if name.endswith(".html"):
+            def tag(m):
+                if m.group(1) not in etags:
+                    sys.exit(f"{name}: no asset named {m.group(1).decode()}")
+                return etags[m.group(1)]
+            data = re.sub(rb"\{\{([^}]+)\}\}", lambda m: tag(m).encode(), data)
+
+        gz = compress(data)
+        etag = hashlib.sha1(gz).hexdigest()[:16]
+        etags[name.encode()] = etag
+        assets.append({
+            "name": name,
+            "path": "/" if name == "index.html" else "/" + name,
+            "type": CONTENT_TYPES[os.path.splitext(name)[1]],
+            "gz": gz,
+            "raw_len": len(data),
+            "etag": etag,
+            # Only pages are looked up by a fixed URL; the rest is versioned
+            "immutable": not name.endswith(".html"),
+        })
+    return assets
+
+
+def render(assets):
+    out = [
+        "#ifndef WEB_ASSETS_H",
+        "#define WEB_ASSETS_H",
+        "",
+        "#include <Arduino.h>",
+        "",
+        "// ===============================",
+        "// Web Assets - Header File",
+        "// ===============================",
+        "// Generated by tools/embed_web.py from web/ -- do not edit.",
+        "// gzip-compressed dashboard files, served by handleWebAsset().",
+        "",
+        "struct WebAsset {",
+        "    const char* path;",
+        "    const char* contentType;",
+        "    const uint8_t* data;      // gzip",
+        "    size_t length;",
+        "    const char* etag;         // Quoted, as sent",
+        "    bool immutable;           // Versioned URL, cache for good",
+        "};",
+        "",
+    ]
+    for a in assets:
+        out.append(f"// {a['name']}: {a['raw_len']} bytes, {len(a['gz'])} gzipped")
+        out.append(f"static const uint8_t {c_name(a['name'])}[] PROGMEM = {{")
+        gz = a["gz"]
+        for i in range(0, len(gz), 16):
+            out.append("    " + ", ".join(f"0x{b:02x}" for b in gz[i:i + 16]) + ",")
+        out.append("};")
+        out.append("")
+
+    out.append("static const WebAsset WEB_ASSETS[] = {")
+    for a in assets:
+        out.append(f"    {{ \"{a['path']}\", \"{a['type']}\", {c_name(a['name'])}, "
+                   f"sizeof({c_name(a['name'])}), \"\\\"{a['etag']}\\\"\", "
+                   f"{'true' if a['immutable'] else 'false'} }},")
+    out.append("};")
+    out.append("")
+    out.append("#define WEB_ASSET_COUNT (sizeof(WEB_ASSETS) / sizeof(WEB_ASSETS[0]))")
+    out.append("")
+    out.append("#endif  // WEB_ASSETS_H")
+    return "\n".join(out) + "\n"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("--src", default=DEFAULT_SRC, help="directory with the web files")
+    parser.add_argument("-o", "--output", default=DEFAULT_OUT)
+    parser.add_argument("--check", action="store_true", help="only verify the header is current")
+    args = parser.parse_args()
+
+    assets = load_assets(args.src)
+    header = render(assets)
+
+    if args.check:
+        try:
+            with open(args.output) as f:
+                current = f.read()
+        except FileNotFoundError:
+            current = ""
+        if current != header:
+            sys.exit(f"{args.output} is out of date, run tools/embed_web.py")
+        return
+
+    with open(args.output, "w") as f:
+        f.write(header)
+    for a in assets:
+        print(f"{a['path']:<14} {a['raw_len']:6d} -> {len(a['gz']):6d} bytes  {a['etag']}")
+    print(f"{sum(len(a['gz']) for a in assets)} bytes of flash", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,85 @@
+#!/usr/bin/env python3
+"""Measure request rate and heap fragmentation of the device's HTTP server.
+
+Polls the hot endpoints the web app uses, as fast as the device answers,
+and reads /http_stats before and after. Connect to the device's access
+point first, then:
+
+  python3 tools/http_bench.py                      # 10 s over the default set
+  python3 tools/http_bench.py --seconds 60 /data   # one endpoint, longer
+
+Prints requests/s and latency percentiles per endpoint, then the heap
+figures from the device: free heap, largest free block (a drop with
+free heap unchanged means fragmentation) and the lowest free heap seen
+since boot. Run it on firmware before and after a change to compare.
+"""
+
+import argparse
+import json
+import sys
+import time
+import urllib.request
+
+# Path and method, as registered in setupWiFiRoutes()
+DEFAULT_ENDPOINTS = ["/data", "/current_position", "/ranges", "POST /sync"]
+
+
+def request(base, endpoint, timeout):
+    method, _, path = endpoint.rpartition(" ")
+    req = urllib.request.Request(base + path, method=method or "GET",
+                                 data=b"" if method == "POST" else None)
+    with urllib.request.urlopen(req, timeout=timeout) as resp:
+        return resp.read()
+
+
+def http_stats(base, timeout):
+    return json.loads(request(base, "/http_stats", timeout))
+
+
+def percentile(sorted_values, p):
+    if not sorted_values:
+        return 0.0
+    i = min(len(sorted_values) - 1, int(round(p / 100.0 * (len(sorted_values) - 1))))
+    return sorted_values[i]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("endpoints", nargs="*", default=DEFAULT_ENDPOINTS,
+                        help="paths to poll, 'POST /path' for POST routes")
+    parser.add_argument("--host", default="192.168.4.6")
+    parser.add_argument("--seconds", type=float, default=10.0, help="duration per endpoint")
+    parser.add_argument("--timeout", type=float, default=2.0)
+    args = parser.parse_args()
+
+    base = f"http://{args.host}"
+    try:
+        before = http_stats(base, args.timeout)
+    except OSError as e:
+        sys.exit(f"cannot reach {base}/http_stats: {e}")
+
+    print(f"{'endpoint':<24} {'req/s':>8} {'p50 ms':>8} {'p99 ms':>8} {'max ms':>8} {'errors':>7}")
+    for endpoint in args.endpoints:
+        latencies, errors = [], 0
+        start = time.monotonic()
+        while time.monotonic() - start < args.seconds:
+            t0 = time.monotonic()
+            try:
+                request(base, endpoint, args.timeout)
+                latencies.append((time.monotonic() - t0) * 1000)
+            except OSError:
+                errors += 1
+        elapsed = time.monotonic() - start
+        latencies.sort()
+        print(f"{endpoint:<24} {len(latencies) / elapsed:8.1f} {percentile(latencies, 50):8.1f} "
+              f"{percentile(latencies, 99):8.1f} {(latencies[-1] if latencies else 0):8.1f} {errors:7d}")
+
+    after = http_stats(base, args.timeout)
+    print()
+    print(f"{'heap':<24} {'before':>10} {'after':>10}")
+    for key in ("heap_free", "heap_largest_block", "heap_min_free"):
+        print(f"{key:<24} {before.get(key, 0):10d} {after.get(key, 0):10d}")
+
+
+if __name__ == "__main__":
+    main()
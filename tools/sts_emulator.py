@@ -0,0 +1,366 @@
+#!/usr/bin/env python3
+"""Virtual ST3215 servo emulator speaking the Feetech STS protocol.
+
+Serves one or more emulated servos on a pseudo-terminal (default) or on a
+real serial port, so the firmware's servo code can be exercised without
+the bike:
+
+  * pty mode:    python3 tools/sts_emulator.py
+                 -> prints /dev/pts/N, point a host program at it
+  * serial mode: python3 tools/sts_emulator.py --port /dev/ttyUSB0
+                 -> wire a USB-UART adapter to the ESP32 servo RX/TX
+                    (requires pyserial; 1 Mbaud by default)
+
+The model covers trapezoidal motion with the commanded speed and
+acceleration limits, rack end stops (the servo stalls against them and
+reports full load), a response latency, and injected faults: dropped
+responses (timeouts), corrupted checksums and mechanical stalls.
+
+`VirtualServo` and `StsEmulator.feed()` can also be used in-process from
+other Python scripts; feed() takes request bytes and returns the reply.
+
+While running, type commands on stdin:
+  status                      show every servo
+  timeout <id> <n>            drop the next n replies
+  corrupt <id> <n>            corrupt the checksum of the next n replies
+  stall <id> on|off           freeze the servo where it is
+  endstop <id> <min> <max>    move the rack end stops
+  latency <us>                change the reply latency
+  quit
+"""
+
+import argparse
+import os
+import random
+import sys
+import threading
+import time
+import tty
+
+INST_PING = 0x01
+INST_READ = 0x02
+INST_WRITE = 0x03
+INST_REG_WRITE = 0x04
+INST_ACTION = 0x05
+INST_SYNC_WRITE = 0x83
+BROADCAST_ID = 0xFE
+
+# Control table addresses (STS series)
+REG_ID = 5
+REG_MIN_ANGLE = 9
+REG_MAX_ANGLE = 11
+REG_TORQUE_ENABLE = 40
+REG_ACC = 41
+REG_GOAL_POSITION = 42
+REG_GOAL_SPEED = 46
+REG_PRESENT_POSITION = 56
+REG_PRESENT_SPEED = 58
+REG_PRESENT_LOAD = 60
+REG_PRESENT_VOLTAGE = 62
+REG_PRESENT_TEMPERATURE = 63
+REG_STATUS = 65
+REG_MOVING = 66
+REG_PRESENT_CURRENT = 69
+
+MAX_SPEED = 3400          # steps/s when goal speed is 0
+MAX_ACC = 150000          # steps/s^2 when acc is 0
+ACC_UNIT = 100            # steps/s^2 per acc register unit
+FRICTION_LOAD = 40        # 0.1 % of max torque while moving
+STALL_LOAD = 1000         # 0.1 % of max torque against an end stop
+
+
+def checksum(body):
+    return (~sum(body)) & 0xFF
+
+
+def to_sign_magnitude(value, sign_bit):
+    if value < 0:
+        return (-value) | (1 << sign_bit)
+    return value
+
+
+def from_sign_magnitude(raw, sign_bit):
+    if raw & (1 << sign_bit):
+        return -(raw & ~(1 << sign_bit))
+    return raw
+
+
+class VirtualServo:
+    """Control table plus a simple trapezoidal motion model."""
+
+    def __init__(self, servo_id, position=0, end_stops=(0, 4095)):
+        self.mem = bytearray(256)
+        self.mem[REG_ID] = servo_id
+        self.mem[REG_TORQUE_ENABLE] = 1
+        self.mem[REG_PRESENT_VOLTAGE] = 120
+        self.mem[REG_PRESENT_TEMPERATURE] = 32
+        self._put_word(REG_MIN_ANGLE, 0)
+        self._put_word(REG_MAX_ANGLE, 4095)
+        self.position = float(position)
+        self.velocity = 0.0
+        self.goal = position
+        self.end_stops = end_stops
+        self.stalled = False
+        self.drop_replies = 0
+        self.corrupt_replies = 0
+        self.move_started = None
+        self.pending = None      # REG_WRITE data waiting for ACTION
+        self._put_word(REG_GOAL_POSITION, position)
+        self._publish(0)
+
+    @property
+    def servo_id(self):
+        return self.mem[REG_ID]
+
+    def _put_word(self, addr, value):
+        self.mem[addr] = value & 0xFF
+        self.mem[addr + 1] = (value >> 8) & 0xFF
+
+    def _get_word(self, addr):
+        return self.mem[addr] | (self.mem[addr + 1] << 8)
+
+    def write(self, addr, data):
+        self.mem[addr:addr + len(data)] = data
+        if addr <= REG_GOAL_POSITION + 1 and addr + len(data) > REG_GOAL_POSITION:
+            goal = from_sign_magnitude(self._get_word(REG_GOAL_POSITION), 15)
+            if goal != self.goal:
+                self.goal = goal
+                self.move_started = time.monotonic()
+
+    def read(self, addr, length):
+        return bytes(self.mem[addr:addr + length])
+
+    def step(self, dt):
+        """Advances the motion model by dt seconds."""
+        load = 0
+        if self.stalled or not self.mem[REG_TORQUE_ENABLE]:
+            self.velocity = 0.0
+            load = STALL_LOAD if self.stalled else 0
+        else:
+            speed = self._get_word(REG_GOAL_SPEED) or MAX_SPEED
+            acc = self.mem[REG_ACC] * ACC_UNIT or MAX_ACC
+            error = self.goal - self.position
+            direction = 1 if error > 0 else -1
+            # Brake when the remaining distance equals the stopping distance
+            stopping = self.velocity * self.velocity / (2 * acc)
+            if abs(error) < 0.5 and abs(self.velocity) < acc * dt:
+                self.velocity = 0.0
+                self.position = float(self.goal)
+            elif abs(error) <= stopping and self.velocity * direction > 0:
+                self.velocity -= direction * acc * dt
+            else:
+                self.velocity += direction * acc * dt
+                self.velocity = max(-speed, min(speed, self.velocity))
+            self.position += self.velocity * dt
+
+            lo, hi = self.end_stops
+            if self.position < lo or self.position > hi:
+                self.position = float(max(lo, min(hi, self.position)))
+                self.velocity = 0.0
+                load = STALL_LOAD
+            elif self.velocity != 0.0:
+                load = FRICTION_LOAD + int(abs(acc) / MAX_ACC * 300)
+
+        moving = abs(self.velocity) > 0 or (abs(self.goal - self.position) > 1 and load < STALL_LOAD
+                                             and not self.stalled)
+        if not moving and self.move_started is not None:
+            elapsed = (time.monotonic() - self.move_started) * 1000
+            print(f"[servo {self.servo_id}] reached {int(self.position)} in {elapsed:.1f} ms",
+                  file=sys.stderr)
+            self.move_started = None
+        self._publish(load, moving)
+
+    def _publish(self, load, moving=False):
+        self._put_word(REG_PRESENT_POSITION, to_sign_magnitude(int(round(self.position)), 15))
+        self._put_word(REG_PRESENT_SPEED, to_sign_magnitude(int(self.velocity), 15))
+        self._put_word(REG_PRESENT_LOAD, to_sign_magnitude(load if self.velocity >= 0 else -load, 10))
+        self._put_word(REG_PRESENT_CURRENT, abs(load) // 2)
+        self.mem[REG_MOVING] = 1 if moving else 0
+        self.mem[REG_STATUS] = 0x20 if load >= STALL_LOAD else 0
+
+
+class StsEmulator:
+    """Parses STS request frames and produces replies for a set of servos."""
+
+    def __init__(self, servos, latency_us=0, echo=False):
+        self.servos = {s.servo_id: s for s in servos}
+        self.latency_us = latency_us
+        self.echo = echo
+        self.lock = threading.Lock()
+        self.rx = bytearray()
+        self.frames = 0
+        self.bad_frames = 0
+
+    def feed(self, data):
+        """Consumes request bytes and returns the reply bytes (if any)."""
+        out = bytearray(data if self.echo else b"")
+        self.rx.extend(data)
+        while True:
+            frame = self._next_frame()
+            if frame is None:
+                break
+            out.extend(self._handle(frame))
+        return bytes(out)
+
+    def _next_frame(self):
+        while len(self.rx) >= 2 and not (self.rx[0] == 0xFF and self.rx[1] == 0xFF):
+            del self.rx[0]
+        if len(self.rx) < 4:
+            return None
+        length = self.rx[3]
+        total = length + 4
+        if len(self.rx) < total:
+            return None
+        frame = bytes(self.rx[:total])
+        del self.rx[:total]
+        if checksum(frame[2:-1]) != frame[-1]:
+            self.bad_frames += 1
+            return self._next_frame()
+        self.frames += 1
+        return frame
+
+    def _reply(self, servo, params=b""):
+        body = bytes([servo.servo_id, len(params) + 2, 0]) + params
+        frame = bytearray(b"\xff\xff" + body + bytes([checksum(body)]))
+        if servo.drop_replies > 0:
+            servo.drop_replies -= 1
+            return b""
+        if servo.corrupt_replies > 0:
+            servo.corrupt_replies -= 1
+            frame[-1] ^= 0x5A
+        return bytes(frame)
+
+    def _handle(self, frame):
+        servo_id, instr, params = frame[2], frame[4], frame[5:-1]
+        with self.lock:
+            if instr == INST_SYNC_WRITE:
+                addr, size = params[0], params[1]
+                for i in range(2, len(params), size + 1):
+                    target = self.servos.get(params[i])
+                    if target is not None:
+                        target.write(addr, params[i + 1:i + 1 + size])
+                return b""
+
+            if servo_id == BROADCAST_ID:
+                for servo in self.servos.values():
+                    self._execute(servo, instr, params)
+                return b""
+
+            servo = self.servos.get(servo_id)
+            if servo is None:
+                return b""
+            reply = self._execute(servo, instr, params)
+
+        if self.latency_us:
+            time.sleep(self.latency_us / 1e6)
+        return reply
+
+    def _execute(self, servo, instr, params):
+        if instr == INST_PING:
+            return self._reply(servo)
+        if instr == INST_READ:
+            return self._reply(servo, servo.read(params[0], params[1]))
+        if instr == INST_WRITE:
+            servo.write(params[0], params[1:])
+            return self._reply(servo)
+        if instr == INST_REG_WRITE:
+            servo.pending = (params[0], bytes(params[1:]))
+            return self._reply(servo)
+        if instr == INST_ACTION and servo.pending:
+            servo.write(*servo.pending)
+            servo.pending = None
+        return b""
+
+    def step(self, dt):
+        with self.lock:
+            for servo in self.servos.values():
+                servo.step(dt)
+
+
+def open_transport(args):
+    if args.port:
+        try:
+            import serial
+        except ImportError:
+            sys.exit("pyserial is required for --port (pip install pyserial)")
+        port = serial.Serial(args.port, args.baud, timeout=0.001)
+        return port.read, port.write, args.port
+
+    master, slave = os.openpty()
+    tty.setraw(slave)
+    return (lambda n: os.read(master, n)), (lambda b: os.write(master, b)), os.ttyname(slave)
+
+
+def command_loop(emu):
+    for line in sys.stdin:
+        parts = line.split()
+        if not parts:
+            continue
+        cmd, args = parts[0], parts[1:]
+        try:
+            with emu.lock:
+                if cmd == "quit":
+                    os._exit(0)
+                elif cmd == "status":
+                    for s in emu.servos.values():
+                        print(f"servo {s.servo_id}: pos {s.position:.0f} goal {s.goal} "
+                              f"vel {s.velocity:.0f} stops {s.end_stops} "
+                              f"stalled {s.stalled} frames {emu.frames} bad {emu.bad_frames}")
+                elif cmd == "timeout":
+                    emu.servos[int(args[0])].drop_replies = int(args[1])
+                elif cmd == "corrupt":
+                    emu.servos[int(args[0])].corrupt_replies = int(args[1])
+                elif cmd == "stall":
+                    emu.servos[int(args[0])].stalled = args[1] == "on"
+                elif cmd == "endstop":
+                    emu.servos[int(args[0])].end_stops = (int(args[1]), int(args[2]))
+                elif cmd == "latency":
+                    emu.latency_us = int(args[0])
+                else:
+                    print(f"unknown command: {cmd}")
+        except (KeyError, IndexError, ValueError):
+            print("bad arguments")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("--port", help="serial port to serve instead of a pty")
+    parser.add_argument("--baud", type=int, default=1000000)
+    parser.add_argument("--ids", default="1", help="comma-separated servo IDs")
+    parser.add_argument("--end-stops", default="0:4095", help="rack end stops, min:max steps")
+    parser.add_argument("--latency-us", type=int, default=200, help="reply latency")
+    parser.add_argument("--echo", action="store_true", help="loop TX back on RX (single-wire)")
+    parser.add_argument("--drop-rate", type=float, default=0.0, help="random reply drop probability")
+    args = parser.parse_args()
+
+    lo, hi = (int(v) for v in args.end_stops.split(":"))
+    servos = [VirtualServo(int(i), position=lo, end_stops=(lo, hi)) for i in args.ids.split(",")]
+    emu = StsEmulator(servos, latency_us=args.latency_us, echo=args.echo)
+    read, write, name = open_transport(args)
+    print(f"Emulating servo(s) {args.ids} on {name}", file=sys.stderr)
+
+    def physics():
+        last = time.monotonic()
+        while True:
+            time.sleep(0.001)
+            now = time.monotonic()
+            emu.step(now - last)
+            last = now
+
+    threading.Thread(target=physics, daemon=True).start()
+    threading.Thread(target=command_loop, args=(emu,), daemon=True).start()
+
+    while True:
+        data = read(256)
+        if not data:
+            continue
+        if args.drop_rate and random.random() < args.drop_rate:
+            emu.feed(data)
+            continue
+        reply = emu.feed(data)
+        if reply:
+            write(reply)
+
+
+if __name__ == "__main__":
+    main()
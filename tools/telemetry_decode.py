@@ -0,0 +1,266 @@
+#!/usr/bin/env python3
+"""Decode binary telemetry from `rpm live bin` into CSV or Parquet.
+
+The firmware sends one COBS-encoded, zero-terminated frame per sample
+(see rpmCalcWithWifi/include/telemetry_frame.h). Record the raw serial
+bytes and decode them, or let this script read the port directly:
+
+  * from a capture:  python3 tools/telemetry_decode.py dyno.bin -o dyno.csv
+  * live:            python3 tools/telemetry_decode.py --port /dev/ttyACM0 \\
+                         --rate 1000 --seconds 60 -o dyno.parquet
+                     (requires pyserial; sends `rpm live bin <rate>`, then
+                     a key to stop)
+
+Output columns: seq, t_s, t_us, rpm, rpm_rate, mode, servo_target,
+servo_actual and one column per flag. Writing .parquet needs pyarrow;
+anything else is written as CSV. Text printed between frames (prompts,
+log lines) fails the CRC and is skipped; after a lost frame the decoder
+waits for the next keyframe so deltas never apply to the wrong base.
+"""
+
+import argparse
+import csv
+import sys
+
+FRAME_KEY = 0x01
+FRAME_DELTA = 0x02
+
+FIELDS = ["t_us", "rpm_x10", "rpm_rate", "mode", "servo_target", "servo_actual"]
+FLAGS = ["following", "movement_pin", "servo_moving", "rpm_sensor", "servo_valid", "dropped"]
+COLUMNS = ["seq", "t_s", "t_us", "rpm", "rpm_rate", "mode", "servo_target", "servo_actual"] + FLAGS
+
+
+def crc16(data):
+    """CRC-16/CCITT-FALSE, as telemetryCrc16() on the device."""
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else crc << 1
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data):
+            raise ValueError("bad COBS code")
+        out += data[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def read_varint(buf, pos):
+    value, shift = 0, 0
+    while True:
+        if pos >= len(buf) or shift > 28:
+            raise ValueError("truncated varint")
+        byte = buf[pos]
+        pos += 1
+        value |= (byte & 0x7F) << shift
+        if not byte & 0x80:
+            return value, pos
+        shift += 7
+
+
+def zigzag(v):
+    return (v >> 1) ^ -(v & 1)
+
+
+def to_int32(v):
+    v &= 0xFFFFFFFF
+    return v - (1 << 32) if v & 0x80000000 else v
+
+
+class Decoder:
+    def __init__(self):
+        self.base = None
+        self.expected_seq = None
+        self.t_offset = 0
+        self.prev_t = None
+        self.stats = {"frames": 0, "keyframes": 0, "crc_errors": 0, "malformed": 0,
+                      "lost": 0, "skipped_deltas": 0, "device_drops": 0}
+
+    def frames(self, stream):
+        """Splits the byte stream on zeros; every chunk is a candidate frame."""
+        pending = bytearray()
+        for chunk in stream:
+            pending += chunk
+            while True:
+                end = pending.find(0)
+                if end < 0:
+                    break
+                frame, pending = bytes(pending[:end]), pending[end + 1:]
+                if frame:
+                    yield frame
+
+    def decode(self, stream):
+        for encoded in self.frames(stream):
+            try:
+                raw = cobs_decode(encoded)
+            except ValueError:
+                self.stats["malformed"] += 1
+                continue
+            if len(raw) < 5 or crc16(raw[:-2]) != raw[-2] | (raw[-1] << 8):
+                self.stats["crc_errors"] += 1
+                continue
+            row = self.apply(raw[:-2])
+            if row is not None:
+                yield row
+
+    def apply(self, raw):
+        kind, seq = raw[0], raw[1]
+        if kind not in (FRAME_KEY, FRAME_DELTA):
+            self.stats["malformed"] += 1
+            return None
+
+        if self.expected_seq is not None and seq != self.expected_seq:
+            self.stats["lost"] += (seq - self.expected_seq) & 0xFF
+            self.base = None  # Deltas are relative to a frame we never saw
+        self.expected_seq = (seq + 1) & 0xFF
+
+        if kind == FRAME_DELTA and self.base is None:
+            self.stats["skipped_deltas"] += 1
+            return None
+
+        try:
+            pos = 2
+            t_delta, pos = read_varint(raw, pos)
+            values = []
+            for _ in FIELDS[1:]:
+                v, pos = read_varint(raw, pos)
+                values.append(zigzag(v))
+            flags = raw[pos]
+        except (ValueError, IndexError):
+            self.stats["malformed"] += 1
+            return None
+
+        base = self.base if kind == FRAME_DELTA else {f: 0 for f in FIELDS}
+        sample = {"t_us": (base["t_us"] + t_delta) & 0xFFFFFFFF}
+        for name, v in zip(FIELDS[1:], values):
+            sample[name] = to_int32(base[name] + v)
+        self.base = sample
+
+        self.stats["frames"] += 1
+        if kind == FRAME_KEY:
+            self.stats["keyframes"] += 1
+        if flags & (1 << FLAGS.index("dropped")):
+            self.stats["device_drops"] += 1
+
+        # Unwrap micros() so long captures stay monotonic
+        t = sample["t_us"] + self.t_offset
+        if self.prev_t is not None and t < self.prev_t - (1 << 31):
+            self.t_offset += 1 << 32
+            t += 1 << 32
+        if self.prev_t is None:
+            self.t_start = t
+        self.prev_t = t
+
+        row = {
+            "seq": seq,
+            "t_s": (t - self.t_start) / 1e6,
+            "t_us": t,
+            "rpm": sample["rpm_x10"] / 10.0,
+            "rpm_rate": sample["rpm_rate"],
+            "mode": sample["mode"],
+            "servo_target": sample["servo_target"],
+            "servo_actual": sample["servo_actual"],
+        }
+        for bit, name in enumerate(FLAGS):
+            row[name] = int(bool(flags & (1 << bit)))
+        return row
+
+
+def read_file(path, block=65536):
+    with (sys.stdin.buffer if path is None else open(path, "rb")) as f:
+        while True:
+            chunk = f.read(block)
+            if not chunk:
+                return
+            yield chunk
+
+
+def read_port(port, baud, rate, seconds, raw_out):
+    import time
+    import serial  # pyserial, only needed for live capture
+
+    with serial.Serial(port, baud, timeout=0.1) as ser:
+        ser.reset_input_buffer()
+        ser.write(f"rpm live bin {rate}\n".encode())
+        deadline = time.monotonic() + seconds
+        try:
+            while time.monotonic() < deadline:
+                chunk = ser.read(4096)
+                if chunk:
+                    if raw_out:
+                        raw_out.write(chunk)
+                    yield chunk
+        finally:
+            ser.write(b"\n")  # Any key stops the stream
+
+
+def write_csv(rows, path):
+    out = sys.stdout if path is None else open(path, "w", newline="")
+    writer = csv.DictWriter(out, fieldnames=COLUMNS)
+    writer.writeheader()
+    n = 0
+    for row in rows:
+        writer.writerow(row)
+        n += 1
+    if path is not None:
+        out.close()
+    return n
+
+
+def write_parquet(rows, path):
+    try:
+        import pyarrow as pa
+        import pyarrow.parquet as pq
+    except ImportError:
+        sys.exit("writing Parquet needs pyarrow (pip install pyarrow); use a .csv output instead")
+
+    columns = {name: [] for name in COLUMNS}
+    for row in rows:
+        for name in COLUMNS:
+            columns[name].append(row[name])
+    pq.write_table(pa.table(columns), path)
+    return len(columns["seq"])
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("input", nargs="?", help="raw serial capture (default stdin)")
+    parser.add_argument("-o", "--output", help="output .csv or .parquet (default CSV on stdout)")
+    parser.add_argument("--port", help="read frames from this serial port instead")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--rate", type=int, default=1000, help="sample rate to request, Hz")
+    parser.add_argument("--seconds", type=float, default=10.0, help="live capture duration")
+    parser.add_argument("--save-raw", help="also keep the raw bytes of a live capture")
+    args = parser.parse_args()
+
+    raw_out = open(args.save_raw, "wb") if args.save_raw else None
+    if args.port:
+        stream = read_port(args.port, args.baud, args.rate, args.seconds, raw_out)
+    else:
+        stream = read_file(args.input)
+
+    decoder = Decoder()
+    rows = decoder.decode(stream)
+    if args.output and args.output.endswith(".parquet"):
+        n = write_parquet(rows, args.output)
+    else:
+        n = write_csv(rows, args.output)
+
+    if raw_out:
+        raw_out.close()
+    stats = ", ".join(f"{k} {v}" for k, v in decoder.stats.items())
+    print(f"{n} samples ({stats})", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,182 @@
+#!/usr/bin/env python3
+"""Convert a firmware `trace dump` into Chrome trace JSON.
+
+The device prints its event ring between `=== TRACE BEGIN ===` and
+`=== TRACE END ===` markers. Capture that from any serial monitor and
+convert it, or let this script fetch it directly:
+
+  * from a log:  python3 tools/trace2chrome.py capture.log -o trace.json
+  * live:        python3 tools/trace2chrome.py --port /dev/ttyACM0 -o trace.json
+                 (requires pyserial; sends `trace dump` and reads the reply)
+
+Open the result in chrome://tracing or https://ui.perfetto.dev. Each
+FreeRTOS task (and interrupt context) gets its own track; RPM edges are
+also plotted as an "rpm" counter. The 32-bit µs timestamps are unwrapped,
+so dumps spanning a micros() rollover stay in order.
+"""
+
+import argparse
+import json
+import sys
+
+BEGIN_MARKER = "=== TRACE BEGIN ==="
+END_MARKER = "=== TRACE END ==="
+
+PHASES = {0: "i", 1: "B", 2: "E"}
+STATE_NAMES = ["race", "diagnostics", "config", "off", "unknown"]
+
+# rpm = 1e6 / period_us * 120 / 36, as in rpm.cpp
+RPM_PERIOD_CONSTANT = 1_000_000 * 120 / 36
+
+
+def extract_dump(lines):
+    """Returns the lines of the last complete dump in a capture."""
+    dump, inside, last = [], False, None
+    for raw in lines:
+        line = raw.strip()
+        if line.endswith(BEGIN_MARKER):
+            dump, inside = [], True
+        elif line.endswith(END_MARKER) and inside:
+            last, inside = dump, False
+        elif inside:
+            dump.append(line)
+    if last is None:
+        raise ValueError("no complete TRACE BEGIN/END block found")
+    return last
+
+
+def parse_dump(lines):
+    tasks, types, events = {}, {}, []
+    for line in lines:
+        if not line:
+            continue
+        if line.startswith("#"):
+            parts = line[1:].split(None, 2)
+            if parts[0] == "task" and len(parts) == 3:
+                tasks[int(parts[1])] = parts[2]
+            elif parts[0] == "type" and len(parts) == 3:
+                types[int(parts[1])] = parts[2]
+            continue
+        ts, typ, phase_task, value = line.split()
+        phase_task = int(phase_task, 16)
+        events.append({
+            "ts": int(ts, 16),
+            "type": int(typ, 16),
+            "phase": phase_task >> 6,
+            "task": phase_task & 0x3F,
+            "value": int(value, 16),
+        })
+    return tasks, types, events
+
+
+def unwrap(events):
+    """Removes micros() rollovers and starts the timeline at 0."""
+    offset, previous = 0, None
+    for e in events:
+        if previous is not None and e["ts"] + offset < previous - (1 << 31):
+            offset += 1 << 32
+        e["ts"] += offset
+        previous = e["ts"]
+    if events:
+        start = events[0]["ts"]
+        for e in events:
+            e["ts"] -= start
+
+
+def describe(name, value):
+    if name == "state":
+        return {"state": STATE_NAMES[value] if value < len(STATE_NAMES) else value}
+    if name in ("rpm_edge", "mode_crossing"):
+        return {"period_us": value}
+    if name == "servo_cmd":
+        return {"goal": value}
+    return {"value": value}
+
+
+def to_chrome(tasks, types, events):
+    unwrap(events)
+    out = [{"ph": "M", "pid": 1, "name": "process_name", "args": {"name": "rpmCalcWithWifi"}}]
+    for tid, name in sorted(tasks.items()):
+        out.append({"ph": "M", "pid": 1, "tid": tid, "name": "thread_name", "args": {"name": name}})
+
+    # Spans whose begin fell out of the ring are dropped; spans still
+    # open at the end of the dump are closed at the last timestamp
+    open_spans = {}
+    for e in events:
+        name = types.get(e["type"], f"type{e['type']}")
+        ph = PHASES.get(e["phase"], "i")
+        key = (e["task"], e["type"])
+
+        if ph == "E":
+            if open_spans.get(key, 0) == 0:
+                continue
+            open_spans[key] -= 1
+        elif ph == "B":
+            open_spans[key] = open_spans.get(key, 0) + 1
+
+        record = {"name": name, "ph": ph, "ts": e["ts"], "pid": 1, "tid": e["task"]}
+        if ph != "E":
+            record["args"] = describe(name, e["value"])
+        if ph == "i":
+            record["s"] = "t"
+        out.append(record)
+
+        if name == "rpm_edge" and e["value"] > 0:
+            out.append({"name": "rpm", "ph": "C", "ts": e["ts"], "pid": 1,
+                        "args": {"rpm": round(RPM_PERIOD_CONSTANT / e["value"], 1)}})
+
+    end = events[-1]["ts"] if events else 0
+    for (task, typ), depth in open_spans.items():
+        for _ in range(depth):
+            out.append({"name": types.get(typ, f"type{typ}"), "ph": "E", "ts": end, "pid": 1, "tid": task})
+
+    return {"traceEvents": out, "displayTimeUnit": "ms"}
+
+
+def capture_live(port, baud, timeout):
+    import serial  # pyserial, only needed for live capture
+
+    with serial.Serial(port, baud, timeout=timeout) as ser:
+        ser.reset_input_buffer()
+        ser.write(b"trace dump\n")
+        lines = []
+        while True:
+            raw = ser.readline()
+            if not raw:
+                raise TimeoutError("no TRACE END marker received")
+            line = raw.decode("utf-8", errors="replace")
+            lines.append(line)
+            if line.strip().endswith(END_MARKER):
+                return lines
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("input", nargs="?", help="serial capture containing a trace dump (default stdin)")
+    parser.add_argument("-o", "--output", help="output JSON file (default stdout)")
+    parser.add_argument("--port", help="fetch the dump from this serial port instead")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--timeout", type=float, default=5.0, help="live capture read timeout, s")
+    args = parser.parse_args()
+
+    if args.port:
+        lines = capture_live(args.port, args.baud, args.timeout)
+    elif args.input:
+        with open(args.input, encoding="utf-8", errors="replace") as f:
+            lines = f.readlines()
+    else:
+        lines = sys.stdin.readlines()
+
+    tasks, types, events = parse_dump(extract_dump(lines))
+    trace = to_chrome(tasks, types, events)
+
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump(trace, f)
+        print(f"{len(events)} events, {len(tasks)} tracks -> {args.output}", file=sys.stderr)
+    else:
+        json.dump(trace, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,174 @@
+#!/usr/bin/env python3
+"""Record the device's UDP telemetry and report packet loss.
+
+With `wifi udp on` the device sends one 24-byte packet per sample while
+it is in diagnostics mode (see rpmCalcWithWifi/include/udp_telemetry.h).
+Any number of laptops on the access point can run this at the same time:
+
+  python3 tools/udp_listener.py                    # print a status line per second
+  python3 tools/udp_listener.py -o pit.csv         # also record every packet
+  python3 tools/udp_listener.py --multicast        # for `wifi udp on <hz> multicast`
+
+Loss is counted from gaps in the sequence number. Packets that arrive
+late are counted as reordered (and still recorded), repeats as
+duplicates. A lower sequence number with a new timestamp means the
+device rebooted; counting starts over. Ctrl-C prints the totals.
+"""
+
+import argparse
+import csv
+import socket
+import struct
+import sys
+import time
+
+PORT = 4210
+MULTICAST_GROUP = "239.10.0.1"
+
+PACKET = struct.Struct("<2sBBIIihhbBH")
+assert PACKET.size == 24
+VERSION = 1
+
+STATES = ["race", "diagnostics", "config", "off", "unknown"]
+FLAGS = ["following", "movement_pin", "servo_moving", "rpm_sensor", "servo_valid"]
+COLUMNS = ["rx_time", "seq", "t_ms", "state", "rpm", "mode", "target", "actual", "rate_hz"] + FLAGS
+
+# How far back late packets and repeats are tracked
+REBOOT_GAP = 1000
+
+
+class LossCounter:
+    def __init__(self):
+        self.received = 0
+        self.lost = 0
+        self.reordered = 0
+        self.duplicates = 0
+        self.reboots = 0
+        self.malformed = 0
+        self.highest = None
+        self.missing = set()  # Gaps that may still be filled by late packets
+        self.seen = {}        # Recent seq -> t_ms, to tell repeats from a reboot
+
+    def add(self, seq, t_ms):
+        self.received += 1
+        if self.highest is None:
+            self.highest = seq
+        elif seq > self.highest:
+            self.missing.update(range(max(self.highest + 1, seq - REBOOT_GAP), seq))
+            self.lost += seq - self.highest - 1
+            self.highest = seq
+        elif seq in self.missing:
+            self.missing.discard(seq)
+            self.lost -= 1
+            self.reordered += 1
+        elif self.seen.get(seq) == t_ms:
+            self.duplicates += 1
+            return
+        else:
+            # Behind us with a different timestamp: the device restarted
+            self.reboots += 1
+            self.highest = seq
+            self.missing.clear()
+            self.seen.clear()
+
+        self.seen[seq] = t_ms
+        if len(self.seen) > 2 * REBOOT_GAP:
+            self.seen = {s: t for s, t in self.seen.items() if self.highest - s < REBOOT_GAP}
+            self.missing = {s for s in self.missing if self.highest - s < REBOOT_GAP}
+
+    def loss_percent(self):
+        expected = self.received - self.duplicates + self.lost
+        return 100.0 * self.lost / expected if expected else 0.0
+
+    def summary(self):
+        return (f"{self.received} received, {self.lost} lost ({self.loss_percent():.2f}%), "
+                f"{self.reordered} reordered, {self.duplicates} duplicates, "
+                f"{self.reboots} reboots, {self.malformed} malformed")
+
+
+def decode(data):
+    if len(data) != PACKET.size:
+        return None
+    magic, version, state, seq, t_ms, rpm_x10, target, actual, mode, flags, rate = PACKET.unpack(data)
+    if magic != b"RT" or version != VERSION:
+        return None
+    row = {
+        "seq": seq,
+        "t_ms": t_ms,
+        "state": STATES[state] if state < len(STATES) else state,
+        "rpm": rpm_x10 / 10.0,
+        "mode": mode,
+        "target": target,
+        "actual": actual,
+        "rate_hz": rate,
+    }
+    for bit, name in enumerate(FLAGS):
+        row[name] = int(bool(flags & (1 << bit)))
+    return row
+
+
+def open_socket(multicast, port):
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM, socket.IPPROTO_UDP)
+    # Several listeners on one laptop may share the port
+    sock.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    if hasattr(socket, "SO_REUSEPORT"):
+        sock.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEPORT, 1)
+    sock.bind(("", port))
+    if multicast:
+        mreq = struct.pack("4s4s", socket.inet_aton(MULTICAST_GROUP), socket.inet_aton("0.0.0.0"))
+        sock.setsockopt(socket.IPPROTO_IP, socket.IP_ADD_MEMBERSHIP, mreq)
+    sock.settimeout(1.0)
+    return sock
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("-o", "--output", help="record packets to this CSV file")
+    parser.add_argument("--port", type=int, default=PORT)
+    parser.add_argument("--multicast", action="store_true", help=f"join {MULTICAST_GROUP}")
+    parser.add_argument("--seconds", type=float, help="stop after this long")
+    parser.add_argument("--quiet", action="store_true", help="no status line per second")
+    args = parser.parse_args()
+
+    sock = open_socket(args.multicast, args.port)
+    out = open(args.output, "w", newline="") if args.output else None
+    writer = csv.DictWriter(out, fieldnames=COLUMNS) if out else None
+    if writer:
+        writer.writeheader()
+
+    counter = LossCounter()
+    start = last_report = time.monotonic()
+    last = None
+    try:
+        while args.seconds is None or time.monotonic() - start < args.seconds:
+            try:
+                data, _ = sock.recvfrom(64)
+            except socket.timeout:
+                data = None
+
+            if data is not None:
+                row = decode(data)
+                if row is None:
+                    counter.malformed += 1
+                else:
+                    counter.add(row["seq"], row["t_ms"])
+                    last = row
+                    if writer:
+                        row["rx_time"] = f"{time.time():.6f}"
+                        writer.writerow(row)
+
+            now = time.monotonic()
+            if not args.quiet and now - last_report >= 1.0:
+                last_report = now
+                live = f"rpm {last['rpm']:.0f} mode {last['mode']} {last['state']}" if last else "no packets yet"
+                print(f"{live} | {counter.summary()}", file=sys.stderr)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        if out:
+            out.close()
+        print(counter.summary(), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
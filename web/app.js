@@ -0,0 +1,163 @@
+"use strict";
+
+// Live values arrive over the event stream on port 81 (see sse_server.h);
+// if it cannot be reached, /data and /current_position are polled.
+const EVENTS_URL = `http://${location.hostname}:81/events?hz=10&batch=1`;
+const POLL_MS = 500;
+
+const $ = (id) => document.getElementById(id);
+
+function setStatus(text, bad) {
+  $("status").textContent = text;
+  $("status").className = bad ? "bad" : "";
+}
+
+function setLink(text, cls) {
+  $("link").textContent = text;
+  $("link").className = "badge " + (cls || "");
+}
+
+async function request(path, body) {
+  const opts = body === undefined ? {} : {
+    method: "POST",
+    headers: { "Content-Type": "application/json" },
+    body: JSON.stringify(body),
+  };
+  const resp = await fetch(path, opts);
+  const text = await resp.text();
+  if (!resp.ok) throw new Error(text || resp.statusText);
+  return text;
+}
+
+const getJson = async (path) => JSON.parse(await request(path));
+
+// ---- Live values ----
+
+function showSample(columns, row, state) {
+  const value = (name) => row[columns.indexOf(name)];
+  $("rpm").textContent = Math.round(value("rpm"));
+  $("mode").textContent = value("mode") > 0 ? value("mode") : "–";
+  $("target").textContent = value("target");
+  $("actual").textContent = value("actual");
+  if (state) $("state").textContent = state;
+}
+
+function startEvents() {
+  let columns = ["t_ms", "rpm", "mode", "target", "actual"];
+  let opened = false;
+  const events = new EventSource(EVENTS_URL);
+
+  events.addEventListener("meta", (e) => {
+    columns = JSON.parse(e.data).fields;
+  });
+  events.onopen = () => {
+    opened = true;
+    setLink("live", "ok");
+  };
+  events.onmessage = (e) => {
+    const msg = JSON.parse(e.data);
+    if (msg.s.length) showSample(columns, msg.s[msg.s.length - 1], msg.state);
+  };
+  events.onerror = () => {
+    if (opened) {
+      setLink("reconnecting…", "bad");  // EventSource retries by itself
+      return;
+    }
+    events.close();
+    startPolling();
+  };
+}
+
+function startPolling() {
+  setLink("polling", "");
+  const poll = async () => {
+    try {
+      const [data, mode] = await Promise.all([getJson("/data"), getJson("/current_position")]);
+      $("rpm").textContent = Math.round(data.rpm);
+      $("mode").textContent = mode.current_position;
+      setLink("polling", "ok");
+    } catch (err) {
+      setLink("offline", "bad");
+    }
+    setTimeout(poll, POLL_MS);
+  };
+  poll();
+}
+
+// ---- Editors ----
+
+function numberInput(label, value, min, max) {
+  const wrap = document.createElement("div");
+  const lbl = document.createElement("label");
+  const input = document.createElement("input");
+  lbl.textContent = label;
+  input.type = "number";
+  input.value = value;
+  if (min !== undefined) input.min = min;
+  if (max !== undefined) input.max = max;
+  wrap.append(lbl, input);
+  return wrap;
+}
+
+const readInputs = (id) => [...$(id).querySelectorAll("input")].map((i) => Number(i.value));
+
+function renderRanges(boundaries) {
+  $("ranges").replaceChildren(...boundaries.map((b, i) => numberInput(`Boundary ${i + 1}`, b, 0)));
+}
+
+async function loadRanges() {
+  const { ranges } = await getJson("/ranges");
+  const boundaries = ranges.length ? [ranges[0][0], ...ranges.map((r) => r[1])] : [0, 1000];
+  renderRanges(boundaries);
+}
+
+async function saveRanges() {
+  const boundaries = readInputs("ranges");
+  for (let i = 1; i < boundaries.length; i++) {
+    if (boundaries[i] <= boundaries[i - 1]) {
+      setStatus(`Boundary ${i + 1} must be above boundary ${i}`, true);
+      return;
+    }
+  }
+  await request("/save_ranges", { ranges: boundaries });
+  setStatus("Ranges saved; servo positions were regenerated.");
+  await loadPositions();
+}
+
+async function loadPositions() {
+  const { positions, min, max } = await getJson("/positions");
+  $("positions-hint").textContent = `Raw servo steps per mode, ${min}–${max}.`;
+  $("positions").replaceChildren(...positions.map((p, i) => numberInput(`Mode ${i + 1}`, p, min, max)));
+}
+
+async function savePositions() {
+  await request("/positions", { positions: readInputs("positions") });
+  setStatus("Servo positions saved.");
+}
+
+function guard(fn) {
+  return async () => {
+    try {
+      await fn();
+    } catch (err) {
+      setStatus(err.message, true);
+    }
+  };
+}
+
+$("range-add").onclick = () => {
+  const b = readInputs("ranges");
+  renderRanges([...b, b[b.length - 1] + 1000]);
+};
+$("range-remove").onclick = () => {
+  const b = readInputs("ranges");
+  if (b.length > 3) renderRanges(b.slice(0, -1));
+};
+$("ranges-save").onclick = guard(saveRanges);
+$("positions-save").onclick = guard(savePositions);
+
+startEvents();
+guard(async () => {
+  await loadRanges();
+  await loadPositions();
+})();